@@ -0,0 +1,264 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ActorActions/ActorBoundsBVH.h"
+
+void FActorBoundsBVH::Build(const TArray<AActor*>& Actors)
+{
+	Reset();
+	ItemBounds.Reserve(Actors.Num());
+	ItemActors.Reserve(Actors.Num());
+	for (AActor* Actor : Actors)
+	{
+		if (!Actor || ItemIndexByActor.Contains(Actor)) continue;
+		const FBox ActorBounds = Actor->GetComponentsBoundingBox(true);
+		if (!ActorBounds.IsValid) continue;
+		ItemIndexByActor.Add(Actor, ItemBounds.Add(ActorBounds));
+		ItemActors.Add(Actor);
+	}
+	ItemLeaves.Init(INDEX_NONE, ItemBounds.Num());
+	ItemRemoved.Init(false, ItemBounds.Num());
+	if (ItemBounds.Num() == 0) return;
+
+	ItemOrder.SetNumUninitialized(ItemBounds.Num());
+	for (int32 ItemIndex = 0; ItemIndex < ItemOrder.Num(); ++ItemIndex)
+	{
+		ItemOrder[ItemIndex] = ItemIndex;
+	}
+	Nodes.Reserve(2 * ItemBounds.Num() / MaxItemsPerLeaf + 1);
+	BuildNode(INDEX_NONE, 0, ItemOrder.Num());
+}
+
+void FActorBoundsBVH::Reset()
+{
+	Nodes.Reset();
+	ItemBounds.Reset();
+	ItemActors.Reset();
+	ItemLeaves.Reset();
+	ItemRemoved.Reset();
+	ItemOrder.Reset();
+	PendingItems.Reset();
+	ItemIndexByActor.Reset();
+	NumRemovedItems = 0;
+}
+
+int32 FActorBoundsBVH::BuildNode(int32 Parent, int32 FirstItem, int32 NumItems)
+{
+	//Nodes can reallocate while children are built, so work through indices
+	const int32 NodeIndex = Nodes.AddDefaulted();
+	Nodes[NodeIndex].Parent = Parent;
+	FBox NodeBounds(ForceInit);
+	FBox CentroidBounds(ForceInit);
+	for (int32 OrderIndex = FirstItem; OrderIndex < FirstItem + NumItems; ++OrderIndex)
+	{
+		const FBox& Bounds = ItemBounds[ItemOrder[OrderIndex]];
+		NodeBounds += Bounds;
+		CentroidBounds += Bounds.GetCenter();
+	}
+	Nodes[NodeIndex].Bounds = NodeBounds;
+
+	if (NumItems <= MaxItemsPerLeaf)
+	{
+		Nodes[NodeIndex].FirstItem = FirstItem;
+		Nodes[NodeIndex].NumItems = NumItems;
+		for (int32 OrderIndex = FirstItem; OrderIndex < FirstItem + NumItems; ++OrderIndex)
+		{
+			ItemLeaves[ItemOrder[OrderIndex]] = NodeIndex;
+		}
+		return NodeIndex;
+	}
+
+	const FVector CentroidExtent = CentroidBounds.GetExtent();
+	const int32 SplitAxis = CentroidExtent.X >= CentroidExtent.Y ?
+		(CentroidExtent.X >= CentroidExtent.Z ? 0 : 2) : (CentroidExtent.Y >= CentroidExtent.Z ? 1 : 2);
+	MakeArrayView(ItemOrder.GetData() + FirstItem, NumItems).Sort([this, SplitAxis](int32 ItemA, int32 ItemB)
+		{
+			return ItemBounds[ItemA].GetCenter()[SplitAxis] < ItemBounds[ItemB].GetCenter()[SplitAxis];
+		});
+
+	const int32 NumLeftItems = NumItems / 2;
+	const int32 LeftChild = BuildNode(NodeIndex, FirstItem, NumLeftItems);
+	const int32 RightChild = BuildNode(NodeIndex, FirstItem + NumLeftItems, NumItems - NumLeftItems);
+	Nodes[NodeIndex].LeftChild = LeftChild;
+	Nodes[NodeIndex].RightChild = RightChild;
+	return NodeIndex;
+}
+
+#pragma region IncrementalUpdates
+void FActorBoundsBVH::AddActor(AActor* Actor)
+{
+	if (!Actor || ItemIndexByActor.Contains(Actor)) return;
+	const FBox ActorBounds = Actor->GetComponentsBoundingBox(true);
+	if (!ActorBounds.IsValid) return;
+
+	const int32 ItemIndex = ItemBounds.Add(ActorBounds);
+	ItemActors.Add(Actor);
+	ItemLeaves.Add(INDEX_NONE);
+	ItemRemoved.Add(false);
+	ItemIndexByActor.Add(Actor, ItemIndex);
+	PendingItems.Add(ItemIndex);
+}
+
+void FActorBoundsBVH::RemoveActor(const AActor* Actor)
+{
+	int32 ItemIndex = INDEX_NONE;
+	if (!ItemIndexByActor.RemoveAndCopyValue(Actor, ItemIndex)) return;
+	ItemRemoved[ItemIndex] = true;
+	NumRemovedItems++;
+	PendingItems.RemoveSwap(ItemIndex);
+	//Bounds are left as they were, nodes only ever get looser until the next rebuild
+}
+
+void FActorBoundsBVH::UpdateActor(AActor* Actor)
+{
+	const int32* ItemIndex = Actor ? ItemIndexByActor.Find(Actor) : nullptr;
+	if (!ItemIndex)
+	{
+		AddActor(Actor);
+		return;
+	}
+	const FBox ActorBounds = Actor->GetComponentsBoundingBox(true);
+	if (!ActorBounds.IsValid)
+	{
+		RemoveActor(Actor);
+		return;
+	}
+	ItemBounds[*ItemIndex] = ActorBounds;
+	if (ItemLeaves[*ItemIndex] != INDEX_NONE) RefitFromLeaf(ItemLeaves[*ItemIndex]);
+}
+
+//Recomputes the leaf from its items, then each ancestor from its two children
+void FActorBoundsBVH::RefitFromLeaf(int32 LeafIndex)
+{
+	FNode& Leaf = Nodes[LeafIndex];
+	FBox LeafBounds(ForceInit);
+	for (int32 OrderIndex = Leaf.FirstItem; OrderIndex < Leaf.FirstItem + Leaf.NumItems; ++OrderIndex)
+	{
+		LeafBounds += ItemBounds[ItemOrder[OrderIndex]];
+	}
+	Leaf.Bounds = LeafBounds;
+
+	for (int32 NodeIndex = Leaf.Parent; NodeIndex != INDEX_NONE; NodeIndex = Nodes[NodeIndex].Parent)
+	{
+		FNode& Node = Nodes[NodeIndex];
+		Node.Bounds = Nodes[Node.LeftChild].Bounds + Nodes[Node.RightChild].Bounds;
+	}
+}
+
+//Pending items are tested one by one and removed items still sit in leaves, both slow queries down
+bool FActorBoundsBVH::NeedsRebuild() const
+{
+	const int32 NumItems = ItemActors.Num();
+	return PendingItems.Num() > FMath::Max(256, NumItems / 16) || NumRemovedItems > FMath::Max(256, NumItems / 4);
+}
+#pragma endregion
+
+template<typename VisitorType>
+void FActorBoundsBVH::VisitOverlapping(const FBox& QueryBox, VisitorType&& Visitor) const
+{
+	for (const int32 ItemIndex : PendingItems)
+	{
+		if (ItemBounds[ItemIndex].Intersect(QueryBox) && !Visitor(ItemIndex)) return;
+	}
+	if (Nodes.Num() == 0) return;
+
+	TArray<int32, TInlineAllocator<64>> NodeStack;
+	NodeStack.Add(0);
+	while (NodeStack.Num() > 0)
+	{
+		const FNode& Node = Nodes[NodeStack.Pop(false)];
+		if (!Node.Bounds.Intersect(QueryBox)) continue;
+		if (!Node.IsLeaf())
+		{
+			NodeStack.Add(Node.LeftChild);
+			NodeStack.Add(Node.RightChild);
+			continue;
+		}
+		for (int32 OrderIndex = Node.FirstItem; OrderIndex < Node.FirstItem + Node.NumItems; ++OrderIndex)
+		{
+			const int32 ItemIndex = ItemOrder[OrderIndex];
+			if (ItemRemoved[ItemIndex]) continue;
+			//Returning false stops the walk
+			if (ItemBounds[ItemIndex].Intersect(QueryBox) && !Visitor(ItemIndex)) return;
+		}
+	}
+}
+
+bool FActorBoundsBVH::Overlaps(const FBox& QueryBox) const
+{
+	bool bOverlaps = false;
+	VisitOverlapping(QueryBox, [&bOverlaps](int32 ItemIndex)
+		{
+			bOverlaps = true;
+			return false;
+		});
+	return bOverlaps;
+}
+
+void FActorBoundsBVH::QueryOverlapping(const FBox& QueryBox, TArray<AActor*>& OutActors) const
+{
+	VisitOverlapping(QueryBox, [this, &OutActors](int32 ItemIndex)
+		{
+			if (AActor* Actor = ItemActors[ItemIndex].Get()) OutActors.Add(Actor);
+			return true;
+		});
+}
+
+void FActorBoundsBVH::ForEachOverlapping(const FBox& QueryBox, TFunctionRef<void(AActor*, const FBox&)> Visitor) const
+{
+	VisitOverlapping(QueryBox, [this, &Visitor](int32 ItemIndex)
+		{
+			if (AActor* Actor = ItemActors[ItemIndex].Get()) Visitor(Actor, ItemBounds[ItemIndex]);
+			return true;
+		});
+}
+
+//Best first walk: nodes and items share one min-heap keyed by squared distance, a node is never closer than what it holds
+void FActorBoundsBVH::FindNearest(const FVector& Point, int32 MaxActors, TFunctionRef<bool(AActor*)> Filter,
+	TArray<AActor*>& OutActors) const
+{
+	struct FNearestEntry
+	{
+		double DistanceSquared;
+		int32 Index;
+		bool bIsItem;
+
+		bool operator<(const FNearestEntry& Other) const { return DistanceSquared < Other.DistanceSquared; }
+	};
+
+	TArray<FNearestEntry> Heap;
+	for (const int32 ItemIndex : PendingItems)
+	{
+		Heap.HeapPush(FNearestEntry{ ItemBounds[ItemIndex].ComputeSquaredDistanceToPoint(Point), ItemIndex, true });
+	}
+	if (Nodes.Num() > 0)
+	{
+		Heap.HeapPush(FNearestEntry{ Nodes[0].Bounds.ComputeSquaredDistanceToPoint(Point), 0, false });
+	}
+
+	const int32 NumFoundBefore = OutActors.Num();
+	while (Heap.Num() > 0 && OutActors.Num() - NumFoundBefore < MaxActors)
+	{
+		FNearestEntry Entry;
+		Heap.HeapPop(Entry, false);
+		if (Entry.bIsItem)
+		{
+			AActor* Actor = ItemActors[Entry.Index].Get();
+			if (Actor && Filter(Actor)) OutActors.Add(Actor);
+			continue;
+		}
+
+		const FNode& Node = Nodes[Entry.Index];
+		if (!Node.IsLeaf())
+		{
+			Heap.HeapPush(FNearestEntry{ Nodes[Node.LeftChild].Bounds.ComputeSquaredDistanceToPoint(Point), Node.LeftChild, false });
+			Heap.HeapPush(FNearestEntry{ Nodes[Node.RightChild].Bounds.ComputeSquaredDistanceToPoint(Point), Node.RightChild, false });
+			continue;
+		}
+		for (int32 OrderIndex = Node.FirstItem; OrderIndex < Node.FirstItem + Node.NumItems; ++OrderIndex)
+		{
+			const int32 ItemIndex = ItemOrder[OrderIndex];
+			if (ItemRemoved[ItemIndex]) continue;
+			Heap.HeapPush(FNearestEntry{ ItemBounds[ItemIndex].ComputeSquaredDistanceToPoint(Point), ItemIndex, true });
+		}
+	}
+}
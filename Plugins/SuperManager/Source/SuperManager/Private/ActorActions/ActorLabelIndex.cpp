@@ -0,0 +1,141 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ActorActions/ActorLabelIndex.h"
+#include "ActorActions/ActorActionsLog.h"
+#include "ActorActions/EditorActorEvents.h"
+#include "EngineUtils.h"
+
+FActorLabelIndex& FActorLabelIndex::Get()
+{
+	static FActorLabelIndex ActorLabelIndex;
+	return ActorLabelIndex;
+}
+
+void FActorLabelIndex::Register()
+{
+	FEditorActorEvents& EditorActorEvents = FEditorActorEvents::Get();
+	ActorLabelChangedHandle = EditorActorEvents.OnActorLabelChanged.AddRaw(this, &FActorLabelIndex::OnActorLabelChanged);
+	LevelActorAddedHandle = EditorActorEvents.OnActorAdded.AddRaw(this, &FActorLabelIndex::OnLevelActorAdded);
+	LevelActorDeletedHandle = EditorActorEvents.OnActorDeleted.AddRaw(this, &FActorLabelIndex::OnLevelActorDeleted);
+	WorldActorsInvalidatedHandle = EditorActorEvents.OnWorldActorsInvalidated.AddRaw(this, &FActorLabelIndex::OnWorldActorsInvalidated);
+}
+
+void FActorLabelIndex::Unregister()
+{
+	FEditorActorEvents& EditorActorEvents = FEditorActorEvents::Get();
+	EditorActorEvents.OnActorLabelChanged.Remove(ActorLabelChangedHandle);
+	EditorActorEvents.OnActorAdded.Remove(LevelActorAddedHandle);
+	EditorActorEvents.OnActorDeleted.Remove(LevelActorDeletedHandle);
+	EditorActorEvents.OnWorldActorsInvalidated.Remove(WorldActorsInvalidatedHandle);
+	IndexByWorld.Empty();
+}
+
+FString FActorLabelIndex::MakeStem(const FString& ActorLabel)
+{
+	int32 StemLength = ActorLabel.Len();
+	while (StemLength > 0 && FChar::IsDigit(ActorLabel[StemLength - 1])) --StemLength;
+	while (StemLength > 0 && (ActorLabel[StemLength - 1] == TEXT('_') || ActorLabel[StemLength - 1] == TEXT('-') ||
+		ActorLabel[StemLength - 1] == TEXT(' '))) --StemLength;
+	//A label made only of digits is its own stem
+	return (StemLength > 0 ? ActorLabel.Left(StemLength) : ActorLabel).ToLower();
+}
+
+void FActorLabelIndex::FindActorsWithStem(UWorld* World, const FString& Stem, TArray<AActor*>& OutActors)
+{
+	const FWorldLabelIndex& WorldIndex = GetOrBuildWorldIndex(World);
+	const TArray< TWeakObjectPtr<AActor> >* StemActors = WorldIndex.ActorsByStem.Find(Stem.ToLower());
+	if (!StemActors) return;
+	OutActors.Reserve(OutActors.Num() + StemActors->Num());
+	for (const TWeakObjectPtr<AActor>& StemActor : *StemActors)
+	{
+		if (AActor* Actor = StemActor.Get()) OutActors.Add(Actor);
+	}
+}
+
+void FActorLabelIndex::ForEachActor(UWorld* World, TFunctionRef<void(AActor*)> Visitor)
+{
+	for (const TPair<FString, TArray< TWeakObjectPtr<AActor> >>& StemActors : GetOrBuildWorldIndex(World).ActorsByStem)
+	{
+		for (const TWeakObjectPtr<AActor>& StemActor : StemActors.Value)
+		{
+			if (AActor* Actor = StemActor.Get()) Visitor(Actor);
+		}
+	}
+}
+
+FActorLabelIndex::FWorldLabelIndex& FActorLabelIndex::GetOrBuildWorldIndex(UWorld* World)
+{
+	if (FWorldLabelIndex* ExistingIndex = IndexByWorld.Find(World)) return *ExistingIndex;
+
+	const double StartTime = FPlatformTime::Seconds();
+	FWorldLabelIndex& WorldIndex = IndexByWorld.Add(World);
+	for (TActorIterator<AActor> ActorIt(World); ActorIt; ++ActorIt)
+	{
+		AddActor(WorldIndex, *ActorIt);
+	}
+	UE_LOG(LogSuperManagerActorActions, Verbose, TEXT("Indexed %d actor labels of %s in %.3f seconds"),
+		WorldIndex.StemByActor.Num(), *World->GetName(), FPlatformTime::Seconds() - StartTime);
+	return WorldIndex;
+}
+
+void FActorLabelIndex::AddActor(FWorldLabelIndex& WorldIndex, AActor* Actor)
+{
+	if (!Actor || !Actor->IsEditable() || !Actor->IsListedInSceneOutliner()) return;
+	const FString Stem = MakeStem(Actor->GetActorLabel());
+	WorldIndex.ActorsByStem.FindOrAdd(Stem).Add(Actor);
+	WorldIndex.StemByActor.Add(Actor, Stem);
+}
+
+void FActorLabelIndex::RemoveActor(FWorldLabelIndex& WorldIndex, AActor* Actor)
+{
+	FString OldStem;
+	if (!WorldIndex.StemByActor.RemoveAndCopyValue(Actor, OldStem)) return;
+	if (TArray< TWeakObjectPtr<AActor> >* StemActors = WorldIndex.ActorsByStem.Find(OldStem))
+	{
+		StemActors->RemoveSwap(Actor);
+		if (StemActors->Num() == 0) WorldIndex.ActorsByStem.Remove(OldStem);
+	}
+}
+
+//Worlds that were never queried are not indexed, their events are ignored
+FActorLabelIndex::FWorldLabelIndex* FActorLabelIndex::FindWorldIndex(const AActor* Actor)
+{
+	return Actor ? IndexByWorld.Find(Actor->GetWorld()) : nullptr;
+}
+
+void FActorLabelIndex::OnActorLabelChanged(AActor* Actor)
+{
+	if (FWorldLabelIndex* WorldIndex = FindWorldIndex(Actor))
+	{
+		RemoveActor(*WorldIndex, Actor);
+		AddActor(*WorldIndex, Actor);
+	}
+}
+
+void FActorLabelIndex::OnLevelActorAdded(AActor* Actor)
+{
+	if (FWorldLabelIndex* WorldIndex = FindWorldIndex(Actor))
+	{
+		AddActor(*WorldIndex, Actor);
+	}
+}
+
+void FActorLabelIndex::OnLevelActorDeleted(AActor* Actor)
+{
+	if (FWorldLabelIndex* WorldIndex = FindWorldIndex(Actor))
+	{
+		RemoveActor(*WorldIndex, Actor);
+	}
+}
+
+void FActorLabelIndex::OnWorldActorsInvalidated(UWorld* World)
+{
+	if (World)
+	{
+		IndexByWorld.Remove(World);
+	}
+	else
+	{
+		IndexByWorld.Empty();
+	}
+}
@@ -0,0 +1,96 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ActorActions/ActorSpatialIndex.h"
+#include "ActorActions/ActorActionsLog.h"
+#include "ActorActions/ActorLabelIndex.h"
+#include "ActorActions/EditorActorEvents.h"
+
+FActorSpatialIndex& FActorSpatialIndex::Get()
+{
+	static FActorSpatialIndex ActorSpatialIndex;
+	return ActorSpatialIndex;
+}
+
+void FActorSpatialIndex::Register()
+{
+	FEditorActorEvents& EditorActorEvents = FEditorActorEvents::Get();
+	ActorMovedHandle = EditorActorEvents.OnActorMoved.AddRaw(this, &FActorSpatialIndex::OnActorMoved);
+	LevelActorAddedHandle = EditorActorEvents.OnActorAdded.AddRaw(this, &FActorSpatialIndex::OnLevelActorAdded);
+	LevelActorDeletedHandle = EditorActorEvents.OnActorDeleted.AddRaw(this, &FActorSpatialIndex::OnLevelActorDeleted);
+	WorldActorsInvalidatedHandle = EditorActorEvents.OnWorldActorsInvalidated.AddRaw(this, &FActorSpatialIndex::OnWorldActorsInvalidated);
+}
+
+void FActorSpatialIndex::Unregister()
+{
+	FEditorActorEvents& EditorActorEvents = FEditorActorEvents::Get();
+	EditorActorEvents.OnActorMoved.Remove(ActorMovedHandle);
+	EditorActorEvents.OnActorAdded.Remove(LevelActorAddedHandle);
+	EditorActorEvents.OnActorDeleted.Remove(LevelActorDeletedHandle);
+	EditorActorEvents.OnWorldActorsInvalidated.Remove(WorldActorsInvalidatedHandle);
+	BVHByWorld.Empty();
+}
+
+const FActorBoundsBVH& FActorSpatialIndex::GetWorldBVH(UWorld* World)
+{
+	if (FActorBoundsBVH* ExistingBVH = BVHByWorld.Find(World))
+	{
+		if (ExistingBVH->NeedsRebuild()) BuildWorldBVH(World, *ExistingBVH);
+		return *ExistingBVH;
+	}
+
+	FActorBoundsBVH& WorldBVH = BVHByWorld.Add(World);
+	BuildWorldBVH(World, WorldBVH);
+	return WorldBVH;
+}
+
+void FActorSpatialIndex::BuildWorldBVH(UWorld* World, FActorBoundsBVH& WorldBVH)
+{
+	//Same actors the label index lists, so queries never return hidden engine actors
+	const double StartTime = FPlatformTime::Seconds();
+	TArray<AActor*> WorldActors;
+	FActorLabelIndex::Get().ForEachActor(World, [&WorldActors](AActor* Actor) { WorldActors.Add(Actor); });
+	WorldBVH.Build(WorldActors);
+	UE_LOG(LogSuperManagerActorActions, Verbose, TEXT("Built bounds hierarchy of %d actors in %.3f seconds"), WorldBVH.Num(), FPlatformTime::Seconds() - StartTime);
+}
+
+//Worlds that were never queried have no hierarchy, their events are ignored
+FActorBoundsBVH* FActorSpatialIndex::FindWorldBVH(const AActor* Actor)
+{
+	return Actor ? BVHByWorld.Find(Actor->GetWorld()) : nullptr;
+}
+
+void FActorSpatialIndex::OnActorMoved(AActor* Actor)
+{
+	if (FActorBoundsBVH* WorldBVH = FindWorldBVH(Actor))
+	{
+		WorldBVH->UpdateActor(Actor);
+	}
+}
+
+void FActorSpatialIndex::OnLevelActorAdded(AActor* Actor)
+{
+	if (FActorBoundsBVH* WorldBVH = FindWorldBVH(Actor))
+	{
+		if (Actor->IsEditable() && Actor->IsListedInSceneOutliner()) WorldBVH->AddActor(Actor);
+	}
+}
+
+void FActorSpatialIndex::OnLevelActorDeleted(AActor* Actor)
+{
+	if (FActorBoundsBVH* WorldBVH = FindWorldBVH(Actor))
+	{
+		WorldBVH->RemoveActor(Actor);
+	}
+}
+
+void FActorSpatialIndex::OnWorldActorsInvalidated(UWorld* World)
+{
+	if (World)
+	{
+		BVHByWorld.Remove(World);
+	}
+	else
+	{
+		BVHByWorld.Empty();
+	}
+}
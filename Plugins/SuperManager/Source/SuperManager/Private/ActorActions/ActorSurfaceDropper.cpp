@@ -0,0 +1,97 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ActorActions/ActorSurfaceDropper.h"
+#include "Engine/World.h"
+#include "CollisionQueryParams.h"
+#include "Async/ParallelFor.h"
+
+void FActorSurfaceDropper::FindDropTransforms(UWorld* World, const TArray<AActor*>& Actors,
+	TArray<FTransform>& OutTransforms, TArray<bool>& OutLanded) const
+{
+	OutTransforms.SetNumUninitialized(Actors.Num());
+	OutLanded.Init(false, Actors.Num());
+	if (!World) return;
+
+	//Everything that touches UObjects is read here, workers only trace and do math
+	TArray<FBox> ActorBounds;
+	ActorBounds.SetNumUninitialized(Actors.Num());
+	//Bounds in actor space, only needed to find the new bottom once the actor is tilted
+	TArray<FBox> LocalActorBounds;
+	LocalActorBounds.Init(FBox(FVector::ZeroVector, FVector::ZeroVector), bAlignToNormal ? Actors.Num() : 0);
+	TSet<uint32> DroppedActorIds;
+	DroppedActorIds.Reserve(Actors.Num());
+	for (int32 ActorIndex = 0; ActorIndex < Actors.Num(); ++ActorIndex)
+	{
+		const AActor* Actor = Actors[ActorIndex];
+		OutTransforms[ActorIndex] = Actor ? Actor->GetActorTransform() : FTransform::Identity;
+		const FBox Bounds = Actor ? Actor->GetComponentsBoundingBox(true) : FBox(ForceInit);
+		const FVector Location = OutTransforms[ActorIndex].GetLocation();
+		ActorBounds[ActorIndex] = Bounds.IsValid ? Bounds : FBox(Location, Location);
+		if (!Actor) continue;
+		DroppedActorIds.Add(Actor->GetUniqueID());
+		if (bAlignToNormal)
+		{
+			const FBox LocalBounds = Actor->CalculateComponentsBoundingBoxInLocalSpace(true);
+			if (LocalBounds.IsValid) LocalActorBounds[ActorIndex] = LocalBounds;
+		}
+	}
+
+	//Scene queries only read the physics scene, so the actors are traced in parallel
+	ParallelFor(Actors.Num(), [&](int32 ActorIndex)
+		{
+			if (!Actors[ActorIndex]) return;
+			const FTransform& ActorTransform = OutTransforms[ActorIndex];
+			const FBox& Bounds = ActorBounds[ActorIndex];
+			const FVector Location = ActorTransform.GetLocation();
+			const FVector TraceStart(Location.X, Location.Y, Bounds.Min.Z + TraceHeight);
+			const FVector TraceEnd(Location.X, Location.Y, Bounds.Min.Z - TraceDistance);
+
+			//Each trace ignores its own actor up front, other dropped actors only once they are actually hit,
+			//so the ignore list stays a handful of entries instead of every dropped actor
+			FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(SuperManagerDropToSurface), false);
+			QueryParams.AddIgnoredActor(Actors[ActorIndex]);
+
+			FHitResult Hit;
+			bool bHit = false;
+			double BottomOnHit = 0.0;
+			for (;;)
+			{
+				if (bSweepFootprint)
+				{
+					//A flat box with the bounds' footprint, raised so its bottom starts where a line would
+					const FVector FootprintExtent(Bounds.GetExtent().X, Bounds.GetExtent().Y, 1.f);
+					bHit = World->SweepSingleByChannel(Hit, TraceStart + FVector(0.f, 0.f, 1.f), TraceEnd + FVector(0.f, 0.f, 1.f),
+						FQuat::Identity, TraceChannel, FCollisionShape::MakeBox(FootprintExtent), QueryParams);
+					BottomOnHit = Hit.Location.Z - 1.0;
+				}
+				else
+				{
+					bHit = World->LineTraceSingleByChannel(Hit, TraceStart, TraceEnd, TraceChannel, QueryParams);
+					BottomOnHit = Hit.ImpactPoint.Z;
+				}
+				const AActor* HitActor = bHit ? Hit.GetActor() : nullptr;
+				if (!HitActor || !DroppedActorIds.Contains(HitActor->GetUniqueID())) break;
+				//Landed on another dropped actor, skip it and trace again
+				QueryParams.AddIgnoredActor(HitActor);
+			}
+			//Starting inside geometry gives no surface to rest on, the hit sits at the start
+			if (!bHit || Hit.bStartPenetrating) return;
+
+			FTransform DroppedTransform = ActorTransform;
+			//How far the pivot sits above the bottom of the bounds
+			double PivotHeight = Location.Z - Bounds.Min.Z;
+			if (bAlignToNormal)
+			{
+				const FVector Forward = ActorTransform.GetRotation().GetForwardVector();
+				DroppedTransform.SetRotation(FRotationMatrix::MakeFromZX(Hit.ImpactNormal, Forward).ToQuat());
+				//Tilting moves the lowest corner, so take the bottom from the bounds under the new rotation
+				FTransform TiltedAtOrigin = DroppedTransform;
+				TiltedAtOrigin.SetTranslation(FVector::ZeroVector);
+				PivotHeight = -LocalActorBounds[ActorIndex].TransformBy(TiltedAtOrigin).Min.Z;
+			}
+			//Rest the bottom of the bounds on the surface rather than the pivot
+			DroppedTransform.SetTranslation(FVector(Location.X, Location.Y, BottomOnHit + PivotHeight));
+			OutTransforms[ActorIndex] = DroppedTransform;
+			OutLanded[ActorIndex] = true;
+		});
+}
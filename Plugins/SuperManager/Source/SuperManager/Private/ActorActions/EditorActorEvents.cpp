@@ -0,0 +1,79 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ActorActions/EditorActorEvents.h"
+#include "Editor.h"
+#include "Misc/CoreDelegates.h"
+
+FEditorActorEvents& FEditorActorEvents::Get()
+{
+	static FEditorActorEvents EditorActorEvents;
+	return EditorActorEvents;
+}
+
+void FEditorActorEvents::Register()
+{
+	ActorLabelChangedHandle = FCoreDelegates::OnActorLabelChanged.AddLambda([this](AActor* Actor) { OnActorLabelChanged.Broadcast(Actor); });
+	WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddRaw(this, &FEditorActorEvents::OnWorldCleanup);
+	LevelAddedHandle = FWorldDelegates::LevelAddedToWorld.AddRaw(this, &FEditorActorEvents::OnLevelChanged);
+	LevelRemovedHandle = FWorldDelegates::LevelRemovedFromWorld.AddRaw(this, &FEditorActorEvents::OnLevelChanged);
+	PostUndoRedoHandle = FEditorDelegates::PostUndoRedo.AddRaw(this, &FEditorActorEvents::OnPostUndoRedo);
+	if (GEngine)
+	{
+		RegisterEngineDelegates();
+	}
+	else
+	{
+		PostEngineInitHandle = FCoreDelegates::OnPostEngineInit.AddRaw(this, &FEditorActorEvents::RegisterEngineDelegates);
+	}
+}
+
+void FEditorActorEvents::RegisterEngineDelegates()
+{
+	FCoreDelegates::OnPostEngineInit.Remove(PostEngineInitHandle);
+	PostEngineInitHandle.Reset();
+	if (!GEngine) return;
+	ActorMovedHandle = GEngine->OnActorMoved().AddLambda([this](AActor* Actor) { OnActorMoved.Broadcast(Actor); });
+	LevelActorAddedHandle = GEngine->OnLevelActorAdded().AddLambda([this](AActor* Actor) { OnActorAdded.Broadcast(Actor); });
+	LevelActorDeletedHandle = GEngine->OnLevelActorDeleted().AddLambda([this](AActor* Actor) { OnActorDeleted.Broadcast(Actor); });
+	LevelActorListChangedHandle = GEngine->OnLevelActorListChanged().AddRaw(this, &FEditorActorEvents::OnLevelActorListChanged);
+}
+
+void FEditorActorEvents::Unregister()
+{
+	FCoreDelegates::OnActorLabelChanged.Remove(ActorLabelChangedHandle);
+	FCoreDelegates::OnPostEngineInit.Remove(PostEngineInitHandle);
+	FWorldDelegates::OnWorldCleanup.Remove(WorldCleanupHandle);
+	FWorldDelegates::LevelAddedToWorld.Remove(LevelAddedHandle);
+	FWorldDelegates::LevelRemovedFromWorld.Remove(LevelRemovedHandle);
+	FEditorDelegates::PostUndoRedo.Remove(PostUndoRedoHandle);
+	if (GEngine)
+	{
+		GEngine->OnActorMoved().Remove(ActorMovedHandle);
+		GEngine->OnLevelActorAdded().Remove(LevelActorAddedHandle);
+		GEngine->OnLevelActorDeleted().Remove(LevelActorDeletedHandle);
+		GEngine->OnLevelActorListChanged().Remove(LevelActorListChangedHandle);
+	}
+}
+
+void FEditorActorEvents::OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources)
+{
+	OnWorldActorsInvalidated.Broadcast(World);
+}
+
+//A streamed sublevel brings or takes actors without per-actor events
+void FEditorActorEvents::OnLevelChanged(ULevel* Level, UWorld* World)
+{
+	OnWorldActorsInvalidated.Broadcast(World);
+}
+
+//Broadcast after bulk changes such as World Partition loading regions, the event does not say which world
+void FEditorActorEvents::OnLevelActorListChanged()
+{
+	OnWorldActorsInvalidated.Broadcast(nullptr);
+}
+
+//Undo moves, restores and removes actors without move, spawn or delete events
+void FEditorActorEvents::OnPostUndoRedo()
+{
+	OnWorldActorsInvalidated.Broadcast(nullptr);
+}
@@ -0,0 +1,220 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ActorActions/LevelCostProfiler.h"
+#include "Async/ParallelFor.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/Level.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "Misc/FileHelper.h"
+#include "StaticMeshResources.h"
+
+namespace
+{
+	int32 FindOrAddName(TArray<FString>& Names, TMap<FString, int32>& IndexByName, const FString& Name)
+	{
+		if (const int32* ExistingIndex = IndexByName.Find(Name)) return *ExistingIndex;
+		return IndexByName.Add(Name, Names.Add(Name));
+	}
+
+	struct FMeshTriangles
+	{
+		int64 Lod0 = 0;
+		int64 LastLod = 0;
+	};
+}
+
+void FLevelCostProfiler::Reset()
+{
+	ClassNames.Reset();
+	MeshNames.Reset();
+	FolderNames.Reset();
+	ActorClassIndices.Reset();
+	ActorMeshIndices.Reset();
+	ActorFolderIndices.Reset();
+	ActorComponentCounts.Reset();
+	ActorLod0Triangles.Reset();
+	ActorLastLodTriangles.Reset();
+	ActorMaterialSlots.Reset();
+	ActorCastsShadow.Reset();
+	ActorTicks.Reset();
+	ActorIsMovable.Reset();
+}
+
+//Walks the level's actor lists rather than an actor iterator so worlds loaded by a commandlet work too
+void FLevelCostProfiler::Gather(UWorld* World)
+{
+	Reset();
+	if (!World) return;
+
+	TArray<ULevel*> Levels(World->GetLevels());
+	if (Levels.Num() == 0 && World->PersistentLevel) Levels.Add(World->PersistentLevel);
+
+	TMap<FString, int32> ClassIndexByName;
+	TMap<FString, int32> MeshIndexByName;
+	TMap<FString, int32> FolderIndexByName;
+	//Render data is read once per mesh, not once per actor
+	TMap<const UStaticMesh*, FMeshTriangles> TrianglesByMesh;
+	const int32 NoMeshIndex = FindOrAddName(MeshNames, MeshIndexByName, TEXT("(No Static Mesh)"));
+
+	TArray<UActorComponent*> Components;
+	for (const ULevel* Level : Levels)
+	{
+		if (!Level) continue;
+		for (AActor* Actor : Level->Actors)
+		{
+			if (!Actor || Actor->IsPendingKillPending()) continue;
+
+			Components.Reset();
+			Actor->GetComponents(Components);
+			int32 MeshIndex = NoMeshIndex;
+			int64 Lod0Triangles = 0;
+			int64 LastLodTriangles = 0;
+			int32 MaterialSlots = 0;
+			bool bCastsShadow = false;
+			bool bTicks = Actor->PrimaryActorTick.bCanEverTick && Actor->PrimaryActorTick.bStartWithTickEnabled;
+			for (const UActorComponent* Component : Components)
+			{
+				bTicks |= Component->PrimaryComponentTick.bCanEverTick && Component->PrimaryComponentTick.bStartWithTickEnabled;
+				const UPrimitiveComponent* PrimitiveComponent = Cast<UPrimitiveComponent>(Component);
+				if (!PrimitiveComponent) continue;
+				bCastsShadow |= PrimitiveComponent->CastShadow;
+				MaterialSlots += PrimitiveComponent->GetNumMaterials();
+
+				const UStaticMeshComponent* MeshComponent = Cast<UStaticMeshComponent>(PrimitiveComponent);
+				const UStaticMesh* StaticMesh = MeshComponent ? MeshComponent->GetStaticMesh() : nullptr;
+				if (!StaticMesh) continue;
+				if (MeshIndex == NoMeshIndex)
+				{
+					MeshIndex = FindOrAddName(MeshNames, MeshIndexByName, StaticMesh->GetPathName());
+				}
+
+				FMeshTriangles* MeshTriangles = TrianglesByMesh.Find(StaticMesh);
+				if (!MeshTriangles)
+				{
+					MeshTriangles = &TrianglesByMesh.Add(StaticMesh);
+					if (const FStaticMeshRenderData* RenderData = StaticMesh->GetRenderData())
+					{
+						if (RenderData->LODResources.Num() > 0)
+						{
+							MeshTriangles->Lod0 = RenderData->LODResources[0].GetNumTriangles();
+							MeshTriangles->LastLod = RenderData->LODResources.Last().GetNumTriangles();
+						}
+					}
+				}
+				const UInstancedStaticMeshComponent* InstanceComponent = Cast<UInstancedStaticMeshComponent>(MeshComponent);
+				const int64 NumCopies = InstanceComponent ? InstanceComponent->GetInstanceCount() : 1;
+				Lod0Triangles += MeshTriangles->Lod0 * NumCopies;
+				LastLodTriangles += MeshTriangles->LastLod * NumCopies;
+			}
+
+			const USceneComponent* RootComponent = Actor->GetRootComponent();
+			const FString FolderName = Actor->GetFolderPath().IsNone() ? TEXT("(Root)") : Actor->GetFolderPath().ToString();
+			ActorClassIndices.Add(FindOrAddName(ClassNames, ClassIndexByName, Actor->GetClass()->GetName()));
+			ActorMeshIndices.Add(MeshIndex);
+			ActorFolderIndices.Add(FindOrAddName(FolderNames, FolderIndexByName, FolderName));
+			ActorComponentCounts.Add(Components.Num());
+			ActorLod0Triangles.Add(Lod0Triangles);
+			ActorLastLodTriangles.Add(LastLodTriangles);
+			ActorMaterialSlots.Add(MaterialSlots);
+			ActorCastsShadow.Add(bCastsShadow);
+			ActorTicks.Add(bTicks);
+			ActorIsMovable.Add(RootComponent && RootComponent->Mobility == EComponentMobility::Movable);
+		}
+	}
+}
+
+//Each chunk sums into its own dense table, the tables are merged afterwards
+void FLevelCostProfiler::Aggregate(E_LevelCostGrouping Grouping, TArray< TSharedPtr<FLevelCostRow> >& OutRows) const
+{
+	const TArray<FString>* GroupNames = &ClassNames;
+	const TArray<int32>* GroupIndices = &ActorClassIndices;
+	if (Grouping == E_LevelCostGrouping::ELCG_Mesh)
+	{
+		GroupNames = &MeshNames;
+		GroupIndices = &ActorMeshIndices;
+	}
+	else if (Grouping == E_LevelCostGrouping::ELCG_Folder)
+	{
+		GroupNames = &FolderNames;
+		GroupIndices = &ActorFolderIndices;
+	}
+
+	const int32 NumGroups = GroupNames->Num();
+	const int32 NumChunks = FMath::Clamp(NumActors() / 4096, 1, 64);
+	const int32 ChunkSize = FMath::DivideAndRoundUp(FMath::Max(NumActors(), 1), NumChunks);
+	TArray<TArray<FLevelCostRow>> ChunkRows;
+	ChunkRows.SetNum(NumChunks);
+
+	ParallelFor(NumChunks, [&](int32 ChunkIndex)
+		{
+			TArray<FLevelCostRow>& Rows = ChunkRows[ChunkIndex];
+			Rows.SetNum(NumGroups);
+			const int32 LastActor = FMath::Min((ChunkIndex + 1) * ChunkSize, NumActors());
+			for (int32 ActorIndex = ChunkIndex * ChunkSize; ActorIndex < LastActor; ++ActorIndex)
+			{
+				FLevelCostRow& Row = Rows[(*GroupIndices)[ActorIndex]];
+				Row.NumActors++;
+				Row.NumComponents += ActorComponentCounts[ActorIndex];
+				Row.Lod0Triangles += ActorLod0Triangles[ActorIndex];
+				Row.LastLodTriangles += ActorLastLodTriangles[ActorIndex];
+				Row.NumMaterialSlots += ActorMaterialSlots[ActorIndex];
+				Row.NumShadowCasters += ActorCastsShadow[ActorIndex];
+				Row.NumTicking += ActorTicks[ActorIndex];
+				Row.NumMovable += ActorIsMovable[ActorIndex];
+			}
+		});
+
+	OutRows.Reset();
+	for (int32 GroupIndex = 0; GroupIndex < NumGroups; ++GroupIndex)
+	{
+		TSharedPtr<FLevelCostRow> GroupRow = MakeShared<FLevelCostRow>();
+		GroupRow->GroupName = (*GroupNames)[GroupIndex];
+		for (const TArray<FLevelCostRow>& Rows : ChunkRows)
+		{
+			const FLevelCostRow& Row = Rows[GroupIndex];
+			GroupRow->NumActors += Row.NumActors;
+			GroupRow->NumComponents += Row.NumComponents;
+			GroupRow->Lod0Triangles += Row.Lod0Triangles;
+			GroupRow->LastLodTriangles += Row.LastLodTriangles;
+			GroupRow->NumMaterialSlots += Row.NumMaterialSlots;
+			GroupRow->NumShadowCasters += Row.NumShadowCasters;
+			GroupRow->NumTicking += Row.NumTicking;
+			GroupRow->NumMovable += Row.NumMovable;
+		}
+		if (GroupRow->NumActors > 0) OutRows.Add(GroupRow);
+	}
+	OutRows.Sort([](const TSharedPtr<FLevelCostRow>& RowA, const TSharedPtr<FLevelCostRow>& RowB)
+		{
+			return RowA->Lod0Triangles > RowB->Lod0Triangles;
+		});
+}
+
+FString FLevelCostProfiler::GetGroupingName(E_LevelCostGrouping Grouping)
+{
+	switch (Grouping)
+	{
+	case E_LevelCostGrouping::ELCG_Mesh:
+		return TEXT("Mesh");
+	case E_LevelCostGrouping::ELCG_Folder:
+		return TEXT("Folder");
+	default:
+		return TEXT("Class");
+	}
+}
+
+bool FLevelCostProfiler::ExportCsv(const TArray< TSharedPtr<FLevelCostRow> >& Rows, const FString& FilePath)
+{
+	TArray<FString> Lines;
+	Lines.Reserve(Rows.Num() + 1);
+	Lines.Add(TEXT("Group,Actors,Components,Lod0Triangles,LastLodTriangles,MaterialSlots,ShadowCasters,Ticking,Movable"));
+	for (const TSharedPtr<FLevelCostRow>& Row : Rows)
+	{
+		//Quotes inside a quoted field are doubled
+		const FString GroupName = Row->GroupName.Replace(TEXT("\""), TEXT("\"\""));
+		Lines.Add(FString::Printf(TEXT("\"%s\",%d,%d,%lld,%lld,%d,%d,%d,%d"), *GroupName, Row->NumActors,
+			Row->NumComponents, Row->Lod0Triangles, Row->LastLodTriangles, Row->NumMaterialSlots,
+			Row->NumShadowCasters, Row->NumTicking, Row->NumMovable));
+	}
+	return FFileHelper::SaveStringArrayToFile(Lines, *FilePath);
+}
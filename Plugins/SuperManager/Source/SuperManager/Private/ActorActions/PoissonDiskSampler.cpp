@@ -0,0 +1,91 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ActorActions/PoissonDiskSampler.h"
+
+void FPoissonDiskSampler::Sample(const FBox2D& Region, float MinDistance, int32 MaxPoints, int32 Seed,
+	TFunctionRef<bool(const FVector2D&)> IsPointAllowed, TArray<FVector2D>& OutPoints)
+{
+	if (!Region.bIsValid || MinDistance <= 0.f || MaxPoints <= 0) return;
+
+	const double CellSize = MinDistance / UE_SQRT_2;
+	const FVector2D RegionSize = Region.GetSize();
+	const int64 GridWidth64 = FMath::Max<int64>(1, FMath::CeilToInt64(RegionSize.X / CellSize));
+	const int64 GridHeight64 = FMath::Max<int64>(1, FMath::CeilToInt64(RegionSize.Y / CellSize));
+	if (GridWidth64 * GridHeight64 > MAX_int32)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("Scatter region is too large for a spacing of %f"), MinDistance);
+		return;
+	}
+	//Both fit in int32 once their product does
+	const int32 GridWidth = static_cast<int32>(GridWidth64);
+	const int32 GridHeight = static_cast<int32>(GridHeight64);
+
+	TArray<int32> Grid;
+	Grid.Init(INDEX_NONE, GridWidth * GridHeight);
+	TArray<int32> ActivePoints;
+	const double MinDistanceSquared = FMath::Square(MinDistance);
+
+	auto CellOf = [&Region, CellSize, GridWidth, GridHeight](const FVector2D& Point)
+		{
+			return FIntPoint(
+				FMath::Clamp(FMath::FloorToInt32((Point.X - Region.Min.X) / CellSize), 0, GridWidth - 1),
+				FMath::Clamp(FMath::FloorToInt32((Point.Y - Region.Min.Y) / CellSize), 0, GridHeight - 1));
+		};
+
+	//Points closer than MinDistance can only sit in the 5x5 cells around the candidate
+	auto IsFarEnough = [&](const FVector2D& Point, const FIntPoint& Cell)
+		{
+			for (int32 CellY = FMath::Max(0, Cell.Y - 2); CellY <= FMath::Min(GridHeight - 1, Cell.Y + 2); ++CellY)
+			{
+				for (int32 CellX = FMath::Max(0, Cell.X - 2); CellX <= FMath::Min(GridWidth - 1, Cell.X + 2); ++CellX)
+				{
+					const int32 PointIndex = Grid[CellY * GridWidth + CellX];
+					if (PointIndex != INDEX_NONE && FVector2D::DistSquared(OutPoints[PointIndex], Point) < MinDistanceSquared)
+					{
+						return false;
+					}
+				}
+			}
+			return true;
+		};
+
+	auto TryAddPoint = [&](const FVector2D& Point)
+		{
+			if (!Region.IsInside(Point)) return false;
+			const FIntPoint Cell = CellOf(Point);
+			//The caller's test is the expensive one, run it last
+			if (!IsFarEnough(Point, Cell) || !IsPointAllowed(Point)) return false;
+			const int32 PointIndex = OutPoints.Add(Point);
+			Grid[Cell.Y * GridWidth + Cell.X] = PointIndex;
+			ActivePoints.Add(PointIndex);
+			return true;
+		};
+
+	FRandomStream RandomStream(Seed);
+	int32 SeedAttempts = 0;
+	while (OutPoints.Num() < MaxPoints)
+	{
+		if (ActivePoints.Num() == 0)
+		{
+			if (SeedAttempts++ >= MaxSeedAttempts) break;
+			TryAddPoint(FVector2D(RandomStream.FRandRange(Region.Min.X, Region.Max.X),
+				RandomStream.FRandRange(Region.Min.Y, Region.Max.Y)));
+			continue;
+		}
+
+		const int32 ActiveSlot = RandomStream.RandHelper(ActivePoints.Num());
+		const FVector2D Center = OutPoints[ActivePoints[ActiveSlot]];
+		bool bFoundCandidate = false;
+		for (int32 Attempt = 0; Attempt < CandidatesPerPoint && !bFoundCandidate; ++Attempt)
+		{
+			//Uniform in the annulus between MinDistance and twice that
+			const double Angle = RandomStream.FRand() * UE_TWO_PI;
+			const double Radius = MinDistance * (1.0 + RandomStream.FRand());
+			bFoundCandidate = TryAddPoint(Center + FVector2D(FMath::Cos(Angle), FMath::Sin(Angle)) * Radius);
+		}
+		if (!bFoundCandidate)
+		{
+			ActivePoints.RemoveAtSwap(ActiveSlot);
+		}
+	}
+}
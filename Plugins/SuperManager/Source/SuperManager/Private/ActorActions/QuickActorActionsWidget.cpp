@@ -2,6 +2,25 @@
 #include "ActorActions/QuickActorActionsWidget.h"
 #include "Subsystems/EditorActorSubsystem.h"
 #include "DebugHeader.h"
+#include "ActorActions/ActorActionsLog.h"
+#include "ActorActions/ActorLabelIndex.h"
+#include "ActorActions/StaticMeshInstancer.h"
+#include "ActorActions/PoissonDiskSampler.h"
+#include "ActorActions/ActorBoundsBVH.h"
+#include "ActorActions/ScopedActorBatch.h"
+#include "ActorActions/StackedActorDetector.h"
+#include "ActorActions/ActorSpatialIndex.h"
+#include "ActorActions/ActorSurfaceDropper.h"
+#include "ActorActions/SplineBand.h"
+#include "GameFramework/Volume.h"
+#include "Components/SplineComponent.h"
+#include "Engine/Brush.h"
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Components/StaticMeshComponent.h"
+#include "Editor.h"
+#include "Async/ParallelFor.h"
+#include "Internationalization/Regex.h"
 void UQuickActorActionsWidget::SelectAllActorsWithSimilarName()
 {
 	if (!GetEditorActorSubsystem()) return;
@@ -17,18 +36,17 @@ void UQuickActorActionsWidget::SelectAllActorsWithSimilarName()
 		DebugHeader::ShowNInfo(TEXT("You can only select one actor"));
 		return;
 	}
-	FString SelectedActorName = SelectedActors[0]->GetActorLabel();
-	const FString NameToSearch = SelectedActorName.LeftChop(4);
-	TArray<AActor*> AllLeveActors = EditorActorSubsystem->GetAllLevelActors();
-	for (AActor* ActorInLevel : AllLeveActors)
+	TArray<AActor*> SimilarActors;
+	FindSimilarActors(SelectedActors[0], SimilarActors);
 	{
-		if (!ActorInLevel) continue;
-		if (ActorInLevel->GetActorLabel().Contains(NameToSearch, SearchCase))
+		FScopedActorBatch ActorBatch(NSLOCTEXT("QuickActorActions", "SelectSimilarActors", "Select Similar Actors"));
+		for (AActor* SimilarActor : SimilarActors)
 		{
-			EditorActorSubsystem->SetActorSelectionState(ActorInLevel, true);
-			SelectionCounter++;
+			ActorBatch.SelectActor(SimilarActor);
 		}
+		SelectionCounter = ActorBatch.NumSelectedActors();
 	}
+
 	if (SelectionCounter > 0)
 	{
 		DebugHeader::ShowNInfo(TEXT("Successfully selected ") +
@@ -40,6 +58,116 @@ void UQuickActorActionsWidget::SelectAllActorsWithSimilarName()
 	}
 }
 
+void UQuickActorActionsWidget::SelectActorsInRadius()
+{
+	AActor* ReferenceActor = GetSpatialQueryReferenceActor();
+	if (!ReferenceActor) return;
+
+	const double StartTime = FPlatformTime::Seconds();
+	const FVector Center = ReferenceActor->GetActorLocation();
+	TArray<AActor*> FoundActors;
+	//The box only narrows the search, keep actors whose stored bounds reach into the sphere
+	const double RadiusSquared = FMath::Square(SpatialQueryRadius);
+	FActorSpatialIndex::Get().GetWorldBVH(ReferenceActor->GetWorld()).ForEachOverlapping(
+		FBox::BuildAABB(Center, FVector(SpatialQueryRadius)),
+		[this, &Center, RadiusSquared, &FoundActors](AActor* FoundActor, const FBox& FoundBounds)
+		{
+			if (FoundBounds.ComputeSquaredDistanceToPoint(Center) <= RadiusSquared && PassesSpatialQueryClass(FoundActor))
+			{
+				FoundActors.Add(FoundActor);
+			}
+		});
+	ApplySpatialQueryResult(ReferenceActor, FoundActors, StartTime);
+}
+
+void UQuickActorActionsWidget::SelectActorsInBox()
+{
+	AActor* ReferenceActor = GetSpatialQueryReferenceActor();
+	if (!ReferenceActor) return;
+
+	const double StartTime = FPlatformTime::Seconds();
+	TArray<AActor*> FoundActors;
+	FActorSpatialIndex::Get().GetWorldBVH(ReferenceActor->GetWorld()).QueryOverlapping(
+		FBox::BuildAABB(ReferenceActor->GetActorLocation(), SpatialQueryBoxExtent), FoundActors);
+	FoundActors.RemoveAllSwap([this](const AActor* FoundActor) { return !PassesSpatialQueryClass(FoundActor); });
+	ApplySpatialQueryResult(ReferenceActor, FoundActors, StartTime);
+}
+
+void UQuickActorActionsWidget::SelectActorsInsideVolume()
+{
+	AActor* ReferenceActor = GetSpatialQueryReferenceActor();
+	if (!ReferenceActor) return;
+	AVolume* QueryVolume = Cast<AVolume>(ReferenceActor);
+	if (!QueryVolume)
+	{
+		DebugHeader::ShowNInfo(TEXT("Selected actor is not a volume"));
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	TArray<AActor*> FoundActors;
+	FActorSpatialIndex::Get().GetWorldBVH(QueryVolume->GetWorld()).QueryOverlapping(
+		QueryVolume->GetComponentsBoundingBox(true), FoundActors);
+	FoundActors.RemoveAllSwap([this, QueryVolume](const AActor* FoundActor)
+		{
+			return FoundActor == QueryVolume || !PassesSpatialQueryClass(FoundActor) ||
+				!QueryVolume->EncompassesPoint(FoundActor->GetActorLocation());
+		});
+	ApplySpatialQueryResult(ReferenceActor, FoundActors, StartTime);
+}
+
+void UQuickActorActionsWidget::SelectNearestActors()
+{
+	AActor* ReferenceActor = GetSpatialQueryReferenceActor();
+	if (!ReferenceActor) return;
+
+	const double StartTime = FPlatformTime::Seconds();
+	TArray<AActor*> FoundActors;
+	FActorSpatialIndex::Get().GetWorldBVH(ReferenceActor->GetWorld()).FindNearest(
+		ReferenceActor->GetActorLocation(), SpatialQueryCount,
+		[this, ReferenceActor](AActor* FoundActor) { return FoundActor != ReferenceActor && PassesSpatialQueryClass(FoundActor); },
+		FoundActors);
+	ApplySpatialQueryResult(ReferenceActor, FoundActors, StartTime);
+}
+
+void UQuickActorActionsWidget::SelectStackedDuplicates()
+{
+	if (!GetEditorActorSubsystem()) return;
+	UWorld* World = GEditor->GetEditorWorldContext().World();
+	if (!World) return;
+
+	TArray<AActor*> LevelActors;
+	FActorLabelIndex::Get().ForEachActor(World, [&LevelActors](AActor* Actor) { LevelActors.Add(Actor); });
+
+	FStackedActorDetector StackedDetector;
+	StackedDetector.LocationTolerance = StackedLocationTolerance;
+	StackedDetector.RotationToleranceDegrees = StackedRotationTolerance;
+	StackedDetector.ScaleTolerance = StackedScaleTolerance;
+	const double StartTime = FPlatformTime::Seconds();
+	TArray<AActor*> StackedDuplicates;
+	StackedDetector.FindStackedDuplicates(LevelActors, StackedDuplicates);
+	UE_LOG(LogSuperManagerActorActions, Verbose, TEXT("Checked %d actors for stacked duplicates in %.3f seconds"),
+		LevelActors.Num(), FPlatformTime::Seconds() - StartTime);
+
+	if (StackedDuplicates.Num() == 0)
+	{
+		DebugHeader::ShowNInfo(TEXT("No stacked duplicate found"));
+		return;
+	}
+	uint32 SelectionCounter = 0;
+	{
+		FScopedActorBatch ActorBatch(NSLOCTEXT("QuickActorActions", "SelectStackedDuplicates", "Select Stacked Duplicates"));
+		ActorBatch.DeselectAll();
+		for (AActor* StackedDuplicate : StackedDuplicates)
+		{
+			ActorBatch.SelectActor(StackedDuplicate);
+		}
+		SelectionCounter = ActorBatch.NumSelectedActors();
+	}
+	DebugHeader::ShowNInfo(TEXT("Selected ") + FString::FromInt(SelectionCounter) +
+		TEXT(" stacked duplicates, delete them to keep one actor of each stack"));
+}
+
 void UQuickActorActionsWidget::DuplicateActors()
 {
 	if (!GetEditorActorSubsystem()) return;
@@ -67,55 +195,291 @@ void UQuickActorActionsWidget::DuplicateActors()
 	const float CosTheta = FMath::Cos(AngleInRadians);
 	const float SinTheta = FMath::Sin(AngleInRadians);
 
-	for (AActor* SelectedActor : SelectedActors)
+	TArray<AActor*> ActorsToDuplicate;
+	uint32 InstanceCounter = 0;
 	{
-		if (!SelectedActor) continue;
-		for (int32 i = 0; i < NumberOfDuplicates; i++)
+		FScopedActorBatch ActorBatch(NSLOCTEXT("QuickActorActions", "DuplicateActors", "Duplicate Actors"));
+		if (bDuplicateAsInstances)
+		{
+			//Actors without a plain static mesh still get full copies
+			InstanceCounter = DuplicateActorsAsInstances(SelectedActors, CosTheta, SinTheta, ActorBatch, ActorsToDuplicate);
+		}
+		else
 		{
-			AActor* DuplicatedActor =
-				EditorActorSubsystem->DuplicateActor(SelectedActor, SelectedActor->GetWorld());
-			if (!DuplicatedActor) continue;
+			ActorsToDuplicate = SelectedActors;
+		}
 
-			const float DuplicationOffsetDist = (i + 1) * OffsetDist;
+		ActorsToDuplicate.RemoveAll([](const AActor* Actor) { return Actor == nullptr; });
+		//Every copy shares its offset with the same copy of the other actors, one duplication per offset
+		for (int32 i = 0; i < NumberOfDuplicates && ActorsToDuplicate.Num() > 0; i++)
+		{
 			FVector OffsetVector;
+			if (!ComputeDuplicationOffset(i, CosTheta, SinTheta, OffsetVector)) continue;
 
-			switch (AxisForDuplication)
+			const TArray<AActor*> DuplicatedActors =
+				EditorActorSubsystem->DuplicateActors(ActorsToDuplicate, ActorsToDuplicate[0]->GetWorld(), OffsetVector);
+			for (AActor* DuplicatedActor : DuplicatedActors)
 			{
-			case E_DuplicationAxis::EDA_XAxis:
-				// Rotate around Z axis in XY plane
-				OffsetVector = FVector(
-					DuplicationOffsetDist * CosTheta,
-					DuplicationOffsetDist * SinTheta,
-					0.f);
-				break;
-			case E_DuplicationAxis::EDA_YAxis:
-				// Rotate around Z axis in XY plane, but starting from Y axis
-				OffsetVector = FVector(
-					-DuplicationOffsetDist * SinTheta,
-					DuplicationOffsetDist * CosTheta,
-					0.f);
-				break;
-			case E_DuplicationAxis::EDA_ZAxis:
-				// Rotate around Y axis in XZ plane
-				OffsetVector = FVector(
-					DuplicationOffsetDist * SinTheta,
-					0.f,
-					DuplicationOffsetDist * CosTheta);
-				break;
-			default:
-				continue;
+				ActorBatch.AddSpawnedActor(DuplicatedActor);
+				Counter++;
 			}
+		}
+	}
+	if (InstanceCounter > 0)
+	{
+		DebugHeader::ShowNInfo(TEXT("Successfully added ") +
+			FString::FromInt(InstanceCounter) + TEXT(" instances"));
+	}
+	if (Counter > 0)
+	{
+		DebugHeader::ShowNInfo(TEXT("Successfully duplicated ") +
+			FString::FromInt(Counter) + TEXT(" actors"));
+	}
+}
 
-			DuplicatedActor->AddActorWorldOffset(OffsetVector);
-			EditorActorSubsystem->SetActorSelectionState(DuplicatedActor, true);
+void UQuickActorActionsWidget::DropActorsToSurface()
+{
+	if (!GetEditorActorSubsystem()) return;
+	TArray<AActor*> SelectedActors = EditorActorSubsystem->GetSelectedLevelActors();
+	SelectedActors.RemoveAll([](const AActor* SelectedActor) { return SelectedActor == nullptr; });
+	if (SelectedActors.Num() == 0)
+	{
+		DebugHeader::ShowNInfo(TEXT("No actor selected"));
+		return;
+	}
+
+	FActorSurfaceDropper SurfaceDropper;
+	SurfaceDropper.TraceHeight = SnapTraceHeight;
+	SurfaceDropper.TraceDistance = SnapTraceDistance;
+	SurfaceDropper.TraceChannel = SnapTraceChannel;
+	SurfaceDropper.bSweepFootprint = bSweepActorFootprint;
+	SurfaceDropper.bAlignToNormal = bAlignToSurfaceNormal;
+	const double StartTime = FPlatformTime::Seconds();
+	TArray<FTransform> DropTransforms;
+	TArray<bool> ActorLanded;
+	SurfaceDropper.FindDropTransforms(SelectedActors[0]->GetWorld(), SelectedActors, DropTransforms, ActorLanded);
+	const double TraceSeconds = FPlatformTime::Seconds() - StartTime;
+
+	uint32 Counter = 0;
+	{
+		FScopedActorBatch ActorBatch(NSLOCTEXT("QuickActorActions", "DropToSurface", "Drop Actors To Surface"));
+		for (int32 ActorIndex = 0; ActorIndex < SelectedActors.Num(); ++ActorIndex)
+		{
+			if (!ActorLanded[ActorIndex]) continue;
+			ActorBatch.SetActorTransform(SelectedActors[ActorIndex], DropTransforms[ActorIndex]);
 			Counter++;
 		}
 	}
+	UE_LOG(LogSuperManagerActorActions, Verbose, TEXT("Traced %d actors in %.3f seconds, dropped %u"), SelectedActors.Num(), TraceSeconds, Counter);
+
 	if (Counter > 0)
 	{
-		DebugHeader::ShowNInfo(TEXT("Successfully duplicated ") +
+		DebugHeader::ShowNInfo(TEXT("Successfully dropped ") +
 			FString::FromInt(Counter) + TEXT(" actors"));
 	}
+	if (Counter < static_cast<uint32>(SelectedActors.Num()))
+	{
+		DebugHeader::ShowNInfo(FString::FromInt(SelectedActors.Num() - Counter) + TEXT(" actors found no surface below"));
+	}
+}
+
+void UQuickActorActionsWidget::ScatterActors()
+{
+	if (!GetEditorActorSubsystem()) return;
+	TArray<AActor*> SelectedActors = EditorActorSubsystem->GetSelectedLevelActors();
+
+	//A selected spline is the region, everything else is scattered
+	USplineComponent* RegionSpline = nullptr;
+	TArray<AActor*> SourceActors;
+	for (AActor* SelectedActor : SelectedActors)
+	{
+		if (!SelectedActor) continue;
+		USplineComponent* SplineComponent = SelectedActor->FindComponentByClass<USplineComponent>();
+		if (SplineComponent && !RegionSpline) RegionSpline = SplineComponent;
+		else SourceActors.Add(SelectedActor);
+	}
+	if (SourceActors.Num() == 0)
+	{
+		DebugHeader::ShowNInfo(TEXT("No actor selected to scatter"));
+		return;
+	}
+	UWorld* World = SourceActors[0]->GetWorld();
+	const double StartTime = FPlatformTime::Seconds();
+
+	FBox2D Region(ForceInit);
+	const double RegionZ = SourceActors[0]->GetActorLocation().Z;
+	//Sampled once, every candidate point then only measures the segments near it
+	FSplineBand SplineBand;
+	if (RegionSpline)
+	{
+		SplineBand.Build(RegionSpline, ScatterSplineWidth);
+		Region = SplineBand.GetBounds();
+	}
+	else
+	{
+		const FVector2D RegionCenter(SourceActors[0]->GetActorLocation());
+		Region = FBox2D(RegionCenter - ScatterExtent, RegionCenter + ScatterExtent);
+	}
+
+	//Room each copy needs, relative to its actor location
+	FBox SourceFootprint(ForceInit);
+	for (AActor* SourceActor : SourceActors)
+	{
+		SourceFootprint += SourceActor->GetComponentsBoundingBox(true).ShiftBy(-SourceActor->GetActorLocation());
+	}
+	if (!SourceFootprint.IsValid) SourceFootprint = FBox(FVector::ZeroVector, FVector::ZeroVector);
+
+	//Volumes, the selection and anything covering the whole region (landscape, sky) never block a point
+	FActorBoundsBVH ExistingActorsBVH;
+	if (bAvoidExistingActors)
+	{
+		const TSet<AActor*> SelectedActorSet(SelectedActors);
+		TArray<AActor*> BlockingActors;
+		for (AActor* LevelActor : EditorActorSubsystem->GetAllLevelActors())
+		{
+			if (!LevelActor || LevelActor->IsA<ABrush>() || SelectedActorSet.Contains(LevelActor)) continue;
+			const FBox LevelActorBounds = LevelActor->GetComponentsBoundingBox(true);
+			if (!LevelActorBounds.IsValid) continue;
+			const FBox2D LevelActorBounds2D(FVector2D(LevelActorBounds.Min), FVector2D(LevelActorBounds.Max));
+			if (LevelActorBounds2D.IsInside(Region)) continue;
+			BlockingActors.Add(LevelActor);
+		}
+		ExistingActorsBVH.Build(BlockingActors);
+	}
+
+	//Heights of accepted points, filled in the same order as the sampler adds them
+	TArray<double> PointHeights;
+	TArray<FVector2D> ScatterPoints;
+	FPoissonDiskSampler::Sample(Region, ScatterMinSpacing, ScatterMaxPoints, ScatterSeed,
+		[&](const FVector2D& Point)
+		{
+			double PointZ = RegionZ;
+			if (RegionSpline && !SplineBand.FindClosestHeight(Point, PointZ)) return false;
+			if (ExistingActorsBVH.Num() > 0 && ExistingActorsBVH.Overlaps(SourceFootprint.ShiftBy(FVector(Point, PointZ))))
+			{
+				return false;
+			}
+			PointHeights.Add(PointZ);
+			return true;
+		}, ScatterPoints);
+	const double SampleTime = FPlatformTime::Seconds() - StartTime;
+
+	//Copies are spread over the sources from a stream seeded apart from the sampler
+	FRandomStream SourceStream(static_cast<int32>(HashCombine(GetTypeHash(ScatterSeed), GetTypeHash(ScatterPoints.Num()))));
+	TMap<FStaticMeshInstanceKey, TArray<FTransform>> InstanceTransformsByKey;
+	TArray<TPair<AActor*, FVector>> ActorCopies;
+	for (int32 PointIndex = 0; PointIndex < ScatterPoints.Num(); ++PointIndex)
+	{
+		AActor* SourceActor = SourceActors[SourceStream.RandHelper(SourceActors.Num())];
+		const FVector PointLocation(ScatterPoints[PointIndex], PointHeights[PointIndex]);
+		const UStaticMeshComponent* MeshComponent = bScatterAsInstances ?
+			FStaticMeshInstancer::FindSourceMeshComponent(SourceActor) : nullptr;
+		if (!MeshComponent)
+		{
+			ActorCopies.Emplace(SourceActor, PointLocation);
+			continue;
+		}
+		FTransform InstanceTransform = MeshComponent->GetComponentTransform();
+		InstanceTransform.SetTranslation(PointLocation + MeshComponent->GetComponentLocation() - SourceActor->GetActorLocation());
+		InstanceTransformsByKey.FindOrAdd(FStaticMeshInstanceKey::FromComponent(MeshComponent)).Add(InstanceTransform);
+	}
+
+	{
+		FScopedActorBatch ActorBatch(NSLOCTEXT("QuickActorActions", "ScatterActors", "Scatter Actors"));
+		for (const TPair<FStaticMeshInstanceKey, TArray<FTransform>>& InstanceGroup : InstanceTransformsByKey)
+		{
+			UInstancedStaticMeshComponent* InstanceComponent = FStaticMeshInstancer::SpawnInstanceActor(
+				World->GetCurrentLevel(), InstanceGroup.Key, FTransform(FVector(Region.GetCenter(), RegionZ)),
+				bUseHierarchicalInstances, InstanceGroup.Key.StaticMesh->GetName() + TEXT("_Scatter"));
+			if (!InstanceComponent) continue;
+			ActorBatch.SuspendRenderState(InstanceComponent->GetOwner());
+			InstanceComponent->AddInstances(InstanceGroup.Value, false, true);
+			ActorBatch.AddSpawnedActor(InstanceComponent->GetOwner());
+		}
+		for (const TPair<AActor*, FVector>& ActorCopy : ActorCopies)
+		{
+			if (AActor* DuplicatedActor = EditorActorSubsystem->DuplicateActor(ActorCopy.Key, World))
+			{
+				DuplicatedActor->SetActorLocation(ActorCopy.Value);
+				ActorBatch.AddSpawnedActor(DuplicatedActor, false);
+			}
+		}
+	}
+	UE_LOG(LogSuperManagerActorActions, Verbose, TEXT("Scattered %d points (%d blocking actors) in %.3f seconds, sampling took %.3f seconds"),
+		ScatterPoints.Num(), ExistingActorsBVH.Num(), FPlatformTime::Seconds() - StartTime, SampleTime);
+
+	if (ScatterPoints.Num() > 0)
+	{
+		DebugHeader::ShowNInfo(TEXT("Successfully scattered ") +
+			FString::FromInt(ScatterPoints.Num()) + TEXT(" copies"));
+	}
+	else
+	{
+		DebugHeader::ShowNInfo(TEXT("No free space found to scatter in"));
+	}
+}
+
+void UQuickActorActionsWidget::MergeActorsIntoInstances()
+{
+	if (!GetEditorActorSubsystem()) return;
+	TArray<AActor*> SelectedActors = EditorActorSubsystem->GetSelectedLevelActors();
+	if (SelectedActors.Num() == 0)
+	{
+		DebugHeader::ShowNInfo(TEXT("No actor selected"));
+		return;
+	}
+
+	TArray<AActor*> InstanceActors;
+	FInstanceMergeReport Report;
+	{
+		FScopedActorBatch ActorBatch(NSLOCTEXT("QuickActorActions", "MergeIntoInstances", "Merge Actors Into Instances"));
+		Report = FStaticMeshInstancer::MergeIntoInstances(SelectedActors, bMergeIntoHierarchicalInstances, InstanceActors);
+		for (AActor* InstanceActor : InstanceActors)
+		{
+			ActorBatch.AddSpawnedActor(InstanceActor);
+		}
+	}
+
+	if (Report.InstanceActors == 0)
+	{
+		DebugHeader::ShowNInfo(TEXT("No static mesh actor to merge"));
+		return;
+	}
+	DebugHeader::ShowMsgDialog(EAppMsgType::Ok, FString::Printf(
+		TEXT("Merged %d actors into %d instanced actors\nEstimated draw calls: %d -> %d\nSkipped %d actors that are not plain static mesh actors"),
+		Report.SourceActors, Report.InstanceActors, Report.DrawCallsBefore, Report.DrawCallsAfter, Report.SkippedActors), false);
+}
+
+void UQuickActorActionsWidget::SplitInstancesIntoActors()
+{
+	if (!GetEditorActorSubsystem()) return;
+	TArray<AActor*> SelectedActors = EditorActorSubsystem->GetSelectedLevelActors();
+	if (SelectedActors.Num() == 0)
+	{
+		DebugHeader::ShowNInfo(TEXT("No actor selected"));
+		return;
+	}
+
+	TArray<AActor*> SpawnedActors;
+	int32 Counter = 0;
+	{
+		FScopedActorBatch ActorBatch(NSLOCTEXT("QuickActorActions", "SplitInstances", "Split Instances Into Actors"));
+		Counter = FStaticMeshInstancer::SplitInstances(SelectedActors, SpawnedActors);
+		for (AActor* SpawnedActor : SpawnedActors)
+		{
+			ActorBatch.AddSpawnedActor(SpawnedActor, false);
+		}
+	}
+
+	if (Counter > 0)
+	{
+		DebugHeader::ShowNInfo(TEXT("Successfully split instances into ") +
+			FString::FromInt(Counter) + TEXT(" actors"));
+	}
+	else
+	{
+		DebugHeader::ShowNInfo(TEXT("No merged instance actor selected"));
+	}
 }
 
 void UQuickActorActionsWidget::RandomizeActorTransform()
@@ -139,36 +503,20 @@ void UQuickActorActionsWidget::RandomizeActorTransform()
 		DebugHeader::ShowNInfo(TEXT("No actor selected"));
 		return;
 	}
-	for (AActor* SelectedActor : SelectedActors)
-	{
-		if (!SelectedActor) continue;
-		if (RandomActorRotation.bRandomizeRotYaw)
-		{
-			const float RandomRotYawValue = FMath::RandRange(RandomActorRotation.RotYawMin, RandomActorRotation.RotYawMax);
+	SelectedActors.RemoveAll([](const AActor* SelectedActor) { return SelectedActor == nullptr; });
 
-			SelectedActor->AddActorWorldRotation(FRotator(0.f, RandomRotYawValue, 0.f));
-		}
-		if (RandomActorRotation.bRandomizeRotPitch)
-		{
-			const float RandomRotPitchValue = FMath::RandRange(RandomActorRotation.RotPitchMin, RandomActorRotation.RotPitchMax);
-			SelectedActor->AddActorWorldRotation(FRotator(RandomRotPitchValue, 0.f, 0.f));
-		}
-		if (RandomActorRotation.bRandomizeRotRoll)
-		{
-			const float RandomRotRollValue = FMath::RandRange(RandomActorRotation.RotRollMin, RandomActorRotation.RotRollMax);
-			SelectedActor->AddActorWorldRotation(FRotator(0.f, 0.f, RandomRotRollValue));
-		}
-		if (bRandomizeScale)
-		{
-			SelectedActor->SetActorScale3D(FVector(FMath::RandRange(ScaleMin, ScaleMax)));
-		}
-		if (bRandomizeOffset)
+	TArray<FTransform> ActorTransforms;
+	MakeRandomTransforms(SelectedActors, ActorTransforms);
+
+	{
+		FScopedActorBatch ActorBatch(NSLOCTEXT("QuickActorActions", "RandomizeTransform", "Randomize Actor Transform"));
+		for (int32 ActorIndex = 0; ActorIndex < SelectedActors.Num(); ++ActorIndex)
 		{
-			const float RandomOffsetValue = FMath::RandRange(OffsetMin, OffsetMax);
-			SelectedActor->AddActorWorldOffset(FVector(RandomOffsetValue, RandomOffsetValue, 0.f));
+			ActorBatch.SetActorTransform(SelectedActors[ActorIndex], ActorTransforms[ActorIndex]);
+			Counter++;
 		}
-		Counter++;
 	}
+
 	if (Counter > 0)
 	{
 		DebugHeader::ShowNInfo(TEXT("Successfully set ") +
@@ -184,4 +532,262 @@ bool UQuickActorActionsWidget::GetEditorActorSubsystem()
 	}
 
 	return EditorActorSubsystem != nullptr;
-}
\ No newline at end of file
+}
+
+//Candidates come from the label index so a query doesn't walk every level actor
+void UQuickActorActionsWidget::FindSimilarActors(AActor* ReferenceActor, TArray<AActor*>& OutSimilarActors) const
+{
+	UWorld* World = ReferenceActor->GetWorld();
+	const FString ReferenceLabel = ReferenceActor->GetActorLabel();
+	FActorLabelIndex& LabelIndex = FActorLabelIndex::Get();
+
+	switch (SimilarActorMatch)
+	{
+	case E_SimilarActorMatch::ESAM_NameStem:
+	{
+		const FString Stem = FActorLabelIndex::MakeStem(ReferenceLabel);
+		LabelIndex.FindActorsWithStem(World, Stem, OutSimilarActors);
+		//Buckets ignore case, the stem is a prefix of every label in it
+		if (SearchCase == ESearchCase::CaseSensitive)
+		{
+			const FString CasedStem = ReferenceLabel.Left(Stem.Len());
+			OutSimilarActors.RemoveAllSwap([&CasedStem](const AActor* Actor)
+				{
+					return !Actor->GetActorLabel().StartsWith(CasedStem, ESearchCase::CaseSensitive);
+				});
+		}
+		break;
+	}
+	case E_SimilarActorMatch::ESAM_Regex:
+	{
+		FString Pattern = SimilarNamePattern;
+		if (Pattern.IsEmpty())
+		{
+			//The stem as written in the selected label, escaped so it matches literally
+			const FString CasedStem = ReferenceLabel.Left(FActorLabelIndex::MakeStem(ReferenceLabel).Len());
+			for (const TCHAR StemChar : CasedStem)
+			{
+				if (FCString::Strchr(TEXT("\\^$.|?*+()[]{}"), StemChar)) Pattern.AppendChar(TEXT('\\'));
+				Pattern.AppendChar(StemChar);
+			}
+		}
+		const FRegexPattern RegexPattern(Pattern, SearchCase == ESearchCase::IgnoreCase ?
+			ERegexPatternFlags::CaseInsensitive : ERegexPatternFlags::None);
+		LabelIndex.ForEachActor(World, [&RegexPattern, &OutSimilarActors](AActor* Actor)
+			{
+				FRegexMatcher RegexMatcher(RegexPattern, Actor->GetActorLabel());
+				if (RegexMatcher.FindNext()) OutSimilarActors.Add(Actor);
+			});
+		break;
+	}
+	case E_SimilarActorMatch::ESAM_SameClass:
+	{
+		const UClass* ReferenceClass = ReferenceActor->GetClass();
+		LabelIndex.ForEachActor(World, [ReferenceClass, &OutSimilarActors](AActor* Actor)
+			{
+				if (Actor->GetClass() == ReferenceClass) OutSimilarActors.Add(Actor);
+			});
+		break;
+	}
+	case E_SimilarActorMatch::ESAM_SameMesh:
+	{
+		const UStaticMeshComponent* ReferenceComponent = ReferenceActor->FindComponentByClass<UStaticMeshComponent>();
+		const UStaticMesh* ReferenceMesh = ReferenceComponent ? ReferenceComponent->GetStaticMesh() : nullptr;
+		if (!ReferenceMesh) break;
+		LabelIndex.ForEachActor(World, [ReferenceMesh, &OutSimilarActors](AActor* Actor)
+			{
+				const UStaticMeshComponent* MeshComponent = Actor->FindComponentByClass<UStaticMeshComponent>();
+				if (MeshComponent && MeshComponent->GetStaticMesh() == ReferenceMesh) OutSimilarActors.Add(Actor);
+			});
+		break;
+	}
+	default:
+		break;
+	}
+}
+
+AActor* UQuickActorActionsWidget::GetSpatialQueryReferenceActor()
+{
+	if (!GetEditorActorSubsystem()) return nullptr;
+	TArray<AActor*> SelectedActors = EditorActorSubsystem->GetSelectedLevelActors();
+	if (SelectedActors.Num() == 0)
+	{
+		DebugHeader::ShowNInfo(TEXT("No actor selected"));
+		return nullptr;
+	}
+	if (SelectedActors.Num() > 1)
+	{
+		DebugHeader::ShowNInfo(TEXT("You can only select one actor"));
+		return nullptr;
+	}
+	return SelectedActors[0];
+}
+
+bool UQuickActorActionsWidget::PassesSpatialQueryClass(const AActor* Actor) const
+{
+	return !SpatialQueryClass || Actor->IsA(SpatialQueryClass);
+}
+
+void UQuickActorActionsWidget::ApplySpatialQueryResult(AActor* ReferenceActor, const TArray<AActor*>& FoundActors, double QueryStartTime)
+{
+	UE_LOG(LogSuperManagerActorActions, Verbose, TEXT("Spatial query around %s found %d actors in %.1f us"),
+		*ReferenceActor->GetActorLabel(), FoundActors.Num(), (FPlatformTime::Seconds() - QueryStartTime) * 1e6);
+	if (FoundActors.Num() == 0)
+	{
+		DebugHeader::ShowNInfo(TEXT("No actor found"));
+		return;
+	}
+
+	uint32 SelectionCounter = 0;
+	{
+		FScopedActorBatch ActorBatch(NSLOCTEXT("QuickActorActions", "SpatialSelection", "Spatial Selection"));
+		ActorBatch.DeselectAll();
+		for (AActor* FoundActor : FoundActors)
+		{
+			ActorBatch.SelectActor(FoundActor);
+		}
+		SelectionCounter = ActorBatch.NumSelectedActors();
+	}
+	DebugHeader::ShowNInfo(TEXT("Successfully selected ") +
+		FString::FromInt(SelectionCounter) + TEXT(" actors"));
+}
+
+//Applies the same steps as the old per-call version: yaw, pitch and roll in world space, then scale and offset
+//Seeds come from actor names so the result doesn't depend on selection order or thread scheduling.
+//The name string is hashed, an FName hash is its name table index and changes between editor sessions
+void UQuickActorActionsWidget::MakeRandomTransforms(const TArray<AActor*>& Actors, TArray<FTransform>& OutTransforms,
+	EParallelForFlags ParallelForFlags) const
+{
+	TArray<int32> ActorSeeds;
+	OutTransforms.SetNumUninitialized(Actors.Num());
+	ActorSeeds.SetNumUninitialized(Actors.Num());
+	for (int32 ActorIndex = 0; ActorIndex < Actors.Num(); ++ActorIndex)
+	{
+		OutTransforms[ActorIndex] = Actors[ActorIndex]->GetActorTransform();
+		ActorSeeds[ActorIndex] = static_cast<int32>(HashCombine(GetTypeHash(RandomSeed),
+			FCrc::StrCrc32(*Actors[ActorIndex]->GetName())));
+	}
+
+	ParallelFor(OutTransforms.Num(), [this, &OutTransforms, &ActorSeeds](int32 ActorIndex)
+		{
+			OutTransforms[ActorIndex] = MakeRandomTransform(OutTransforms[ActorIndex], ActorSeeds[ActorIndex]);
+		}, ParallelForFlags);
+}
+
+FTransform UQuickActorActionsWidget::MakeRandomTransform(const FTransform& CurrentTransform, int32 ActorSeed) const
+{
+	FRandomStream RandomStream(ActorSeed);
+	FTransform RandomTransform = CurrentTransform;
+	FQuat Rotation = CurrentTransform.GetRotation();
+	if (RandomActorRotation.bRandomizeRotYaw)
+	{
+		const float RandomRotYawValue = RandomStream.FRandRange(RandomActorRotation.RotYawMin, RandomActorRotation.RotYawMax);
+		Rotation = FRotator(0.f, RandomRotYawValue, 0.f).Quaternion() * Rotation;
+	}
+	if (RandomActorRotation.bRandomizeRotPitch)
+	{
+		const float RandomRotPitchValue = RandomStream.FRandRange(RandomActorRotation.RotPitchMin, RandomActorRotation.RotPitchMax);
+		Rotation = FRotator(RandomRotPitchValue, 0.f, 0.f).Quaternion() * Rotation;
+	}
+	if (RandomActorRotation.bRandomizeRotRoll)
+	{
+		const float RandomRotRollValue = RandomStream.FRandRange(RandomActorRotation.RotRollMin, RandomActorRotation.RotRollMax);
+		Rotation = FRotator(0.f, 0.f, RandomRotRollValue).Quaternion() * Rotation;
+	}
+	RandomTransform.SetRotation(Rotation);
+	if (bRandomizeScale)
+	{
+		RandomTransform.SetScale3D(FVector(RandomStream.FRandRange(ScaleMin, ScaleMax)));
+	}
+	if (bRandomizeOffset)
+	{
+		//Independent X and Y offsets
+		const float RandomOffsetX = RandomStream.FRandRange(OffsetMin, OffsetMax);
+		const float RandomOffsetY = RandomStream.FRandRange(OffsetMin, OffsetMax);
+		RandomTransform.AddToTranslation(FVector(RandomOffsetX, RandomOffsetY, 0.f));
+	}
+	return RandomTransform;
+}
+
+bool UQuickActorActionsWidget::ComputeDuplicationOffset(int32 DuplicateIndex, float CosTheta, float SinTheta, FVector& OutOffset) const
+{
+	const float DuplicationOffsetDist = (DuplicateIndex + 1) * OffsetDist;
+	switch (AxisForDuplication)
+	{
+	case E_DuplicationAxis::EDA_XAxis:
+		// Rotate around Z axis in XY plane
+		OutOffset = FVector(
+			DuplicationOffsetDist * CosTheta,
+			DuplicationOffsetDist * SinTheta,
+			0.f);
+		return true;
+	case E_DuplicationAxis::EDA_YAxis:
+		// Rotate around Z axis in XY plane, but starting from Y axis
+		OutOffset = FVector(
+			-DuplicationOffsetDist * SinTheta,
+			DuplicationOffsetDist * CosTheta,
+			0.f);
+		return true;
+	case E_DuplicationAxis::EDA_ZAxis:
+		// Rotate around Y axis in XZ plane
+		OutOffset = FVector(
+			DuplicationOffsetDist * SinTheta,
+			0.f,
+			DuplicationOffsetDist * CosTheta);
+		return true;
+	default:
+		return false;
+	}
+}
+
+//One instanced actor per mesh, material and collision set, all copies added in one call
+int32 UQuickActorActionsWidget::DuplicateActorsAsInstances(const TArray<AActor*>& SourceActors, float CosTheta, float SinTheta,
+	FScopedActorBatch& ActorBatch, TArray<AActor*>& OutNonMeshActors)
+{
+	//Copies stay in the level of their sources
+	TMap<TPair<ULevel*, FStaticMeshInstanceKey>, TArray<UStaticMeshComponent*>> SourceComponentsByKey;
+	for (AActor* SourceActor : SourceActors)
+	{
+		if (UStaticMeshComponent* MeshComponent = FStaticMeshInstancer::FindSourceMeshComponent(SourceActor))
+		{
+			SourceComponentsByKey.FindOrAdd(TPair<ULevel*, FStaticMeshInstanceKey>(
+				SourceActor->GetLevel(), FStaticMeshInstanceKey::FromComponent(MeshComponent))).Add(MeshComponent);
+		}
+		else if (SourceActor)
+		{
+			OutNonMeshActors.Add(SourceActor);
+		}
+	}
+	if (SourceComponentsByKey.Num() == 0) return 0;
+
+	int32 InstanceCounter = 0;
+	for (const TPair<TPair<ULevel*, FStaticMeshInstanceKey>, TArray<UStaticMeshComponent*>>& SourceGroup : SourceComponentsByKey)
+	{
+		const UStaticMeshComponent* FirstComponent = SourceGroup.Value[0];
+		const FStaticMeshInstanceKey& Key = SourceGroup.Key.Value;
+		UInstancedStaticMeshComponent* InstanceComponent = FStaticMeshInstancer::SpawnInstanceActor(
+			SourceGroup.Key.Key, Key, FTransform(FirstComponent->GetComponentLocation()),
+			bUseHierarchicalInstances, Key.StaticMesh->GetName() + TEXT("_Instances"));
+		if (!InstanceComponent) continue;
+
+		TArray<FTransform> InstanceTransforms;
+		InstanceTransforms.Reserve(SourceGroup.Value.Num() * NumberOfDuplicates);
+		for (const UStaticMeshComponent* SourceComponent : SourceGroup.Value)
+		{
+			const FTransform SourceTransform = SourceComponent->GetComponentTransform();
+			for (int32 i = 0; i < NumberOfDuplicates; i++)
+			{
+				FVector OffsetVector;
+				if (!ComputeDuplicationOffset(i, CosTheta, SinTheta, OffsetVector)) continue;
+				FTransform InstanceTransform = SourceTransform;
+				InstanceTransform.AddToTranslation(OffsetVector);
+				InstanceTransforms.Add(InstanceTransform);
+			}
+		}
+		ActorBatch.SuspendRenderState(InstanceComponent->GetOwner());
+		InstanceComponent->AddInstances(InstanceTransforms, false, true);
+		ActorBatch.AddSpawnedActor(InstanceComponent->GetOwner());
+		InstanceCounter += InstanceTransforms.Num();
+	}
+	return InstanceCounter;
+}
@@ -0,0 +1,93 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ActorActions/ScopedActorBatch.h"
+#include "ActorActions/ActorActionsLog.h"
+#include "Editor.h"
+#include "Engine/Selection.h"
+#include "ComponentRecreateRenderStateContext.h"
+
+FScopedActorBatch::FScopedActorBatch(const FText& InSessionName)
+	: Transaction(InSessionName)
+	, SessionName(InSessionName.ToString())
+	, StartTime(FPlatformTime::Seconds())
+{
+}
+
+void FScopedActorBatch::ModifyActor(AActor* Actor)
+{
+	if (!Actor) return;
+	bool bAlreadyModified = false;
+	ModifiedActors.Add(Actor, &bAlreadyModified);
+	if (!bAlreadyModified) Actor->Modify();
+}
+
+void FScopedActorBatch::SetActorTransform(AActor* Actor, const FTransform& NewTransform)
+{
+	if (!Actor) return;
+	ModifyActor(Actor);
+	//Without a render state the move updates no scene proxy, it is recreated once at the new place
+	SuspendRenderState(Actor);
+	//Teleport skips the physics velocity update a sweep-free move would otherwise do
+	Actor->SetActorTransform(NewTransform, false, nullptr, ETeleportType::TeleportPhysics);
+	MovedActors.Add(Actor);
+}
+
+void FScopedActorBatch::SuspendRenderState(AActor* Actor)
+{
+	if (!Actor) return;
+	bool bAlreadySuspended = false;
+	SuspendedActors.Add(Actor, &bAlreadySuspended);
+	if (bAlreadySuspended) return;
+	Actor->ForEachComponent(false, [this](UActorComponent* Component)
+		{
+			if (Component->IsRenderStateCreated())
+			{
+				SuspendedRenderStates.Add(MakeUnique<FComponentRecreateRenderStateContext>(Component));
+			}
+		});
+}
+
+void FScopedActorBatch::AddSpawnedActor(AActor* Actor, bool bSelect)
+{
+	if (!Actor) return;
+	NumSpawnedActors++;
+	if (bSelect) SelectActor(Actor);
+}
+
+void FScopedActorBatch::SelectActor(AActor* Actor)
+{
+	//Locked actors would be deselected right away by the selection lock
+	if (!Actor || Actor->ActorHasTag(FName("Locked"))) return;
+	ActorsToSelect.Add(Actor);
+}
+
+FScopedActorBatch::~FScopedActorBatch()
+{
+	for (AActor* MovedActor : MovedActors)
+	{
+		MovedActor->PostEditMove(true);
+	}
+	//Components a construction script rerun replaced are unregistered and skipped
+	SuspendedRenderStates.Empty();
+
+	if (GEditor && (ActorsToSelect.Num() > 0 || bDeselectAll))
+	{
+		USelection* ActorSelection = GEditor->GetSelectedActors();
+		ActorSelection->Modify();
+		ActorSelection->BeginBatchSelectOperation();
+		if (bDeselectAll) GEditor->SelectNone(false, true, false);
+		for (AActor* ActorToSelect : ActorsToSelect)
+		{
+			GEditor->SelectActor(ActorToSelect, true, false, true);
+		}
+		ActorSelection->EndBatchSelectOperation(false);
+		GEditor->NoteSelectionChange();
+	}
+	if (GEditor) GEditor->RedrawLevelEditingViewports();
+
+	const int32 NumTouchedActors = FMath::Max3(ModifiedActors.Num() + NumSpawnedActors, ActorsToSelect.Num(), 1);
+	const double ElapsedSeconds = FPlatformTime::Seconds() - StartTime;
+	UE_LOG(LogSuperManagerActorActions, Verbose, TEXT("%s: %d modified, %d spawned, %d selected in %.3f seconds (%.2f us per actor)"),
+		*SessionName, ModifiedActors.Num(), NumSpawnedActors, ActorsToSelect.Num(), ElapsedSeconds,
+		ElapsedSeconds * 1e6 / NumTouchedActors);
+}
@@ -0,0 +1,78 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ActorActions/SplineBand.h"
+#include "Components/SplineComponent.h"
+
+void FSplineBand::Build(const USplineComponent* Spline, float InHalfWidth)
+{
+	SegmentPoints.Reset();
+	SegmentsByCell.Reset();
+	Bounds = FBox2D(ForceInit);
+	HalfWidth = FMath::Max(InHalfWidth, 0.f);
+	if (!Spline) return;
+
+	//Steps of a quarter of the width keep the chords close to the curve
+	const float SplineLength = Spline->GetSplineLength();
+	const float SampleStep = FMath::Clamp(InHalfWidth * 0.25f, 10.f, 200.f);
+	const int32 NumSteps = FMath::Max(1, FMath::CeilToInt32(SplineLength / SampleStep));
+	SegmentPoints.Reserve(NumSteps + 1);
+	for (int32 StepIndex = 0; StepIndex <= NumSteps; ++StepIndex)
+	{
+		const FVector SplineLocation = Spline->GetLocationAtDistanceAlongSpline(
+			SplineLength * StepIndex / NumSteps, ESplineCoordinateSpace::World);
+		SegmentPoints.Add(SplineLocation);
+		Bounds += FVector2D(SplineLocation);
+	}
+	Bounds = Bounds.ExpandBy(HalfWidth);
+
+	//Each segment goes in every cell its band overlaps, a query then reads a single cell
+	CellSize = FMath::Max(HalfWidth * 2.0, static_cast<double>(SampleStep));
+	for (int32 SegmentIndex = 0; SegmentIndex + 1 < SegmentPoints.Num(); ++SegmentIndex)
+	{
+		FBox2D SegmentBounds(ForceInit);
+		SegmentBounds += FVector2D(SegmentPoints[SegmentIndex]);
+		SegmentBounds += FVector2D(SegmentPoints[SegmentIndex + 1]);
+		SegmentBounds = SegmentBounds.ExpandBy(HalfWidth);
+		const FIntPoint MinCell = CellOf(SegmentBounds.Min);
+		const FIntPoint MaxCell = CellOf(SegmentBounds.Max);
+		for (int32 CellY = MinCell.Y; CellY <= MaxCell.Y; ++CellY)
+		{
+			for (int32 CellX = MinCell.X; CellX <= MaxCell.X; ++CellX)
+			{
+				SegmentsByCell.FindOrAdd(FIntPoint(CellX, CellY)).Add(SegmentIndex);
+			}
+		}
+	}
+}
+
+bool FSplineBand::FindClosestHeight(const FVector2D& Point, double& OutHeight) const
+{
+	const TArray<int32>* CellSegments = SegmentsByCell.Find(CellOf(Point));
+	if (!CellSegments) return false;
+
+	double ClosestDistanceSquared = FMath::Square(HalfWidth);
+	bool bInside = false;
+	for (const int32 SegmentIndex : *CellSegments)
+	{
+		const FVector& SegmentStart = SegmentPoints[SegmentIndex];
+		const FVector& SegmentEnd = SegmentPoints[SegmentIndex + 1];
+		const FVector2D Start2D(SegmentStart);
+		const FVector2D Direction2D = FVector2D(SegmentEnd) - Start2D;
+		const double LengthSquared = Direction2D.SizeSquared();
+		const double Alpha = LengthSquared > UE_DOUBLE_SMALL_NUMBER ?
+			FMath::Clamp(FVector2D::DotProduct(Point - Start2D, Direction2D) / LengthSquared, 0.0, 1.0) : 0.0;
+		const double DistanceSquared = FVector2D::DistSquared(Start2D + Direction2D * Alpha, Point);
+		if (DistanceSquared <= ClosestDistanceSquared)
+		{
+			ClosestDistanceSquared = DistanceSquared;
+			OutHeight = FMath::Lerp(SegmentStart.Z, SegmentEnd.Z, Alpha);
+			bInside = true;
+		}
+	}
+	return bInside;
+}
+
+FIntPoint FSplineBand::CellOf(const FVector2D& Point) const
+{
+	return FIntPoint(FMath::FloorToInt32(Point.X / CellSize), FMath::FloorToInt32(Point.Y / CellSize));
+}
@@ -0,0 +1,92 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ActorActions/StackedActorDetector.h"
+#include "ActorActions/StaticMeshInstancer.h"
+#include "Components/StaticMeshComponent.h"
+
+namespace
+{
+	struct FStackedCellKey
+	{
+		int32 ContentIndex = INDEX_NONE;
+		FIntVector Cell;
+
+		bool operator==(const FStackedCellKey& Other) const
+		{
+			return ContentIndex == Other.ContentIndex && Cell == Other.Cell;
+		}
+		friend uint32 GetTypeHash(const FStackedCellKey& Key)
+		{
+			return HashCombine(GetTypeHash(Key.ContentIndex), GetTypeHash(Key.Cell));
+		}
+	};
+}
+
+void FStackedActorDetector::FindStackedDuplicates(const TArray<AActor*>& Actors, TArray<AActor*>& OutDuplicates) const
+{
+	const double CellSize = FMath::Max(LocationTolerance, UE_KINDA_SMALL_NUMBER);
+	TMap<FStaticMeshInstanceKey, int32> ContentIndexByKey;
+	TMap<FStackedCellKey, TArray<int32, TInlineAllocator<2>>> ActorsByCell;
+	ActorsByCell.Reserve(Actors.Num());
+	TArray<FTransform> ActorTransforms;
+	ActorTransforms.Reserve(Actors.Num());
+
+	for (int32 ActorIndex = 0; ActorIndex < Actors.Num(); ++ActorIndex)
+	{
+		AActor* Actor = Actors[ActorIndex];
+		ActorTransforms.Add(Actor ? Actor->GetActorTransform() : FTransform::Identity);
+		//Mesh, materials and collision are all a plain static mesh actor draws, anything else is never touched
+		const UStaticMeshComponent* MeshComponent = FStaticMeshInstancer::FindSourceMeshComponent(Actor);
+		if (!MeshComponent) continue;
+
+		const FStaticMeshInstanceKey ContentKey = FStaticMeshInstanceKey::FromComponent(MeshComponent);
+		const int32* ExistingContentIndex = ContentIndexByKey.Find(ContentKey);
+		const int32 ContentIndex = ExistingContentIndex ? *ExistingContentIndex : ContentIndexByKey.Add(ContentKey, ContentIndexByKey.Num());
+
+		const FVector Location = ActorTransforms[ActorIndex].GetLocation();
+		const FIntVector Cell(
+			FMath::FloorToInt32(Location.X / CellSize),
+			FMath::FloorToInt32(Location.Y / CellSize),
+			FMath::FloorToInt32(Location.Z / CellSize));
+
+		//Near-coincident actors can straddle a cell border, so look one cell out in every direction
+		bool bIsStacked = false;
+		for (int32 OffsetX = -1; OffsetX <= 1 && !bIsStacked; ++OffsetX)
+		{
+			for (int32 OffsetY = -1; OffsetY <= 1 && !bIsStacked; ++OffsetY)
+			{
+				for (int32 OffsetZ = -1; OffsetZ <= 1 && !bIsStacked; ++OffsetZ)
+				{
+					const FStackedCellKey NeighbourKey{ ContentIndex, Cell + FIntVector(OffsetX, OffsetY, OffsetZ) };
+					const TArray<int32, TInlineAllocator<2>>* CellActors = ActorsByCell.Find(NeighbourKey);
+					if (!CellActors) continue;
+					for (const int32 OtherIndex : *CellActors)
+					{
+						if (AreTransformsCoincident(ActorTransforms[OtherIndex], ActorTransforms[ActorIndex]))
+						{
+							bIsStacked = true;
+							break;
+						}
+					}
+				}
+			}
+		}
+
+		if (bIsStacked)
+		{
+			OutDuplicates.Add(Actor);
+		}
+		else
+		{
+			//Only the first actor of a stack is kept as a reference, duplicates match against it
+			ActorsByCell.FindOrAdd(FStackedCellKey{ ContentIndex, Cell }).Add(ActorIndex);
+		}
+	}
+}
+
+bool FStackedActorDetector::AreTransformsCoincident(const FTransform& TransformA, const FTransform& TransformB) const
+{
+	return FVector::DistSquared(TransformA.GetLocation(), TransformB.GetLocation()) <= FMath::Square(LocationTolerance) &&
+		FMath::RadiansToDegrees(TransformA.GetRotation().AngularDistance(TransformB.GetRotation())) <= RotationToleranceDegrees &&
+		TransformA.GetScale3D().Equals(TransformB.GetScale3D(), ScaleTolerance);
+}
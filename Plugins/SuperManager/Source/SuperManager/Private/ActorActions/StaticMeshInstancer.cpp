@@ -0,0 +1,196 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ActorActions/StaticMeshInstancer.h"
+#include "Components/StaticMeshComponent.h"
+#include "Components/HierarchicalInstancedStaticMeshComponent.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "Engine/Level.h"
+#include "Engine/StaticMeshActor.h"
+#include "Editor.h"
+#include "Subsystems/EditorActorSubsystem.h"
+#include "Misc/ScopedSlowTask.h"
+
+FStaticMeshInstanceKey FStaticMeshInstanceKey::FromComponent(const UStaticMeshComponent* MeshComponent)
+{
+	FStaticMeshInstanceKey Key;
+	Key.StaticMesh = MeshComponent->GetStaticMesh();
+	Key.CollisionProfileName = MeshComponent->GetCollisionProfileName();
+	//Resolved materials so an override equal to the mesh default still groups with the default
+	const int32 NumMaterials = MeshComponent->GetNumMaterials();
+	Key.Materials.Reserve(NumMaterials);
+	for (int32 MaterialIndex = 0; MaterialIndex < NumMaterials; ++MaterialIndex)
+	{
+		Key.Materials.Add(MeshComponent->GetMaterial(MaterialIndex));
+	}
+	return Key;
+}
+
+UStaticMeshComponent* FStaticMeshInstancer::FindSourceMeshComponent(AActor* Actor)
+{
+	//Subclasses, Blueprint ones included, may carry logic or components an instance cannot keep
+	if (!Actor || Actor->GetClass() != AStaticMeshActor::StaticClass()) return nullptr;
+	UStaticMeshComponent* MeshComponent = CastChecked<AStaticMeshActor>(Actor)->GetStaticMeshComponent();
+	if (!MeshComponent || !MeshComponent->GetStaticMesh()) return nullptr;
+
+	//Components added to the placed actor count too, editor only helpers are not drawn in game
+	TInlineComponentArray<UPrimitiveComponent*> PrimitiveComponents(Actor);
+	for (const UPrimitiveComponent* PrimitiveComponent : PrimitiveComponents)
+	{
+		if (PrimitiveComponent != MeshComponent && !PrimitiveComponent->IsEditorOnly()) return nullptr;
+	}
+	return MeshComponent;
+}
+
+UInstancedStaticMeshComponent* FStaticMeshInstancer::SpawnInstanceActor(ULevel* Level, const FStaticMeshInstanceKey& Key,
+	const FTransform& ActorTransform, bool bHierarchical, const FString& ActorLabel)
+{
+	UWorld* World = Level ? Level->GetWorld() : nullptr;
+	if (!World || !Key.StaticMesh) return nullptr;
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.ObjectFlags |= RF_Transactional;
+	SpawnParams.OverrideLevel = Level;
+	AActor* InstanceActor = World->SpawnActor<AActor>(AActor::StaticClass(), ActorTransform, SpawnParams);
+	if (!InstanceActor) return nullptr;
+
+	UInstancedStaticMeshComponent* InstanceComponent = bHierarchical ?
+		NewObject<UHierarchicalInstancedStaticMeshComponent>(InstanceActor, TEXT("InstancedMesh"), RF_Transactional) :
+		NewObject<UInstancedStaticMeshComponent>(InstanceActor, TEXT("InstancedMesh"), RF_Transactional);
+
+	InstanceComponent->SetStaticMesh(Key.StaticMesh);
+	for (int32 MaterialIndex = 0; MaterialIndex < Key.Materials.Num(); ++MaterialIndex)
+	{
+		InstanceComponent->SetMaterial(MaterialIndex, Key.Materials[MaterialIndex]);
+	}
+	InstanceComponent->SetCollisionProfileName(Key.CollisionProfileName);
+
+	InstanceActor->SetRootComponent(InstanceComponent);
+	InstanceActor->AddInstanceComponent(InstanceComponent);
+	InstanceComponent->RegisterComponent();
+	InstanceActor->SetActorTransform(ActorTransform);
+	InstanceActor->SetActorLabel(ActorLabel);
+	return InstanceComponent;
+}
+
+FInstanceMergeReport FStaticMeshInstancer::MergeIntoInstances(const TArray<AActor*>& Actors, bool bHierarchical,
+	TArray<AActor*>& OutInstanceActors)
+{
+	FInstanceMergeReport Report;
+	UEditorActorSubsystem* EditorActorSubsystem = GEditor->GetEditorSubsystem<UEditorActorSubsystem>();
+	if (!EditorActorSubsystem) return Report;
+
+	//Sources in different sublevels stay apart, each group is spawned into the level it came from
+	TMap<TPair<ULevel*, FStaticMeshInstanceKey>, TArray<UStaticMeshComponent*>> SourceComponentsByKey;
+	TArray<AActor*> MergedActors;
+	MergedActors.Reserve(Actors.Num());
+	for (AActor* Actor : Actors)
+	{
+		UStaticMeshComponent* MeshComponent = FindSourceMeshComponent(Actor);
+		if (!MeshComponent)
+		{
+			Report.SkippedActors++;
+			continue;
+		}
+		SourceComponentsByKey.FindOrAdd(TPair<ULevel*, FStaticMeshInstanceKey>(
+			Actor->GetLevel(), FStaticMeshInstanceKey::FromComponent(MeshComponent))).Add(MeshComponent);
+		MergedActors.Add(Actor);
+		Report.DrawCallsBefore += MeshComponent->GetStaticMesh()->GetNumSections(0);
+	}
+	Report.SourceActors = MergedActors.Num();
+	if (SourceComponentsByKey.Num() == 0) return Report;
+
+	FScopedSlowTask SlowTask(SourceComponentsByKey.Num() + 1, FText::FromString(TEXT("Merging actors into instances")));
+	SlowTask.MakeDialog();
+	for (const TPair<TPair<ULevel*, FStaticMeshInstanceKey>, TArray<UStaticMeshComponent*>>& SourceGroup : SourceComponentsByKey)
+	{
+		const FStaticMeshInstanceKey& Key = SourceGroup.Key.Value;
+		SlowTask.EnterProgressFrame(1.f, FText::FromString(Key.StaticMesh->GetName()));
+
+		//Pivot in the middle of the group so the merged actor shows up where its instances are
+		FBox GroupBounds(ForceInit);
+		TArray<FTransform> InstanceTransforms;
+		InstanceTransforms.Reserve(SourceGroup.Value.Num());
+		for (const UStaticMeshComponent* SourceComponent : SourceGroup.Value)
+		{
+			InstanceTransforms.Add(SourceComponent->GetComponentTransform());
+			GroupBounds += SourceComponent->GetComponentLocation();
+		}
+
+		UInstancedStaticMeshComponent* InstanceComponent = SpawnInstanceActor(
+			SourceGroup.Key.Key, Key, FTransform(GroupBounds.GetCenter()),
+			bHierarchical, Key.StaticMesh->GetName() + TEXT("_Merged"));
+		if (!InstanceComponent) continue;
+
+		InstanceComponent->AddInstances(InstanceTransforms, false, true);
+		OutInstanceActors.Add(InstanceComponent->GetOwner());
+		Report.InstanceActors++;
+		Report.DrawCallsAfter += Key.StaticMesh->GetNumSections(0);
+	}
+
+	SlowTask.EnterProgressFrame(1.f, FText::FromString(TEXT("Removing merged actors")));
+	EditorActorSubsystem->DestroyActors(MergedActors);
+	return Report;
+}
+
+//Foliage, Blueprints and anything else holding instances also carry state that splitting would destroy
+bool FStaticMeshInstancer::IsInstanceActor(const AActor* Actor)
+{
+	if (!Actor || Actor->GetClass() != AActor::StaticClass()) return false;
+	const UInstancedStaticMeshComponent* InstanceComponent = Cast<UInstancedStaticMeshComponent>(Actor->GetRootComponent());
+	return InstanceComponent && Actor->GetComponents().Num() == 1;
+}
+
+int32 FStaticMeshInstancer::SplitInstances(const TArray<AActor*>& Actors, TArray<AActor*>& OutSpawnedActors)
+{
+	UEditorActorSubsystem* EditorActorSubsystem = GEditor->GetEditorSubsystem<UEditorActorSubsystem>();
+	if (!EditorActorSubsystem) return 0;
+
+	TArray<AActor*> SplitActors;
+	TArray<UInstancedStaticMeshComponent*> InstanceComponents;
+	for (AActor* Actor : Actors)
+	{
+		if (!IsInstanceActor(Actor)) continue;
+		InstanceComponents.Add(CastChecked<UInstancedStaticMeshComponent>(Actor->GetRootComponent()));
+		SplitActors.Add(Actor);
+	}
+	if (SplitActors.Num() == 0) return 0;
+
+	FScopedSlowTask SlowTask(InstanceComponents.Num() + 1, FText::FromString(TEXT("Splitting instances into actors")));
+	SlowTask.MakeDialog();
+	for (const UInstancedStaticMeshComponent* InstanceComponent : InstanceComponents)
+	{
+		SlowTask.EnterProgressFrame();
+		UStaticMesh* StaticMesh = InstanceComponent->GetStaticMesh();
+		if (!StaticMesh) continue;
+		const FStaticMeshInstanceKey Key = FStaticMeshInstanceKey::FromComponent(InstanceComponent);
+		UWorld* World = InstanceComponent->GetWorld();
+
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.ObjectFlags |= RF_Transactional;
+		SpawnParams.OverrideLevel = InstanceComponent->GetComponentLevel();
+		const int32 NumInstances = InstanceComponent->GetInstanceCount();
+		OutSpawnedActors.Reserve(OutSpawnedActors.Num() + NumInstances);
+		for (int32 InstanceIndex = 0; InstanceIndex < NumInstances; ++InstanceIndex)
+		{
+			FTransform InstanceTransform;
+			if (!InstanceComponent->GetInstanceTransform(InstanceIndex, InstanceTransform, true)) continue;
+
+			AStaticMeshActor* MeshActor = World->SpawnActor<AStaticMeshActor>(AStaticMeshActor::StaticClass(), InstanceTransform, SpawnParams);
+			if (!MeshActor) continue;
+			UStaticMeshComponent* MeshComponent = MeshActor->GetStaticMeshComponent();
+			MeshComponent->SetStaticMesh(StaticMesh);
+			for (int32 MaterialIndex = 0; MaterialIndex < Key.Materials.Num(); ++MaterialIndex)
+			{
+				MeshComponent->SetMaterial(MaterialIndex, Key.Materials[MaterialIndex]);
+			}
+			MeshComponent->SetCollisionProfileName(Key.CollisionProfileName);
+			MeshActor->SetActorLabel(StaticMesh->GetName());
+			OutSpawnedActors.Add(MeshActor);
+		}
+	}
+
+	SlowTask.EnterProgressFrame(1.f, FText::FromString(TEXT("Removing instanced actors")));
+	EditorActorSubsystem->DestroyActors(SplitActors);
+	return OutSpawnedActors.Num();
+}
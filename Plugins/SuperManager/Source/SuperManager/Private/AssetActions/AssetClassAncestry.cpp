@@ -0,0 +1,45 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AssetActions/AssetClassAncestry.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+
+void FAssetClassAncestry::Precompute(const TSet<FTopLevelAssetPath>& ClassPaths)
+{
+	for (const FTopLevelAssetPath& ClassPath : ClassPaths)
+	{
+		GetAncestry(ClassPath);
+	}
+}
+
+const TArray<FTopLevelAssetPath>& FAssetClassAncestry::GetAncestry(const FTopLevelAssetPath& ClassPath)
+{
+	if (const TArray<FTopLevelAssetPath>* CachedAncestry = AncestryTable.Find(ClassPath))
+	{
+		return *CachedAncestry;
+	}
+
+	TArray<FTopLevelAssetPath> Ancestry;
+	Ancestry.Add(ClassPath);
+	//Native classes are always in memory, blueprint classes come from the registry's cached inheritance map
+	if (const UClass* NativeClass = FindObject<UClass>(ClassPath))
+	{
+		for (const UClass* SuperClass = NativeClass->GetSuperClass(); SuperClass; SuperClass = SuperClass->GetSuperClass())
+		{
+			Ancestry.Add(SuperClass->GetClassPathName());
+		}
+	}
+	else
+	{
+		IAssetRegistry& AssetRegistry =
+			FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+		TArray<FTopLevelAssetPath> AncestorClassPaths;
+		AssetRegistry.GetAncestorClassNames(ClassPath, AncestorClassPaths);
+		Ancestry.Append(AncestorClassPaths);
+	}
+	return AncestryTable.Add(ClassPath, MoveTemp(Ancestry));
+}
+
+bool FAssetClassAncestry::IsChildOf(const FTopLevelAssetPath& ClassPath, const FTopLevelAssetPath& BaseClassPath)
+{
+	return GetAncestry(ClassPath).Contains(BaseClassPath);
+}
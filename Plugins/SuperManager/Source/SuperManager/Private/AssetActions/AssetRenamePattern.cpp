@@ -0,0 +1,291 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AssetActions/AssetRenamePattern.h"
+
+FAssetRenamePattern::FAssetRenamePattern(ERenamePatternMode InMode, const FString& InSearchPattern,
+	const FString& InReplacement)
+	: Mode(InMode)
+	, SearchPattern(InSearchPattern)
+	, Replacement(InReplacement)
+{
+	switch (Mode)
+	{
+	case ERenamePatternMode::ERPM_Regex:
+		CompiledPattern.Emplace(SearchPattern);
+		break;
+	case ERenamePatternMode::ERPM_Glob:
+		CompiledPattern.Emplace(GlobToRegex(SearchPattern));
+		break;
+	default:
+		break;
+	}
+	if (CompiledPattern.IsSet()) TokenizeReplacement(InReplacement);
+}
+
+bool FAssetRenamePattern::Apply(const FString& OldName, int32 Counter, FString& OutNewName) const
+{
+	OutNewName.Reset();
+	if (SearchPattern.IsEmpty()) return false;
+
+	if (!CompiledPattern.IsSet())
+	{
+		//Plain substring, every occurrence is replaced, ignoring case like the original Contains and Replace
+		int32 SearchFrom = 0;
+		bool bMatched = false;
+		while (true)
+		{
+			const int32 FoundIndex = OldName.Find(SearchPattern, ESearchCase::IgnoreCase, ESearchDir::FromStart, SearchFrom);
+			if (FoundIndex == INDEX_NONE) break;
+			OutNewName += OldName.Mid(SearchFrom, FoundIndex - SearchFrom);
+			OutNewName += Replacement;
+			SearchFrom = FoundIndex + SearchPattern.Len();
+			bMatched = true;
+		}
+		OutNewName += OldName.Mid(SearchFrom);
+		return bMatched;
+	}
+
+	FRegexMatcher Matcher(CompiledPattern.GetValue(), OldName);
+	int32 LastMatchEnd = 0;
+	bool bMatched = false;
+	while (Matcher.FindNext())
+	{
+		const int32 MatchBeginning = Matcher.GetMatchBeginning();
+		const int32 MatchEnding = Matcher.GetMatchEnding();
+		OutNewName += OldName.Mid(LastMatchEnd, MatchBeginning - LastMatchEnd);
+		OutNewName += ExpandReplacement(&Matcher, OldName.Mid(MatchBeginning, MatchEnding - MatchBeginning), Counter);
+		LastMatchEnd = MatchEnding;
+		bMatched = true;
+		//After a zero length match such as ^ or x* the matcher resumes one character further on its own
+	}
+	OutNewName += OldName.Mid(LastMatchEnd);
+	return bMatched;
+}
+
+bool FAssetRenamePattern::IsValid(FString& OutError) const
+{
+	OutError.Reset();
+	if (SearchPattern.IsEmpty())
+	{
+		OutError = TEXT("The search pattern is empty");
+		return false;
+	}
+	if (Mode != ERenamePatternMode::ERPM_Regex) return true;
+
+	int32 GroupDepth = 0;
+	bool bInCharacterClass = false;
+	//Whether a quantifier has something to repeat at this point
+	bool bCanQuantify = false;
+	for (int32 Index = 0; Index < SearchPattern.Len(); ++Index)
+	{
+		const TCHAR Character = SearchPattern[Index];
+		if (Character == TEXT('\\'))
+		{
+			if (++Index >= SearchPattern.Len())
+			{
+				OutError = TEXT("The pattern ends with an unfinished escape");
+				return false;
+			}
+			bCanQuantify = true;
+			continue;
+		}
+		if (bInCharacterClass)
+		{
+			if (Character == TEXT(']')) bInCharacterClass = false;
+			continue;
+		}
+		switch (Character)
+		{
+		case TEXT('['):
+			bInCharacterClass = true;
+			//A leading ] is part of the class
+			if (Index + 1 < SearchPattern.Len() && SearchPattern[Index + 1] == TEXT('^')) ++Index;
+			if (Index + 1 < SearchPattern.Len() && SearchPattern[Index + 1] == TEXT(']')) ++Index;
+			bCanQuantify = true;
+			break;
+		case TEXT('('):
+			++GroupDepth;
+			bCanQuantify = false;
+			//Group flags such as (?: and (?i) are not quantifiers
+			if (Index + 1 < SearchPattern.Len() && SearchPattern[Index + 1] == TEXT('?')) ++Index;
+			break;
+		case TEXT(')'):
+			if (--GroupDepth < 0)
+			{
+				OutError = FString::Printf(TEXT("Unmatched ) at position %d"), Index);
+				return false;
+			}
+			bCanQuantify = true;
+			break;
+		case TEXT('|'):
+		case TEXT('^'):
+			bCanQuantify = false;
+			break;
+		case TEXT('*'):
+		case TEXT('+'):
+		case TEXT('?'):
+		case TEXT('{'):
+			if (!bCanQuantify)
+			{
+				OutError = FString::Printf(TEXT("Nothing to repeat before %c at position %d"), Character, Index);
+				return false;
+			}
+			if (Character == TEXT('{'))
+			{
+				const int32 CloseIndex = SearchPattern.Find(TEXT("}"), ESearchCase::CaseSensitive, ESearchDir::FromStart, Index);
+				if (CloseIndex == INDEX_NONE)
+				{
+					OutError = FString::Printf(TEXT("Unclosed { at position %d"), Index);
+					return false;
+				}
+				Index = CloseIndex;
+			}
+			//Lazy and possessive suffixes follow a quantifier directly
+			if (Index + 1 < SearchPattern.Len() && (SearchPattern[Index + 1] == TEXT('?') || SearchPattern[Index + 1] == TEXT('+'))) ++Index;
+			bCanQuantify = false;
+			break;
+		default:
+			bCanQuantify = true;
+			break;
+		}
+	}
+	if (bInCharacterClass)
+	{
+		OutError = TEXT("Unclosed [");
+		return false;
+	}
+	if (GroupDepth > 0)
+	{
+		OutError = TEXT("Unclosed (");
+		return false;
+	}
+	return true;
+}
+
+FString FAssetRenamePattern::GlobToRegex(const FString& GlobPattern)
+{
+	FString RegexString = TEXT("^");
+	for (const TCHAR Character : GlobPattern)
+	{
+		if (Character == TEXT('*'))
+		{
+			RegexString += TEXT("(.*)");
+		}
+		else if (Character == TEXT('?'))
+		{
+			RegexString += TEXT("(.)");
+		}
+		else if (FChar::IsAlnum(Character) || Character == TEXT('_'))
+		{
+			RegexString.AppendChar(Character);
+		}
+		else
+		{
+			RegexString.AppendChar(TEXT('\\'));
+			RegexString.AppendChar(Character);
+		}
+	}
+	RegexString += TEXT("$");
+	return RegexString;
+}
+
+void FAssetRenamePattern::TokenizeReplacement(const FString& Replacement)
+{
+	ReplacementTokens.Empty();
+	auto AddLiteral = [this](TCHAR Character)
+		{
+			if (ReplacementTokens.Num() == 0 || ReplacementTokens.Last().Type != FReplacementToken::EType::Literal)
+			{
+				ReplacementTokens.AddDefaulted();
+			}
+			ReplacementTokens.Last().Literal.AppendChar(Character);
+		};
+	auto AddToken = [this](FReplacementToken::EType Type, int32 Value)
+		{
+			FReplacementToken& Token = ReplacementTokens.AddDefaulted_GetRef();
+			Token.Type = Type;
+			Token.Value = Value;
+		};
+
+	for (int32 Index = 0; Index < Replacement.Len(); ++Index)
+	{
+		const TCHAR Character = Replacement[Index];
+		const TCHAR NextCharacter = Index + 1 < Replacement.Len() ? Replacement[Index + 1] : TEXT('\0');
+		if (Character == TEXT('$') && FChar::IsDigit(NextCharacter))
+		{
+			AddToken(FReplacementToken::EType::Capture, NextCharacter - TEXT('0'));
+			++Index;
+		}
+		else if (Character == TEXT('$') && NextCharacter == TEXT('$'))
+		{
+			AddLiteral(TEXT('$'));
+			++Index;
+		}
+		else if (Character == TEXT('\\') && (NextCharacter == TEXT('U') || NextCharacter == TEXT('L') || NextCharacter == TEXT('E')))
+		{
+			AddToken(NextCharacter == TEXT('U') ? FReplacementToken::EType::UpperCase :
+				NextCharacter == TEXT('L') ? FReplacementToken::EType::LowerCase : FReplacementToken::EType::EndCase, 0);
+			++Index;
+		}
+		else if (Character == TEXT('{') && NextCharacter == TEXT('#'))
+		{
+			int32 CounterEnd = Index + 1;
+			while (CounterEnd < Replacement.Len() && Replacement[CounterEnd] == TEXT('#')) ++CounterEnd;
+			if (CounterEnd < Replacement.Len() && Replacement[CounterEnd] == TEXT('}'))
+			{
+				AddToken(FReplacementToken::EType::Counter, CounterEnd - Index - 1);
+				Index = CounterEnd;
+			}
+			else
+			{
+				AddLiteral(Character);
+			}
+		}
+		else
+		{
+			AddLiteral(Character);
+		}
+	}
+}
+
+FString FAssetRenamePattern::ExpandReplacement(const FRegexMatcher* Matcher, const FString& WholeMatch, int32 Counter) const
+{
+	FString Expanded;
+	FReplacementToken::EType CaseMode = FReplacementToken::EType::EndCase;
+	auto AppendWithCase = [&Expanded, &CaseMode](const FString& Text)
+		{
+			Expanded += CaseMode == FReplacementToken::EType::UpperCase ? Text.ToUpper() :
+				CaseMode == FReplacementToken::EType::LowerCase ? Text.ToLower() : Text;
+		};
+
+	for (const FReplacementToken& Token : ReplacementTokens)
+	{
+		switch (Token.Type)
+		{
+		case FReplacementToken::EType::Literal:
+			AppendWithCase(Token.Literal);
+			break;
+		case FReplacementToken::EType::Capture:
+			if (Token.Value == 0)
+			{
+				AppendWithCase(WholeMatch);
+			}
+			else if (Matcher && Matcher->GetCaptureGroupBeginning(Token.Value) != INDEX_NONE)
+			{
+				AppendWithCase(Matcher->GetCaptureGroup(Token.Value));
+			}
+			break;
+		case FReplacementToken::EType::Counter:
+		{
+			FString CounterString = FString::FromInt(Counter);
+			while (CounterString.Len() < Token.Value) CounterString.InsertAt(0, TEXT('0'));
+			Expanded += CounterString;
+			break;
+		}
+		default:
+			CaseMode = Token.Type;
+			break;
+		}
+	}
+	return Expanded;
+}
@@ -0,0 +1,216 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AssetActions/BatchAssetRenamer.h"
+#include "DebugHeader.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "AssetToolsModule.h"
+
+void FBatchAssetRenamer::AddRename(const FAssetData& AssetData, const FString& NewName)
+{
+	TSharedPtr<FAssetRenamePreviewRow> Row = MakeShared<FAssetRenamePreviewRow>();
+	Row->AssetData = AssetData;
+	Row->NewName = NewName;
+	Row->bCanRename = true;
+	Rows.Add(Row);
+	bCollisionsDetected = false;
+}
+
+int32 FBatchAssetRenamer::DetectCollisions()
+{
+	bCollisionsDetected = true;
+
+	//Every package that already lives in one of the target folders, gathered once
+	FARFilter Filter;
+	for (const TSharedPtr<FAssetRenamePreviewRow>& Row : Rows)
+	{
+		Filter.PackagePaths.AddUnique(Row->AssetData.PackagePath);
+	}
+	TArray<FAssetData> ExistingAssetsData;
+	if (Filter.PackagePaths.Num() > 0)
+	{
+		IAssetRegistry& AssetRegistry =
+			FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+		AssetRegistry.GetAssets(Filter, ExistingAssetsData);
+	}
+	TSet<FName> OccupiedPackageNames;
+	OccupiedPackageNames.Reserve(ExistingAssetsData.Num() + Rows.Num());
+	for (const FAssetData& ExistingAssetData : ExistingAssetsData)
+	{
+		OccupiedPackageNames.Add(ExistingAssetData.PackageName);
+	}
+
+	int32 CollisionCounter = 0;
+	TArray<FName> NewPackageNames;
+	NewPackageNames.Init(NAME_None, Rows.Num());
+	for (int32 RowIndex = 0; RowIndex < Rows.Num(); ++RowIndex)
+	{
+		const TSharedPtr<FAssetRenamePreviewRow>& Row = Rows[RowIndex];
+		Row->bCanRename = false;
+		FText InvalidReason;
+		if (Row->NewName.Equals(Row->AssetData.AssetName.ToString(), ESearchCase::CaseSensitive))
+		{
+			Row->Status = TEXT("Unchanged");
+			continue;
+		}
+		if (Row->NewName.IsEmpty() ||
+			!FName::IsValidXName(Row->NewName, INVALID_OBJECTNAME_CHARACTERS INVALID_LONGPACKAGE_CHARACTERS, &InvalidReason))
+		{
+			Row->Status = TEXT("Invalid name");
+			++CollisionCounter;
+			continue;
+		}
+
+		//Package names are case insensitive, so a case-only rename would collide with the asset itself
+		const FName NewPackageName(FPaths::Combine(Row->AssetData.PackagePath.ToString(), Row->NewName));
+		if (NewPackageName == Row->AssetData.PackageName)
+		{
+			Row->Status = TEXT("Case-only rename is not supported");
+			++CollisionCounter;
+			continue;
+		}
+		NewPackageNames[RowIndex] = NewPackageName;
+		//The source name is freed by the rename, so chains and swaps inside the batch are allowed
+		OccupiedPackageNames.Remove(Row->AssetData.PackageName);
+	}
+
+	TSet<FName> KeptSourceNames;
+	for (int32 RowIndex = 0; RowIndex < Rows.Num(); ++RowIndex)
+	{
+		if (NewPackageNames[RowIndex].IsNone()) continue;
+		const TSharedPtr<FAssetRenamePreviewRow>& Row = Rows[RowIndex];
+		bool bAlreadyOccupied = false;
+		OccupiedPackageNames.Add(NewPackageNames[RowIndex], &bAlreadyOccupied);
+		if (bAlreadyOccupied)
+		{
+			Row->Status = TEXT("Name collision");
+			++CollisionCounter;
+			KeptSourceNames.Add(Row->AssetData.PackageName);
+			continue;
+		}
+		Row->Status = TEXT("OK");
+		Row->bCanRename = true;
+	}
+
+	//A row that can not be renamed keeps its name, which blocks any row moving onto it, and so on down the chain
+	bool bKeptSourcesChanged = KeptSourceNames.Num() > 0;
+	while (bKeptSourcesChanged)
+	{
+		bKeptSourcesChanged = false;
+		for (int32 RowIndex = 0; RowIndex < Rows.Num(); ++RowIndex)
+		{
+			const TSharedPtr<FAssetRenamePreviewRow>& Row = Rows[RowIndex];
+			if (!Row->bCanRename || !KeptSourceNames.Contains(NewPackageNames[RowIndex])) continue;
+			Row->Status = TEXT("Name collision");
+			Row->bCanRename = false;
+			++CollisionCounter;
+			KeptSourceNames.Add(Row->AssetData.PackageName);
+			bKeptSourcesChanged = true;
+		}
+	}
+	return CollisionCounter;
+}
+
+int32 FBatchAssetRenamer::GetNumRenamable() const
+{
+	int32 RenamableCounter = 0;
+	for (const TSharedPtr<FAssetRenamePreviewRow>& Row : Rows)
+	{
+		if (Row->bCanRename) ++RenamableCounter;
+	}
+	return RenamableCounter;
+}
+
+void FBatchAssetRenamer::LogPreviewTable() const
+{
+	for (const TSharedPtr<FAssetRenamePreviewRow>& Row : Rows)
+	{
+		DebugHeader::PrtLog(FString::Printf(TEXT("%-48s -> %-48s %s"),
+			*Row->AssetData.AssetName.ToString(), *Row->NewName, *Row->Status));
+	}
+}
+
+int32 FBatchAssetRenamer::Submit()
+{
+	if (!bCollisionsDetected)
+	{
+		DetectCollisions();
+	}
+
+	FAssetToolsModule& AssetToolsModule =
+		FModuleManager::LoadModuleChecked<FAssetToolsModule>(TEXT("AssetTools"));
+
+	TSet<FName> TargetPackageNames;
+	for (const TSharedPtr<FAssetRenamePreviewRow>& Row : Rows)
+	{
+		if (Row->bCanRename) TargetPackageNames.Add(FName(FPaths::Combine(Row->AssetData.PackagePath.ToString(), Row->NewName)));
+	}
+
+	//Sources another row moves onto step aside to a temporary name first, its redirector is cleared before the final pass
+	TArray<FAssetRenameData> AssetsToMoveAside;
+	TArray<FSoftObjectPath> MovedAsideObjectPaths;
+	TMap<FAssetRenamePreviewRow*, FSoftObjectPath> CurrentObjectPaths;
+	for (const TSharedPtr<FAssetRenamePreviewRow>& Row : Rows)
+	{
+		if (!Row->bCanRename || !TargetPackageNames.Contains(Row->AssetData.PackageName)) continue;
+		FString TemporaryPackageName;
+		FString TemporaryAssetName;
+		AssetToolsModule.Get().CreateUniqueAssetName(FPaths::Combine(Row->AssetData.PackagePath.ToString(), Row->NewName),
+			TEXT("_Renaming"), TemporaryPackageName, TemporaryAssetName);
+		const FSoftObjectPath TemporaryObjectPath(TemporaryPackageName + TEXT(".") + TemporaryAssetName);
+		AssetsToMoveAside.Emplace(Row->AssetData.ToSoftObjectPath(), TemporaryObjectPath);
+		MovedAsideObjectPaths.Add(Row->AssetData.ToSoftObjectPath());
+		CurrentObjectPaths.Add(Row.Get(), TemporaryObjectPath);
+	}
+	if (AssetsToMoveAside.Num() > 0)
+	{
+		AssetToolsModule.Get().RenameAssets(AssetsToMoveAside);
+		FixUpRenamedRedirectors(MovedAsideObjectPaths);
+	}
+
+	TArray<FAssetRenameData> AssetsToRename;
+	TArray<FSoftObjectPath> OldObjectPaths;
+	TArray<FSoftObjectPath> NewObjectPaths;
+	for (const TSharedPtr<FAssetRenamePreviewRow>& Row : Rows)
+	{
+		if (!Row->bCanRename) continue;
+		const FString NewPackageName = FPaths::Combine(Row->AssetData.PackagePath.ToString(), Row->NewName);
+		const FSoftObjectPath NewObjectPath(NewPackageName + TEXT(".") + Row->NewName);
+		const FSoftObjectPath* MovedAsideObjectPath = CurrentObjectPaths.Find(Row.Get());
+		const FSoftObjectPath OldObjectPath = MovedAsideObjectPath ? *MovedAsideObjectPath : Row->AssetData.ToSoftObjectPath();
+		AssetsToRename.Emplace(OldObjectPath, NewObjectPath);
+		OldObjectPaths.Add(OldObjectPath);
+		NewObjectPaths.Add(NewObjectPath);
+	}
+	if (AssetsToRename.Num() == 0) return 0;
+
+	int32 RenamedCounter = AssetsToRename.Num();
+	if (!AssetToolsModule.Get().RenameAssets(AssetsToRename))
+	{
+		RenamedCounter = 0;
+		for (const FSoftObjectPath& NewObjectPath : NewObjectPaths)
+		{
+			if (NewObjectPath.ResolveObject()) ++RenamedCounter;
+		}
+	}
+
+	FixUpRenamedRedirectors(OldObjectPaths);
+	return RenamedCounter;
+}
+
+//Only the redirectors left behind by this batch are fixed, in one pass
+void FBatchAssetRenamer::FixUpRenamedRedirectors(const TArray<FSoftObjectPath>& OldObjectPaths)
+{
+	TArray<UObjectRedirector*> RedirectorsToFixArray;
+	for (const FSoftObjectPath& OldObjectPath : OldObjectPaths)
+	{
+		if (UObjectRedirector* RedirectorToFix = Cast<UObjectRedirector>(OldObjectPath.ResolveObject()))
+		{
+			RedirectorsToFixArray.Add(RedirectorToFix);
+		}
+	}
+	if (RedirectorsToFixArray.Num() == 0) return;
+
+	FAssetToolsModule& AssetToolsModule =
+		FModuleManager::LoadModuleChecked<FAssetToolsModule>(TEXT("AssetTools"));
+	AssetToolsModule.Get().FixupReferencers(RedirectorsToFixArray);
+}
@@ -0,0 +1,341 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AssetActions/MaterialGraphHasher.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Async/ParallelFor.h"
+#include "Materials/Material.h"
+#include "Materials/MaterialExpression.h"
+#include "Misc/ScopedSlowTask.h"
+#include "DebugHeader.h"
+#include "SuperManager.h"
+
+namespace
+{
+	void UpdateWithString(FSHA1& HashState, const FString& Text)
+	{
+		HashState.UpdateWithString(*Text, Text.Len());
+		HashState.Update(reinterpret_cast<const uint8*>(TEXT("\n")), sizeof(TCHAR));
+	}
+
+	void UpdateWithHash(FSHA1& HashState, const FSHAHash& Hash)
+	{
+		HashState.Update(Hash.Hash, sizeof(Hash.Hash));
+	}
+
+	//Connection target as the structural hash of the source node, so node order and names do not matter
+	void UpdateWithInput(FSHA1& HashState, const FExpressionInput* Input, const TMap<const UMaterialExpression*, int32>& IndexByExpression,
+		const TArray<FSHAHash>& NodeHashes)
+	{
+		const int32* SourceIndex = Input ? IndexByExpression.Find(Input->Expression) : nullptr;
+		if (!SourceIndex)
+		{
+			UpdateWithString(HashState, TEXT("-"));
+			return;
+		}
+		UpdateWithHash(HashState, NodeHashes[*SourceIndex]);
+		UpdateWithString(HashState, FString::Printf(TEXT("%d:%d%d%d%d%d"), Input->OutputIndex,
+			Input->Mask, Input->MaskR, Input->MaskG, Input->MaskB, Input->MaskA));
+	}
+
+	//FExpressionInput and the typed material inputs deriving from it
+	bool IsExpressionInputStruct(const UStruct* Struct)
+	{
+		static const FName ExpressionInputName(TEXT("ExpressionInput"));
+		for (; Struct; Struct = Struct->GetSuperStruct())
+		{
+			if (Struct->GetFName() == ExpressionInputName) return true;
+		}
+		return false;
+	}
+
+	//Connections or node references somewhere inside, exporting those as text would write material and node paths
+	bool HoldsGraphLinks(const FProperty* Property)
+	{
+		if (const FObjectPropertyBase* ObjectProperty = CastField<FObjectPropertyBase>(Property))
+		{
+			return ObjectProperty->PropertyClass && ObjectProperty->PropertyClass->IsChildOf(UMaterialExpression::StaticClass());
+		}
+		if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+		{
+			return HoldsGraphLinks(ArrayProperty->Inner);
+		}
+		if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+		{
+			if (IsExpressionInputStruct(StructProperty->Struct)) return true;
+			for (TFieldIterator<FProperty> FieldIt(StructProperty->Struct); FieldIt; ++FieldIt)
+			{
+				if (HoldsGraphLinks(*FieldIt)) return true;
+			}
+		}
+		return false;
+	}
+
+	//Connections are left out, they are hashed through GetInput; node references are written as @ and listed
+	void DescribeValue(const FProperty* Property, const void* Value, FString& OutDescription, TArray<const UObject*>& OutReferences)
+	{
+		if (!HoldsGraphLinks(Property))
+		{
+			Property->ExportTextItem_Direct(OutDescription, Value, nullptr, nullptr, PPF_None);
+			return;
+		}
+		if (const FObjectPropertyBase* ObjectProperty = CastField<FObjectPropertyBase>(Property))
+		{
+			OutDescription += TEXT("@");
+			OutReferences.Add(ObjectProperty->GetObjectPropertyValue(Value));
+			return;
+		}
+		if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+		{
+			FScriptArrayHelper ArrayHelper(ArrayProperty, Value);
+			OutDescription += TEXT("(");
+			for (int32 ElementIndex = 0; ElementIndex < ArrayHelper.Num(); ++ElementIndex)
+			{
+				DescribeValue(ArrayProperty->Inner, ArrayHelper.GetRawPtr(ElementIndex), OutDescription, OutReferences);
+				OutDescription += TEXT(",");
+			}
+			OutDescription += TEXT(")");
+			return;
+		}
+		const FStructProperty* StructProperty = CastFieldChecked<FStructProperty>(Property);
+		if (IsExpressionInputStruct(StructProperty->Struct))
+		{
+			OutDescription += TEXT("<input>");
+			return;
+		}
+		OutDescription += TEXT("(");
+		for (TFieldIterator<FProperty> FieldIt(StructProperty->Struct); FieldIt; ++FieldIt)
+		{
+			OutDescription += FieldIt->GetName() + TEXT("=");
+			DescribeValue(*FieldIt, FieldIt->ContainerPtrToValuePtr<void>(Value), OutDescription, OutReferences);
+			OutDescription += TEXT(" ");
+		}
+		OutDescription += TEXT(")");
+	}
+}
+
+//Every edited setting declared by the node class, base class members are layout and editor state
+void FMaterialGraphHasher::DescribeExpressionSettings(const UMaterialExpression* Expression, FString& OutDescription,
+	TArray<const UObject*>& OutReferences)
+{
+	OutDescription = Expression->GetClass()->GetPathName();
+	for (TFieldIterator<FProperty> PropertyIt(Expression->GetClass()); PropertyIt; ++PropertyIt)
+	{
+		const FProperty* Property = *PropertyIt;
+		if (Property->GetOwnerClass() == UMaterialExpression::StaticClass()) continue;
+		if (Property->HasAnyPropertyFlags(CPF_Transient)) continue;
+		const FStructProperty* StructProperty = CastField<FStructProperty>(Property);
+		if (StructProperty && StructProperty->Struct == TBaseStructure<FGuid>::Get()) continue;
+		static const TSet<FName> EditorOnlyNames = { TEXT("Group"), TEXT("SortPriority") };
+		if (EditorOnlyNames.Contains(Property->GetFName())) continue;
+
+		OutDescription += TEXT(" ") + Property->GetName() + TEXT("=");
+		DescribeValue(Property, Property->ContainerPtrToValuePtr<void>(Expression), OutDescription, OutReferences);
+	}
+}
+
+//Material level settings that change the shader, stricter than needed rather than merging different shaders
+void FMaterialGraphHasher::AppendMaterialSettings(const UMaterial* Material, FSHA1& HashState)
+{
+	for (TFieldIterator<FProperty> PropertyIt(UMaterial::StaticClass(), EFieldIteratorFlags::ExcludeSuper); PropertyIt; ++PropertyIt)
+	{
+		const FProperty* Property = *PropertyIt;
+		if (!Property->HasAnyPropertyFlags(CPF_Edit) || Property->HasAnyPropertyFlags(CPF_Transient)) continue;
+		if (Property->IsA<FObjectPropertyBase>()) continue;
+		const FStructProperty* StructProperty = CastField<FStructProperty>(Property);
+		if (StructProperty && StructProperty->Struct == TBaseStructure<FGuid>::Get()) continue;
+
+		FString PropertyText;
+		Property->ExportTextItem_Direct(PropertyText, Property->ContainerPtrToValuePtr<void>(Material), nullptr, nullptr, PPF_None);
+		UpdateWithString(HashState, Property->GetName() + TEXT("=") + PropertyText);
+	}
+}
+
+bool FMaterialGraphHasher::ComputeStructuralHash(const UMaterial* Material, FSHAHash& OutHash)
+{
+	const TConstArrayView<TObjectPtr<UMaterialExpression>> Expressions = Material->GetExpressions();
+	TMap<const UMaterialExpression*, int32> IndexByExpression;
+	IndexByExpression.Reserve(Expressions.Num());
+	for (int32 Index = 0; Index < Expressions.Num(); ++Index)
+	{
+		if (Expressions[Index]) IndexByExpression.Add(Expressions[Index], Index);
+	}
+
+	//Kahn's algorithm, a node is hashed once all of its sources and the nodes it references are
+	TArray<FString> Descriptions;
+	Descriptions.SetNum(Expressions.Num());
+	TArray<TArray<const UObject*>> ReferencesByNode;
+	ReferencesByNode.SetNum(Expressions.Num());
+	TArray<TArray<int32>> ConsumersBySource;
+	ConsumersBySource.SetNum(Expressions.Num());
+	TArray<int32> PendingSourceCounts;
+	PendingSourceCounts.SetNumZeroed(Expressions.Num());
+	for (int32 Index = 0; Index < Expressions.Num(); ++Index)
+	{
+		if (!Expressions[Index]) continue;
+		for (int32 InputIndex = 0; const FExpressionInput* Input = Expressions[Index]->GetInput(InputIndex); ++InputIndex)
+		{
+			if (const int32* SourceIndex = IndexByExpression.Find(Input->Expression))
+			{
+				ConsumersBySource[*SourceIndex].Add(Index);
+				++PendingSourceCounts[Index];
+			}
+		}
+		DescribeExpressionSettings(Expressions[Index], Descriptions[Index], ReferencesByNode[Index]);
+		for (const UObject* Reference : ReferencesByNode[Index])
+		{
+			if (const int32* ReferencedIndex = IndexByExpression.Find(Cast<UMaterialExpression>(Reference)))
+			{
+				ConsumersBySource[*ReferencedIndex].Add(Index);
+				++PendingSourceCounts[Index];
+			}
+		}
+	}
+
+	TArray<int32> ReadyIndices;
+	for (int32 Index = 0; Index < Expressions.Num(); ++Index)
+	{
+		if (Expressions[Index] && PendingSourceCounts[Index] == 0) ReadyIndices.Add(Index);
+	}
+	TArray<FSHAHash> NodeHashes;
+	NodeHashes.SetNum(Expressions.Num());
+	int32 HashedCounter = 0;
+	while (ReadyIndices.Num() > 0)
+	{
+		const int32 Index = ReadyIndices.Pop(false);
+		const UMaterialExpression* Expression = Expressions[Index];
+		FSHA1 NodeHashState;
+		UpdateWithString(NodeHashState, Descriptions[Index]);
+		//Nodes of this graph by their hash like connections, anything outside it such as function internals by path
+		for (const UObject* Reference : ReferencesByNode[Index])
+		{
+			const int32* ReferencedIndex = IndexByExpression.Find(Cast<UMaterialExpression>(Reference));
+			if (ReferencedIndex) UpdateWithHash(NodeHashState, NodeHashes[*ReferencedIndex]);
+			else UpdateWithString(NodeHashState, Reference ? Reference->GetPathName() : TEXT("-"));
+		}
+		for (int32 InputIndex = 0; const FExpressionInput* Input = const_cast<UMaterialExpression*>(Expression)->GetInput(InputIndex); ++InputIndex)
+		{
+			UpdateWithInput(NodeHashState, Input, IndexByExpression, NodeHashes);
+		}
+		NodeHashState.Final();
+		NodeHashState.GetHash(NodeHashes[Index].Hash);
+		++HashedCounter;
+
+		for (const int32 ConsumerIndex : ConsumersBySource[Index])
+		{
+			if (--PendingSourceCounts[ConsumerIndex] == 0) ReadyIndices.Add(ConsumerIndex);
+		}
+	}
+	if (HashedCounter != IndexByExpression.Num()) return false;
+
+	//Only nodes reaching a material input end up in the hash
+	FSHA1 MaterialHashState;
+	AppendMaterialSettings(Material, MaterialHashState);
+	for (int32 PropertyIndex = 0; PropertyIndex < MP_MAX; ++PropertyIndex)
+	{
+		const FExpressionInput* MaterialInput =
+			const_cast<UMaterial*>(Material)->GetExpressionInputForProperty((EMaterialProperty)PropertyIndex);
+		if (!MaterialInput || !MaterialInput->Expression) continue;
+		UpdateWithString(MaterialHashState, FString::FromInt(PropertyIndex));
+		UpdateWithInput(MaterialHashState, MaterialInput, IndexByExpression, NodeHashes);
+	}
+	MaterialHashState.Final();
+	MaterialHashState.GetHash(OutHash.Hash);
+	return true;
+}
+
+int32 FMaterialGraphHasher::EstimatePermutations(const UMaterial* Material)
+{
+	int32 Permutations = 1;
+	for (int32 UsageIndex = 0; UsageIndex < MATUSAGE_MAX; ++UsageIndex)
+	{
+		if (Material->GetUsageByFlag((EMaterialUsage)UsageIndex)) ++Permutations;
+	}
+	return Permutations;
+}
+
+void FMaterialGraphHasher::Scan(const TArray<FString>& RootPaths, TArray<FMaterialShaderGroup>& OutGroups,
+	int32& OutNumMaterials) const
+{
+	OutGroups.Empty();
+	const double StartTime = FPlatformTime::Seconds();
+	IAssetRegistry& AssetRegistry =
+		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	FARFilter Filter;
+	for (const FString& RootPath : RootPaths)
+	{
+		Filter.PackagePaths.Add(FName(*RootPath));
+	}
+	Filter.bRecursivePaths = true;
+	Filter.ClassPaths.Add(UMaterial::StaticClass()->GetClassPathName());
+	TArray<FAssetData> MaterialsData;
+	AssetRegistry.GetAssets(Filter, MaterialsData);
+	MaterialsData.RemoveAll([](const FAssetData& MaterialData)
+		{
+			return FSuperManagerModule::IsPathExcludedFromScan(MaterialData.PackagePath.ToString());
+		});
+	OutNumMaterials = MaterialsData.Num();
+
+	TArray<FSHAHash> StructuralHashes;
+	StructuralHashes.SetNum(MaterialsData.Num());
+	TArray<int32> Permutations;
+	Permutations.SetNumZeroed(MaterialsData.Num());
+	{
+		const int32 NumBatches = FMath::DivideAndRoundUp(MaterialsData.Num(), FMath::Max(BatchSize, 1));
+		FScopedSlowTask HashTask(NumBatches, FText::FromString(TEXT("Hashing material graphs")));
+		HashTask.MakeDialog(true);
+		TArray<const UMaterial*> BatchMaterials;
+		for (int32 BatchStart = 0; BatchStart < MaterialsData.Num(); BatchStart += FMath::Max(BatchSize, 1))
+		{
+			HashTask.EnterProgressFrame();
+			if (HashTask.ShouldCancel()) break;
+
+			//Loading has to happen on the game thread, hashing only reads the loaded graphs
+			const int32 BatchEnd = FMath::Min(BatchStart + FMath::Max(BatchSize, 1), MaterialsData.Num());
+			BatchMaterials.Reset();
+			for (int32 Index = BatchStart; Index < BatchEnd; ++Index)
+			{
+				BatchMaterials.Add(Cast<UMaterial>(MaterialsData[Index].GetAsset()));
+			}
+			ParallelFor(BatchMaterials.Num(), [&BatchMaterials, &StructuralHashes, &Permutations, BatchStart](int32 BatchIndex)
+				{
+					const UMaterial* Material = BatchMaterials[BatchIndex];
+					if (!Material) return;
+					if (ComputeStructuralHash(Material, StructuralHashes[BatchStart + BatchIndex]))
+					{
+						Permutations[BatchStart + BatchIndex] = EstimatePermutations(Material);
+					}
+				});
+		}
+	}
+
+	TMap<FSHAHash, TArray<int32>> IndicesByHash;
+	for (int32 Index = 0; Index < MaterialsData.Num(); ++Index)
+	{
+		//Materials that failed to load or hash have no permutation estimate
+		if (Permutations[Index] == 0) continue;
+		IndicesByHash.FindOrAdd(StructuralHashes[Index]).Add(Index);
+	}
+	for (const TPair<FSHAHash, TArray<int32>>& HashIndices : IndicesByHash)
+	{
+		if (HashIndices.Value.Num() < 2) continue;
+		FMaterialShaderGroup& Group = OutGroups.AddDefaulted_GetRef();
+		Group.StructuralHash = HashIndices.Key;
+		Group.PermutationsPerMaterial = Permutations[HashIndices.Value[0]];
+		for (const int32 Index : HashIndices.Value)
+		{
+			Group.Materials.Add(MaterialsData[Index]);
+		}
+		Group.Materials.Sort([](const FAssetData& A, const FAssetData& B)
+			{
+				return A.PackageName.LexicalLess(B.PackageName);
+			});
+	}
+	OutGroups.Sort([](const FMaterialShaderGroup& A, const FMaterialShaderGroup& B)
+		{
+			return A.GetSavedPermutations() > B.GetSavedPermutations();
+		});
+
+	DebugHeader::PrtLog(FString::Printf(TEXT("Hashed %d material graphs, found %d groups of identical shaders in %.3f seconds"),
+		MaterialsData.Num(), OutGroups.Num(), FPlatformTime::Seconds() - StartTime));
+}
@@ -0,0 +1,286 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AssetActions/MaterialInstanceDeduplicator.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Async/ParallelFor.h"
+#include "Materials/MaterialInstanceConstant.h"
+#include "Materials/Material.h"
+#include "Misc/ScopedSlowTask.h"
+#include "ObjectTools.h"
+#include "FileHelpers.h"
+#include "DebugHeader.h"
+#include "SuperManager.h"
+
+TMap<FName, FMaterialInstanceDeduplicator::FCachedFingerprint> FMaterialInstanceDeduplicator::FingerprintCache;
+
+namespace
+{
+	FString ParameterInfoToString(const FMaterialParameterInfo& ParameterInfo)
+	{
+		return FString::Printf(TEXT("%s:%d:%d"), *ParameterInfo.Name.ToString(), (int32)ParameterInfo.Association, ParameterInfo.Index);
+	}
+
+	//Exact bits, the text must not change with float formatting
+	FString FloatToString(float Value)
+	{
+		return FString::Printf(TEXT("%08x"), FMath::AsUInt(Value));
+	}
+
+	FString DoubleToString(double Value)
+	{
+		uint64 Bits = 0;
+		FMemory::Memcpy(&Bits, &Value, sizeof(Value));
+		return FString::Printf(TEXT("%016llx"), Bits);
+	}
+
+	FString ObjectToString(const UObject* Object)
+	{
+		return Object ? Object->GetPathName() : TEXT("None");
+	}
+
+	//One line per overridden parameter, sorted so the order parameters were set in does not matter
+	void AppendSortedLines(FString& OutDescription, const TCHAR* SectionName, TArray<FString>& Lines)
+	{
+		Lines.Sort();
+		OutDescription += SectionName;
+		OutDescription += TEXT("\n");
+		for (const FString& Line : Lines)
+		{
+			OutDescription += Line;
+			OutDescription += TEXT("\n");
+		}
+	}
+}
+
+FString FMaterialInstanceDeduplicator::BuildCanonicalDescription(const UMaterialInstanceConstant* MaterialInstance)
+{
+	FString Description = TEXT("Parents\n");
+	for (const UMaterialInterface* Parent = MaterialInstance->Parent; Parent; )
+	{
+		Description += Parent->GetPathName() + TEXT("\n");
+		const UMaterialInstance* ParentInstance = Cast<UMaterialInstance>(Parent);
+		Parent = ParentInstance ? ParentInstance->Parent : nullptr;
+	}
+
+	FStaticParameterSet StaticParameters;
+	MaterialInstance->GetStaticParameterValues(StaticParameters);
+	TArray<FString> Lines;
+	for (const FStaticSwitchParameter& SwitchParameter : StaticParameters.StaticSwitchParameters)
+	{
+		if (!SwitchParameter.bOverride) continue;
+		Lines.Add(ParameterInfoToString(SwitchParameter.ParameterInfo) + (SwitchParameter.Value ? TEXT("=1") : TEXT("=0")));
+	}
+	for (const FStaticComponentMaskParameter& MaskParameter : StaticParameters.EditorOnly.StaticComponentMaskParameters)
+	{
+		if (!MaskParameter.bOverride) continue;
+		Lines.Add(ParameterInfoToString(MaskParameter.ParameterInfo) + FString::Printf(TEXT("=%d%d%d%d"),
+			MaskParameter.R, MaskParameter.G, MaskParameter.B, MaskParameter.A));
+	}
+	AppendSortedLines(Description, TEXT("StaticSwitches"), Lines);
+
+	Lines.Reset();
+	for (const FScalarParameterValue& ScalarValue : MaterialInstance->ScalarParameterValues)
+	{
+		Lines.Add(ParameterInfoToString(ScalarValue.ParameterInfo) + TEXT("=") + FloatToString(ScalarValue.ParameterValue));
+	}
+	AppendSortedLines(Description, TEXT("Scalars"), Lines);
+
+	Lines.Reset();
+	for (const FVectorParameterValue& VectorValue : MaterialInstance->VectorParameterValues)
+	{
+		const FLinearColor& Color = VectorValue.ParameterValue;
+		Lines.Add(ParameterInfoToString(VectorValue.ParameterInfo) + TEXT("=") + FloatToString(Color.R) +
+			FloatToString(Color.G) + FloatToString(Color.B) + FloatToString(Color.A));
+	}
+	for (const FDoubleVectorParameterValue& DoubleVectorValue : MaterialInstance->DoubleVectorParameterValues)
+	{
+		const FVector4d& Vector = DoubleVectorValue.ParameterValue;
+		Lines.Add(ParameterInfoToString(DoubleVectorValue.ParameterInfo) + TEXT("=") + DoubleToString(Vector.X) +
+			DoubleToString(Vector.Y) + DoubleToString(Vector.Z) + DoubleToString(Vector.W));
+	}
+	AppendSortedLines(Description, TEXT("Vectors"), Lines);
+
+	Lines.Reset();
+	for (const FTextureParameterValue& TextureValue : MaterialInstance->TextureParameterValues)
+	{
+		Lines.Add(ParameterInfoToString(TextureValue.ParameterInfo) + TEXT("=") + ObjectToString(TextureValue.ParameterValue));
+	}
+	for (const FRuntimeVirtualTextureParameterValue& VirtualTextureValue : MaterialInstance->RuntimeVirtualTextureParameterValues)
+	{
+		Lines.Add(ParameterInfoToString(VirtualTextureValue.ParameterInfo) + TEXT("=") + ObjectToString(VirtualTextureValue.ParameterValue));
+	}
+	for (const FFontParameterValue& FontValue : MaterialInstance->FontParameterValues)
+	{
+		Lines.Add(ParameterInfoToString(FontValue.ParameterInfo) + TEXT("=") + ObjectToString(FontValue.FontValue) +
+			FString::Printf(TEXT(":%d"), FontValue.FontPage));
+	}
+	AppendSortedLines(Description, TEXT("Textures"), Lines);
+
+	FString BasePropertyOverrides;
+	FMaterialInstanceBasePropertyOverrides::StaticStruct()->ExportText(BasePropertyOverrides,
+		&MaterialInstance->BasePropertyOverrides, nullptr, nullptr, PPF_None, nullptr);
+	Description += TEXT("BasePropertyOverrides\n") + BasePropertyOverrides + TEXT("\n");
+	return Description;
+}
+
+void FMaterialInstanceDeduplicator::Scan(const TArray<FString>& RootPaths, TArray<FMaterialInstanceCluster>& OutClusters)
+{
+	OutClusters.Empty();
+	const double StartTime = FPlatformTime::Seconds();
+	IAssetRegistry& AssetRegistry =
+		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	FARFilter Filter;
+	for (const FString& RootPath : RootPaths)
+	{
+		Filter.PackagePaths.Add(FName(*RootPath));
+	}
+	Filter.bRecursivePaths = true;
+	Filter.ClassPaths.Add(UMaterialInstanceConstant::StaticClass()->GetClassPathName());
+	TArray<FAssetData> InstancesData;
+	AssetRegistry.GetAssets(Filter, InstancesData);
+	InstancesData.RemoveAll([](const FAssetData& InstanceData)
+		{
+			return FSuperManagerModule::IsPathExcludedFromScan(InstanceData.PackagePath.ToString());
+		});
+
+	//Reuse fingerprints of packages unchanged since they were hashed, describe the rest on the game thread
+	TArray<FSHAHash> Fingerprints;
+	Fingerprints.SetNum(InstancesData.Num());
+	TArray<FString> Descriptions;
+	Descriptions.SetNum(InstancesData.Num());
+	TArray<FIoHash> SavedHashes;
+	SavedHashes.SetNum(InstancesData.Num());
+	TArray<int32> IndicesToHash;
+	{
+		FScopedSlowTask DescribeTask(InstancesData.Num(), FText::FromString(TEXT("Fingerprinting material instances")));
+		DescribeTask.MakeDialog();
+		for (int32 Index = 0; Index < InstancesData.Num(); ++Index)
+		{
+			DescribeTask.EnterProgressFrame();
+			const FAssetData& InstanceData = InstancesData[Index];
+			const UPackage* LoadedPackage = FindPackage(nullptr, *InstanceData.PackageName.ToString());
+			const bool bHasUnsavedChanges = LoadedPackage && LoadedPackage->IsDirty();
+			if (!bHasUnsavedChanges)
+			{
+				TOptional<FAssetPackageData> PackageData = AssetRegistry.GetAssetPackageDataCopy(InstanceData.PackageName);
+				if (PackageData.IsSet())
+				{
+					SavedHashes[Index] = PackageData->PackageSavedHash;
+				}
+				const FCachedFingerprint* CachedFingerprint = FingerprintCache.Find(InstanceData.PackageName);
+				if (CachedFingerprint && !SavedHashes[Index].IsZero() && CachedFingerprint->PackageSavedHash == SavedHashes[Index])
+				{
+					Fingerprints[Index] = CachedFingerprint->Fingerprint;
+					continue;
+				}
+			}
+
+			const UMaterialInstanceConstant* MaterialInstance = Cast<UMaterialInstanceConstant>(InstanceData.GetAsset());
+			if (!MaterialInstance) continue;
+			Descriptions[Index] = BuildCanonicalDescription(MaterialInstance);
+			IndicesToHash.Add(Index);
+		}
+	}
+
+	ParallelFor(IndicesToHash.Num(), [&IndicesToHash, &Descriptions, &Fingerprints](int32 HashIndex)
+		{
+			const int32 Index = IndicesToHash[HashIndex];
+			const FTCHARToUTF8 DescriptionUtf8(*Descriptions[Index]);
+			FSHA1::HashBuffer(DescriptionUtf8.Get(), DescriptionUtf8.Length(), Fingerprints[Index].Hash);
+		});
+
+	for (const int32 Index : IndicesToHash)
+	{
+		if (SavedHashes[Index].IsZero()) continue;
+		FingerprintCache.Add(InstancesData[Index].PackageName, { SavedHashes[Index], Fingerprints[Index] });
+	}
+
+	TMap<FSHAHash, TArray<int32>> IndicesByFingerprint;
+	for (int32 Index = 0; Index < InstancesData.Num(); ++Index)
+	{
+		if (Fingerprints[Index] == FSHAHash()) continue;
+		IndicesByFingerprint.FindOrAdd(Fingerprints[Index]).Add(Index);
+	}
+	for (const TPair<FSHAHash, TArray<int32>>& FingerprintIndices : IndicesByFingerprint)
+	{
+		if (FingerprintIndices.Value.Num() < 2) continue;
+		FMaterialInstanceCluster& Cluster = OutClusters.AddDefaulted_GetRef();
+		Cluster.Fingerprint = FingerprintIndices.Key;
+		for (const int32 Index : FingerprintIndices.Value)
+		{
+			Cluster.Instances.Add(InstancesData[Index]);
+		}
+		SortClusterByReferencers(Cluster);
+	}
+
+	DebugHeader::PrtLog(FString::Printf(TEXT("Fingerprinted %d material instances (%d loaded, %d cached), found %d duplicate clusters in %.3f seconds"),
+		InstancesData.Num(), IndicesToHash.Num(), InstancesData.Num() - IndicesToHash.Num(), OutClusters.Num(),
+		FPlatformTime::Seconds() - StartTime));
+}
+
+//Keep the most referenced instance so the fewest packages get dirtied
+void FMaterialInstanceDeduplicator::SortClusterByReferencers(FMaterialInstanceCluster& Cluster)
+{
+	IAssetRegistry& AssetRegistry =
+		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	TMap<FName, int32> ReferencerCounts;
+	for (const FAssetData& InstanceData : Cluster.Instances)
+	{
+		TArray<FName> Referencers;
+		AssetRegistry.GetReferencers(InstanceData.PackageName, Referencers);
+		ReferencerCounts.Add(InstanceData.PackageName, Referencers.Num());
+	}
+	Cluster.Instances.Sort([&ReferencerCounts](const FAssetData& A, const FAssetData& B)
+		{
+			const int32 ReferencersA = ReferencerCounts[A.PackageName];
+			const int32 ReferencersB = ReferencerCounts[B.PackageName];
+			if (ReferencersA != ReferencersB) return ReferencersA > ReferencersB;
+			return A.PackageName.LexicalLess(B.PackageName);
+		});
+}
+
+int32 FMaterialInstanceDeduplicator::Consolidate(const TArray<FMaterialInstanceCluster>& Clusters)
+{
+	TSet<UPackage*> DirtiedPackages;
+	int32 ConsolidatedCounter = 0;
+	FScopedSlowTask ConsolidateTask(Clusters.Num(), FText::FromString(TEXT("Replacing duplicate material instance references")));
+	ConsolidateTask.MakeDialog();
+	for (const FMaterialInstanceCluster& Cluster : Clusters)
+	{
+		ConsolidateTask.EnterProgressFrame();
+		if (Cluster.Instances.Num() < 2) continue;
+		UObject* InstanceToKeep = Cluster.Instances[0].GetAsset();
+		if (!InstanceToKeep) continue;
+
+		TArray<UObject*> InstancesToReplace;
+		for (int32 Index = 1; Index < Cluster.Instances.Num(); ++Index)
+		{
+			if (UObject* Duplicate = Cluster.Instances[Index].GetAsset())
+			{
+				InstancesToReplace.Add(Duplicate);
+			}
+		}
+		if (InstancesToReplace.Num() == 0) continue;
+
+		const ObjectTools::FConsolidationResults Results =
+			ObjectTools::ConsolidateObjects(InstanceToKeep, InstancesToReplace, false);
+		DirtiedPackages.Append(Results.DirtiedPackages);
+		ConsolidatedCounter += InstancesToReplace.Num() - Results.FailedConsolidationObjs.Num();
+	}
+
+	//Every referencer that got repointed is saved in one pass
+	TArray<UPackage*> PackagesToSave;
+	for (UPackage* DirtiedPackage : DirtiedPackages)
+	{
+		if (DirtiedPackage && DirtiedPackage->IsDirty())
+		{
+			PackagesToSave.Add(DirtiedPackage);
+		}
+	}
+	if (PackagesToSave.Num() > 0)
+	{
+		UEditorLoadingAndSavingUtils::SavePackages(PackagesToSave, true);
+	}
+	return ConsolidatedCounter;
+}
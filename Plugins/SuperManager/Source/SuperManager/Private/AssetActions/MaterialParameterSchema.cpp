@@ -0,0 +1,55 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AssetActions/MaterialParameterSchema.h"
+#include "Materials/MaterialInterface.h"
+#include "UObject/ObjectSaveContext.h"
+
+const FTextureParameterSlot* FMaterialParameterSchema::FindSlotForRole(E_TextureRole TextureRole) const
+{
+	if (TextureRole == E_TextureRole::ETR_MAX) return nullptr;
+	return TextureSlots.Find(ParameterNameByRole[(int32)TextureRole]);
+}
+
+FMaterialParameterSchemaCache& FMaterialParameterSchemaCache::Get()
+{
+	static FMaterialParameterSchemaCache SchemaCache;
+	return SchemaCache;
+}
+
+void FMaterialParameterSchemaCache::Register()
+{
+	PackageSavedHandle = UPackage::PackageSavedWithContextEvent.AddRaw(this, &FMaterialParameterSchemaCache::OnPackageSaved);
+}
+
+void FMaterialParameterSchemaCache::Unregister()
+{
+	UPackage::PackageSavedWithContextEvent.Remove(PackageSavedHandle);
+	SchemasByParent.Empty();
+}
+
+const FMaterialParameterSchema* FMaterialParameterSchemaCache::Find(const UMaterialInterface* ParentMaterial,
+	uint32 ClassifierHash) const
+{
+	const FMaterialParameterSchema* Schema = SchemasByParent.Find(FObjectKey(ParentMaterial));
+	return Schema && Schema->ClassifierHash == ClassifierHash ? Schema : nullptr;
+}
+
+const FMaterialParameterSchema& FMaterialParameterSchemaCache::Add(const UMaterialInterface* ParentMaterial,
+	FMaterialParameterSchema&& Schema)
+{
+	return SchemasByParent.Add(FObjectKey(ParentMaterial), MoveTemp(Schema));
+}
+
+void FMaterialParameterSchemaCache::OnPackageSaved(const FString& PackageFileName, UPackage* SavedPackage,
+	FObjectPostSaveContext SaveContext)
+{
+	if (!SavedPackage || SchemasByParent.Num() == 0) return;
+	const FName SavedPackageName = SavedPackage->GetFName();
+	for (auto SchemaIt = SchemasByParent.CreateIterator(); SchemaIt; ++SchemaIt)
+	{
+		if (SchemaIt.Value().SourcePackageNames.Contains(SavedPackageName))
+		{
+			SchemaIt.RemoveCurrent();
+		}
+	}
+}
@@ -0,0 +1,306 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AssetActions/MaterialUsageAuditor.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Async/ParallelFor.h"
+#include "Algo/Count.h"
+#include "Materials/Material.h"
+#include "Materials/MaterialExpressionStaticBoolParameter.h"
+#include "Materials/MaterialExpressionStaticComponentMaskParameter.h"
+#include "Materials/MaterialExpressionQualitySwitch.h"
+#include "Materials/MaterialExpressionFeatureLevelSwitch.h"
+#include "Materials/MaterialExpressionShadingPathSwitch.h"
+#include "Misc/ScopedSlowTask.h"
+#include "FileHelpers.h"
+#include "ScopedTransaction.h"
+#include "DebugHeader.h"
+#include "SuperManager.h"
+
+namespace
+{
+	const FTopLevelAssetPath MaterialInstanceClassPath(TEXT("/Script/Engine.MaterialInstanceConstant"));
+	const FTopLevelAssetPath StaticMeshClassPath(TEXT("/Script/Engine.StaticMesh"));
+	const FTopLevelAssetPath SkeletalMeshClassPath(TEXT("/Script/Engine.SkeletalMesh"));
+	const FTopLevelAssetPath CascadeSystemClassPath(TEXT("/Script/Engine.ParticleSystem"));
+	const FTopLevelAssetPath NiagaraSystemClassPath(TEXT("/Script/Niagara.NiagaraSystem"));
+	const FTopLevelAssetPath NiagaraEmitterClassPath(TEXT("/Script/Niagara.NiagaraEmitter"));
+	const FTopLevelAssetPath GeometryCollectionClassPath(TEXT("/Script/GeometryCollectionEngine.GeometryCollection"));
+	const FTopLevelAssetPath GeometryCacheClassPath(TEXT("/Script/GeometryCache.GeometryCache"));
+	const FTopLevelAssetPath GroomClassPath(TEXT("/Script/HairStrandsCore.GroomAsset"));
+	const FTopLevelAssetPath GroomBindingClassPath(TEXT("/Script/HairStrandsCore.GroomBindingAsset"));
+
+	//Users whose asset type says which vertex factory renders the material, anything else may use it anywhere
+	bool IsSpecificUserClass(const FTopLevelAssetPath& ClassPath)
+	{
+		static const TSet<FTopLevelAssetPath> SpecificUserClasses = { MaterialInstanceClassPath, StaticMeshClassPath,
+			SkeletalMeshClassPath, CascadeSystemClassPath, NiagaraSystemClassPath, NiagaraEmitterClassPath,
+			GeometryCollectionClassPath, GeometryCacheClassPath, GroomClassPath, GroomBindingClassPath };
+		return SpecificUserClasses.Contains(ClassPath);
+	}
+}
+
+int32 FMaterialUsageReport::GetNumUnneededFlags() const
+{
+	return Algo::CountIf(EnabledFlags, [](const FMaterialUsageFlag& Flag) { return Flag.Need == E_UsageFlagNeed::EUFN_Unneeded; });
+}
+
+FString FMaterialUsageReport::DescribeFlags() const
+{
+	TArray<FString> FlagDescriptions;
+	for (const FMaterialUsageFlag& Flag : EnabledFlags)
+	{
+		FlagDescriptions.Add(UMaterial::GetUsageName(Flag.Usage) + TEXT("(") + FMaterialUsageAuditor::LexNeed(Flag.Need) + TEXT(")"));
+	}
+	return FString::Join(FlagDescriptions, TEXT(", "));
+}
+
+FString FMaterialUsageReport::DescribeToggles() const
+{
+	TArray<FString> Toggles;
+	if (NumStaticSwitchBits > 0) Toggles.Add(FString::Printf(TEXT("%d static switch bits"), NumStaticSwitchBits));
+	if (bHasQualitySwitch) Toggles.Add(TEXT("quality switch"));
+	if (bHasFeatureLevelSwitch) Toggles.Add(TEXT("feature level switch"));
+	if (bHasShadingPathSwitch) Toggles.Add(TEXT("shading path switch"));
+	return FString::Join(Toggles, TEXT(", "));
+}
+
+const TCHAR* FMaterialUsageAuditor::LexNeed(E_UsageFlagNeed Need)
+{
+	switch (Need)
+	{
+	case E_UsageFlagNeed::EUFN_Needed: return TEXT("needed");
+	case E_UsageFlagNeed::EUFN_PossiblyNeeded: return TEXT("possibly needed");
+	case E_UsageFlagNeed::EUFN_Unneeded: return TEXT("unneeded");
+	default: return TEXT("unknown");
+	}
+}
+
+//Walks referencers through material instances and static meshes, registry data only so it can run on workers
+void FMaterialUsageAuditor::CollectUsers(const IAssetRegistry& AssetRegistry, FName MaterialPackageName, FMaterialUsers& OutUsers)
+{
+	struct FPendingPackage
+	{
+		FName PackageName;
+		bool bThroughStaticMesh;
+	};
+	TArray<FPendingPackage> PendingPackages = { { MaterialPackageName, false } };
+	TSet<FName> VisitedPackages = { MaterialPackageName };
+	TArray<FName> Referencers;
+	TArray<FAssetData> ReferencerAssets;
+	while (PendingPackages.Num() > 0)
+	{
+		const FPendingPackage Pending = PendingPackages.Pop(false);
+		Referencers.Reset();
+		AssetRegistry.GetReferencers(Pending.PackageName, Referencers);
+		for (const FName& Referencer : Referencers)
+		{
+			if (VisitedPackages.Contains(Referencer)) continue;
+			VisitedPackages.Add(Referencer);
+
+			ReferencerAssets.Reset();
+			AssetRegistry.GetAssetsByPackageName(Referencer, ReferencerAssets, true);
+			for (const FAssetData& ReferencerAsset : ReferencerAssets)
+			{
+				const FTopLevelAssetPath& ClassPath = ReferencerAsset.AssetClassPath;
+				(Pending.bThroughStaticMesh ? OutUsers.MeshUserClasses : OutUsers.DirectUserClasses).Add(ClassPath);
+				if (ClassPath == MaterialInstanceClassPath && !Pending.bThroughStaticMesh)
+				{
+					++OutUsers.NumChildInstances;
+					PendingPackages.Add({ Referencer, false });
+				}
+				else if (ClassPath == StaticMeshClassPath && !Pending.bThroughStaticMesh)
+				{
+					PendingPackages.Add({ Referencer, true });
+				}
+			}
+		}
+	}
+}
+
+E_UsageFlagNeed FMaterialUsageAuditor::ClassifyNeed(EMaterialUsage Usage, const FMaterialUsers& Users)
+{
+	//Nothing in the registry points at the material, code or soft references may still use it with any flag
+	if (Users.DirectUserClasses.Num() == 0) return E_UsageFlagNeed::EUFN_Unknown;
+
+	bool bUsedAnywhere = false;
+	for (const FTopLevelAssetPath& ClassPath : Users.DirectUserClasses)
+	{
+		if (!IsSpecificUserClass(ClassPath))
+		{
+			bUsedAnywhere = true;
+			break;
+		}
+	}
+	auto UsedBy = [&Users](const FTopLevelAssetPath& ClassPath) { return Users.DirectUserClasses.Contains(ClassPath); };
+	//Mesh renderers of particle systems reference the static mesh, not the material
+	auto UsedThroughMeshBy = [&Users](const FTopLevelAssetPath& ClassPath) { return Users.MeshUserClasses.Contains(ClassPath); };
+
+	//A user of this type needs the flag for sure, Needed; one of several flags it might need, PossiblyNeeded
+	E_UsageFlagNeed NeedFromUsers = E_UsageFlagNeed::EUFN_Unneeded;
+	switch (Usage)
+	{
+	case MATUSAGE_SkeletalMesh:
+	case MATUSAGE_MorphTargets:
+	case MATUSAGE_Clothing:
+		if (UsedBy(SkeletalMeshClassPath))
+		{
+			NeedFromUsers = Usage == MATUSAGE_SkeletalMesh ? E_UsageFlagNeed::EUFN_Needed : E_UsageFlagNeed::EUFN_PossiblyNeeded;
+		}
+		break;
+	case MATUSAGE_ParticleSprites:
+	case MATUSAGE_BeamTrails:
+		if (UsedBy(CascadeSystemClassPath)) NeedFromUsers = E_UsageFlagNeed::EUFN_PossiblyNeeded;
+		break;
+	case MATUSAGE_MeshParticles:
+		if (UsedBy(CascadeSystemClassPath) || UsedThroughMeshBy(CascadeSystemClassPath))
+		{
+			NeedFromUsers = E_UsageFlagNeed::EUFN_PossiblyNeeded;
+		}
+		break;
+	case MATUSAGE_NiagaraSprites:
+	case MATUSAGE_NiagaraRibbons:
+		if (UsedBy(NiagaraSystemClassPath) || UsedBy(NiagaraEmitterClassPath)) NeedFromUsers = E_UsageFlagNeed::EUFN_PossiblyNeeded;
+		break;
+	case MATUSAGE_NiagaraMeshParticles:
+		if (UsedBy(NiagaraSystemClassPath) || UsedBy(NiagaraEmitterClassPath) ||
+			UsedThroughMeshBy(NiagaraSystemClassPath) || UsedThroughMeshBy(NiagaraEmitterClassPath))
+		{
+			NeedFromUsers = E_UsageFlagNeed::EUFN_PossiblyNeeded;
+		}
+		break;
+	case MATUSAGE_InstancedStaticMeshes:
+	case MATUSAGE_SplineMesh:
+		//Levels, blueprints and foliage placing the static mesh decide the component type
+		if (Users.MeshUserClasses.Num() > 0) NeedFromUsers = E_UsageFlagNeed::EUFN_PossiblyNeeded;
+		break;
+	case MATUSAGE_GeometryCollections:
+		if (UsedBy(GeometryCollectionClassPath)) NeedFromUsers = E_UsageFlagNeed::EUFN_Needed;
+		break;
+	case MATUSAGE_GeometryCache:
+		if (UsedBy(GeometryCacheClassPath)) NeedFromUsers = E_UsageFlagNeed::EUFN_Needed;
+		break;
+	case MATUSAGE_HairStrands:
+		if (UsedBy(GroomClassPath) || UsedBy(GroomBindingClassPath)) NeedFromUsers = E_UsageFlagNeed::EUFN_Needed;
+		break;
+	default:
+		return E_UsageFlagNeed::EUFN_Unknown;
+	}
+
+	if (NeedFromUsers == E_UsageFlagNeed::EUFN_Unneeded && bUsedAnywhere) return E_UsageFlagNeed::EUFN_PossiblyNeeded;
+	return NeedFromUsers;
+}
+
+//Vertex factories times quality levels times the static permutations child instances can create
+int64 FMaterialUsageAuditor::EstimatePermutations(int32 NumUsageFlags, const FMaterialUsageReport& Report)
+{
+	int64 Permutations = 1 + NumUsageFlags;
+	if (Report.bHasQualitySwitch) Permutations *= (int64)EMaterialQualityLevel::Num;
+	if (Report.NumStaticSwitchBits > 0)
+	{
+		const int64 MaxStaticPermutations = (int64)1 << FMath::Min(Report.NumStaticSwitchBits, 30);
+		Permutations *= FMath::Min<int64>(MaxStaticPermutations, 1 + Report.NumChildInstances);
+	}
+	return Permutations;
+}
+
+void FMaterialUsageAuditor::Run(const TArray<FString>& RootPaths, TArray<FMaterialUsageReport>& OutReports) const
+{
+	OutReports.Empty();
+	const double StartTime = FPlatformTime::Seconds();
+	IAssetRegistry& AssetRegistry =
+		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	FARFilter Filter;
+	for (const FString& RootPath : RootPaths)
+	{
+		Filter.PackagePaths.Add(FName(*RootPath));
+	}
+	Filter.bRecursivePaths = true;
+	Filter.bIncludeOnlyOnDiskAssets = true;
+	Filter.ClassPaths.Add(UMaterial::StaticClass()->GetClassPathName());
+	TArray<FAssetData> MaterialsData;
+	AssetRegistry.GetAssets(Filter, MaterialsData);
+	MaterialsData.RemoveAll([](const FAssetData& MaterialData)
+		{
+			return FSuperManagerModule::IsPathExcludedFromScan(MaterialData.PackagePath.ToString());
+		});
+
+	TArray<FMaterialUsers> UsersPerMaterial;
+	UsersPerMaterial.SetNum(MaterialsData.Num());
+	ParallelFor(MaterialsData.Num(), [&AssetRegistry, &MaterialsData, &UsersPerMaterial](int32 Index)
+		{
+			CollectUsers(AssetRegistry, MaterialsData[Index].PackageName, UsersPerMaterial[Index]);
+		});
+
+	//Usage flags and expressions are not in the registry, materials are loaded but never compiled here
+	FScopedSlowTask AuditTask(MaterialsData.Num(), FText::FromString(TEXT("Auditing material usage flags")));
+	AuditTask.MakeDialog(true);
+	for (int32 Index = 0; Index < MaterialsData.Num(); ++Index)
+	{
+		AuditTask.EnterProgressFrame();
+		if (AuditTask.ShouldCancel()) break;
+		const UMaterial* Material = Cast<UMaterial>(MaterialsData[Index].GetAsset());
+		if (!Material) continue;
+
+		FMaterialUsageReport& Report = OutReports.AddDefaulted_GetRef();
+		Report.AssetData = MaterialsData[Index];
+		Report.NumChildInstances = UsersPerMaterial[Index].NumChildInstances;
+		for (int32 UsageIndex = 0; UsageIndex < MATUSAGE_MAX; ++UsageIndex)
+		{
+			const EMaterialUsage Usage = (EMaterialUsage)UsageIndex;
+			if (!Material->GetUsageByFlag(Usage)) continue;
+			Report.EnabledFlags.Add({ Usage, ClassifyNeed(Usage, UsersPerMaterial[Index]) });
+		}
+		for (const UMaterialExpression* Expression : Material->GetExpressions())
+		{
+			if (Expression && Expression->IsA<UMaterialExpressionStaticComponentMaskParameter>()) Report.NumStaticSwitchBits += 4;
+			else if (Expression && Expression->IsA<UMaterialExpressionStaticBoolParameter>()) ++Report.NumStaticSwitchBits;
+			else if (Expression && Expression->IsA<UMaterialExpressionQualitySwitch>()) Report.bHasQualitySwitch = true;
+			else if (Expression && Expression->IsA<UMaterialExpressionFeatureLevelSwitch>()) Report.bHasFeatureLevelSwitch = true;
+			else if (Expression && Expression->IsA<UMaterialExpressionShadingPathSwitch>()) Report.bHasShadingPathSwitch = true;
+		}
+		Report.EstimatedPermutations = EstimatePermutations(Report.EnabledFlags.Num(), Report);
+		Report.PermutationsAfterStripping = EstimatePermutations(Report.EnabledFlags.Num() - Report.GetNumUnneededFlags(), Report);
+	}
+
+	OutReports.Sort([](const FMaterialUsageReport& A, const FMaterialUsageReport& B)
+		{
+			return A.EstimatedPermutations > B.EstimatedPermutations;
+		});
+	DebugHeader::PrtLog(FString::Printf(TEXT("Audited usage flags of %d materials in %.3f seconds"),
+		OutReports.Num(), FPlatformTime::Seconds() - StartTime));
+}
+
+int32 FMaterialUsageAuditor::StripUnneededFlags(const TArray<FMaterialUsageReport>& Reports)
+{
+	TArray<UPackage*> PackagesToSave;
+	int32 StrippedCounter = 0;
+	//One undo step for the whole strip, each material is recorded before its flags change
+	FScopedTransaction StripTransaction(FText::FromString(TEXT("Strip Unneeded Material Usage Flags")));
+	for (const FMaterialUsageReport& Report : Reports)
+	{
+		if (Report.GetNumUnneededFlags() == 0) continue;
+		UMaterial* Material = Cast<UMaterial>(Report.AssetData.GetAsset());
+		if (!Material) continue;
+
+		Material->Modify();
+		for (const FMaterialUsageFlag& Flag : Report.EnabledFlags)
+		{
+			if (Flag.Need != E_UsageFlagNeed::EUFN_Unneeded) continue;
+			FBoolProperty* UsageProperty = FindFProperty<FBoolProperty>(UMaterial::StaticClass(), *UMaterial::GetUsageName(Flag.Usage));
+			if (!UsageProperty) continue;
+			UsageProperty->SetPropertyValue_InContainer(Material, false);
+			++StrippedCounter;
+		}
+		//No PostEditChange: it would recompile every stripped material now for nothing, clearing a usage flag only
+		//means those permutations are no longer requested, and nothing already compiled depends on the flag being set
+		Material->MarkPackageDirty();
+		PackagesToSave.Add(Material->GetPackage());
+	}
+
+	if (PackagesToSave.Num() > 0)
+	{
+		UEditorLoadingAndSavingUtils::SavePackages(PackagesToSave, true);
+	}
+	return StrippedCounter;
+}
@@ -0,0 +1,141 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AssetActions/NamingConventionLinter.h"
+#include "AssetActions/QuickAssetAction.h"
+#include "AssetActions/BatchAssetRenamer.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Async/ParallelFor.h"
+#include "DebugHeader.h"
+#include "SuperManager.h"
+
+TArray<FNamingConventionRule> UNamingConventionSettings::GetEffectiveRules() const
+{
+	if (Rules.Num() > 0) return Rules;
+
+	TArray<FNamingConventionRule> DefaultRules;
+	for (const TPair<UClass*, FString>& PrefixPair : GetDefault<UQuickAssetAction>()->GetPrefixMap())
+	{
+		if (!PrefixPair.Key) continue;
+		FNamingConventionRule& Rule = DefaultRules.AddDefaulted_GetRef();
+		Rule.AssetClass = FSoftClassPath(PrefixPair.Key);
+		Rule.Prefix = PrefixPair.Value;
+	}
+	return DefaultRules;
+}
+
+FNamingConventionLinter::FNamingConventionLinter(const TArray<FNamingConventionRule>& Rules)
+{
+	for (const FNamingConventionRule& Rule : Rules)
+	{
+		if (Rule.AssetClass.IsNull()) continue;
+		RulesByClassPath.Add(Rule.AssetClass.GetAssetPath(), Rule);
+	}
+}
+
+void FNamingConventionLinter::Run(const TArray<FString>& RootPaths, TArray<FNamingViolation>& OutViolations)
+{
+	OutViolations.Empty();
+	const double StartTime = FPlatformTime::Seconds();
+	IAssetRegistry& AssetRegistry =
+		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	FARFilter Filter;
+	for (const FString& RootPath : RootPaths)
+	{
+		Filter.PackagePaths.Add(FName(*RootPath));
+	}
+	Filter.bRecursivePaths = true;
+	Filter.bIncludeOnlyOnDiskAssets = true;
+	TArray<FAssetData> AssetsData;
+	AssetRegistry.GetAssets(Filter, AssetsData);
+
+	//Resolve the rule of every distinct class once, workers only read the result
+	TMap<FTopLevelAssetPath, const FNamingConventionRule*> RuleByAssetClass;
+	for (const FAssetData& AssetData : AssetsData)
+	{
+		if (RuleByAssetClass.Contains(AssetData.AssetClassPath)) continue;
+		RuleByAssetClass.Add(AssetData.AssetClassPath, ClassAncestry.FindNearest(RulesByClassPath, AssetData.AssetClassPath));
+	}
+	const FTopLevelAssetPath RedirectorClassPath = UObjectRedirector::StaticClass()->GetClassPathName();
+
+	TArray<FNamingViolation> PerAssetResults;
+	PerAssetResults.SetNum(AssetsData.Num());
+	ParallelFor(AssetsData.Num(), [&AssetsData, &RuleByAssetClass, &RedirectorClassPath, &PerAssetResults](int32 Index)
+		{
+			const FAssetData& AssetData = AssetsData[Index];
+			if (AssetData.AssetClassPath == RedirectorClassPath) return;
+			if (FSuperManagerModule::IsPathExcludedFromScan(AssetData.PackagePath.ToString())) return;
+			const FNamingConventionRule* Rule = RuleByAssetClass.FindRef(AssetData.AssetClassPath);
+			if (!Rule) return;
+			if (CheckName(AssetData.AssetName.ToString(), *Rule, PerAssetResults[Index]))
+			{
+				PerAssetResults[Index].AssetData = AssetData;
+			}
+		});
+
+	for (FNamingViolation& Result : PerAssetResults)
+	{
+		if (Result.Message.IsEmpty()) continue;
+		OutViolations.Add(MoveTemp(Result));
+	}
+
+	DebugHeader::PrtLog(FString::Printf(TEXT("Linted %d assets, found %d naming violations in %.3f seconds"),
+		AssetsData.Num(), OutViolations.Num(), FPlatformTime::Seconds() - StartTime));
+}
+
+//Returns true if the name breaks the rule, the suggested name fixes everything that can be fixed
+bool FNamingConventionLinter::CheckName(const FString& AssetName, const FNamingConventionRule& Rule,
+	FNamingViolation& OutViolation)
+{
+	FString Message;
+	FString SuggestedName = AssetName;
+	bool bCanAutoFix = true;
+
+	for (const TCHAR Character : Rule.ForbiddenCharacters)
+	{
+		int32 FoundIndex = INDEX_NONE;
+		if (AssetName.FindChar(Character, FoundIndex))
+		{
+			Message += FString::Printf(TEXT("Forbidden character '%c'. "), Character);
+			SuggestedName.ReplaceCharInline(Character, TEXT('_'));
+		}
+	}
+	if (!Rule.Prefix.IsEmpty() && !AssetName.StartsWith(Rule.Prefix))
+	{
+		Message += TEXT("Missing prefix ") + Rule.Prefix + TEXT(". ");
+		SuggestedName.InsertAt(0, Rule.Prefix);
+	}
+	if (!Rule.Suffix.IsEmpty() && !AssetName.EndsWith(Rule.Suffix))
+	{
+		Message += TEXT("Missing suffix ") + Rule.Suffix + TEXT(". ");
+		SuggestedName += Rule.Suffix;
+	}
+	if (Rule.MaxLength > 0 && SuggestedName.Len() > Rule.MaxLength)
+	{
+		Message += FString::Printf(TEXT("Longer than %d characters. "), Rule.MaxLength);
+		bCanAutoFix = false;
+	}
+	if (Message.IsEmpty()) return false;
+
+	OutViolation.Message = Message.TrimEnd();
+	OutViolation.SuggestedName = SuggestedName;
+	OutViolation.bCanAutoFix = bCanAutoFix;
+	return true;
+}
+
+int32 FNamingConventionLinter::AutoFix(const TArray<FNamingViolation>& Violations)
+{
+	FBatchAssetRenamer BatchRenamer;
+	for (const FNamingViolation& Violation : Violations)
+	{
+		if (!Violation.bCanAutoFix) continue;
+		BatchRenamer.AddRename(Violation.AssetData, Violation.SuggestedName);
+	}
+	if (BatchRenamer.GetRows().Num() == 0) return 0;
+
+	if (BatchRenamer.DetectCollisions() > 0)
+	{
+		BatchRenamer.LogPreviewTable();
+	}
+	return BatchRenamer.Submit();
+}
@@ -0,0 +1,163 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AssetActions/OrmTexturePacker.h"
+#include "DebugHeader.h"
+#include "Engine/Texture2D.h"
+#include "ImageCore.h"
+#include "Async/ParallelFor.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+
+UTexture2D* FOrmTexturePacker::CreatePackedTexture(UTexture2D* AmbientOcclusionTexture, UTexture2D* RoughnessTexture,
+	UTexture2D* MetallicTexture, const FString& PackagePath, const FString& NameOfTheTexture)
+{
+	const double StartTime = FPlatformTime::Seconds();
+	const FString NewPackageName = FPaths::Combine(PackagePath, NameOfTheTexture);
+	if (FindPackage(nullptr, *NewPackageName) || FPackageName::DoesPackageExist(NewPackageName))
+	{
+		DebugHeader::PrtLog(NameOfTheTexture + TEXT(" is already used by asset, packing skipped"));
+		return nullptr;
+	}
+
+	//Source mips are read on the game thread, the per-pixel work below runs on workers
+	UTexture2D* InputTextures[] = { AmbientOcclusionTexture, RoughnessTexture, MetallicTexture };
+	const uint8 NeutralValues[] = { 255, 128, 0 };
+	FChannelPlane InputPlanes[3];
+	int32 PackedSizeX = 0;
+	int32 PackedSizeY = 0;
+	for (int32 ChannelIndex = 0; ChannelIndex < 3; ++ChannelIndex)
+	{
+		if (!InputTextures[ChannelIndex]) continue;
+		if (!ReadChannelPlane(InputTextures[ChannelIndex], InputPlanes[ChannelIndex]))
+		{
+			DebugHeader::PrtLog(TEXT("Failed to read source of ") + InputTextures[ChannelIndex]->GetName());
+			continue;
+		}
+		PackedSizeX = FMath::Max(PackedSizeX, InputPlanes[ChannelIndex].SizeX);
+		PackedSizeY = FMath::Max(PackedSizeY, InputPlanes[ChannelIndex].SizeY);
+	}
+	if (PackedSizeX == 0 || PackedSizeY == 0) return nullptr;
+
+	FChannelPlane PackedPlanes[3];
+	for (int32 ChannelIndex = 0; ChannelIndex < 3; ++ChannelIndex)
+	{
+		const FChannelPlane& InputPlane = InputPlanes[ChannelIndex];
+		if (InputPlane.Pixels.Num() == 0)
+		{
+			PackedPlanes[ChannelIndex].SizeX = PackedSizeX;
+			PackedPlanes[ChannelIndex].SizeY = PackedSizeY;
+			PackedPlanes[ChannelIndex].Pixels.Init(NeutralValues[ChannelIndex], (int64)PackedSizeX * PackedSizeY);
+		}
+		else if (InputPlane.SizeX != PackedSizeX || InputPlane.SizeY != PackedSizeY)
+		{
+			ResamplePlane(InputPlane, PackedSizeX, PackedSizeY, PackedPlanes[ChannelIndex]);
+		}
+		else
+		{
+			PackedPlanes[ChannelIndex] = MoveTemp(InputPlanes[ChannelIndex]);
+		}
+	}
+
+	TArray64<uint8> PackedPixels;
+	PackedPixels.SetNumUninitialized((int64)PackedSizeX * PackedSizeY * 4);
+	InterleavePlanes(PackedPlanes[0].Pixels.GetData(), PackedPlanes[1].Pixels.GetData(), PackedPlanes[2].Pixels.GetData(),
+		PackedSizeX, PackedSizeY, PackedPixels.GetData());
+
+	UPackage* NewPackage = CreatePackage(*NewPackageName);
+	UTexture2D* PackedTexture = NewObject<UTexture2D>(NewPackage, FName(*NameOfTheTexture), RF_Public | RF_Standalone);
+	PackedTexture->Source.Init(PackedSizeX, PackedSizeY, 1, 1, TSF_BGRA8, PackedPixels.GetData());
+	//Channels hold linear data, masks compression keeps them independent
+	PackedTexture->SRGB = false;
+	PackedTexture->CompressionSettings = TextureCompressionSettings::TC_Masks;
+	PackedTexture->PostEditChange();
+	NewPackage->MarkPackageDirty();
+	FAssetRegistryModule::AssetCreated(PackedTexture);
+
+	DebugHeader::PrtLog(FString::Printf(TEXT("Packed %s (%dx%d) in %.3f seconds"),
+		*NameOfTheTexture, PackedSizeX, PackedSizeY, FPlatformTime::Seconds() - StartTime));
+	return PackedTexture;
+}
+
+//Grayscale inputs only need one channel, the red channel of the linear BGRA8 conversion is kept
+bool FOrmTexturePacker::ReadChannelPlane(UTexture2D* SourceTexture, FChannelPlane& OutPlane)
+{
+	FImage SourceImage;
+	if (!SourceTexture->Source.IsValid() || !SourceTexture->Source.GetMipImage(SourceImage, 0, 0, 0)) return false;
+
+	FImage LinearImage;
+	SourceImage.CopyTo(LinearImage, ERawImageFormat::BGRA8, EGammaSpace::Linear);
+	OutPlane.SizeX = LinearImage.SizeX;
+	OutPlane.SizeY = LinearImage.SizeY;
+	OutPlane.Pixels.SetNumUninitialized((int64)OutPlane.SizeX * OutPlane.SizeY);
+
+	const uint8* RESTRICT SourceBGRA = LinearImage.RawData.GetData();
+	uint8* RESTRICT DestPixels = OutPlane.Pixels.GetData();
+	const int32 SizeX = OutPlane.SizeX;
+	ParallelFor(OutPlane.SizeY, [SourceBGRA, DestPixels, SizeX](int32 Row)
+		{
+			const uint8* RESTRICT SourceRow = SourceBGRA + (int64)Row * SizeX * 4;
+			uint8* RESTRICT DestRow = DestPixels + (int64)Row * SizeX;
+			for (int32 X = 0; X < SizeX; ++X)
+			{
+				DestRow[X] = SourceRow[X * 4 + 2];
+			}
+		});
+	return true;
+}
+
+//Bilinear resample in 16.16 fixed point, one row per task
+void FOrmTexturePacker::ResamplePlane(const FChannelPlane& SourcePlane, int32 DestSizeX, int32 DestSizeY,
+	FChannelPlane& OutPlane)
+{
+	OutPlane.SizeX = DestSizeX;
+	OutPlane.SizeY = DestSizeY;
+	OutPlane.Pixels.SetNumUninitialized((int64)DestSizeX * DestSizeY);
+
+	const int64 StepX = ((int64)SourcePlane.SizeX << 16) / DestSizeX;
+	const int64 StepY = ((int64)SourcePlane.SizeY << 16) / DestSizeY;
+	const uint8* SourcePixels = SourcePlane.Pixels.GetData();
+	uint8* DestPixels = OutPlane.Pixels.GetData();
+	const int32 SourceSizeX = SourcePlane.SizeX;
+	const int32 SourceSizeY = SourcePlane.SizeY;
+
+	ParallelFor(DestSizeY, [=](int32 Row)
+		{
+			const int64 SampleY = FMath::Max<int64>(0, (Row * StepY) + (StepY >> 1) - 0x8000);
+			const int32 Y0 = FMath::Min((int32)(SampleY >> 16), SourceSizeY - 1);
+			const int32 Y1 = FMath::Min(Y0 + 1, SourceSizeY - 1);
+			const int32 WeightY = (int32)(SampleY & 0xffff) >> 8;
+			const uint8* Row0 = SourcePixels + (int64)Y0 * SourceSizeX;
+			const uint8* Row1 = SourcePixels + (int64)Y1 * SourceSizeX;
+			uint8* DestRow = DestPixels + (int64)Row * DestSizeX;
+			for (int32 X = 0; X < DestSizeX; ++X)
+			{
+				const int64 SampleX = FMath::Max<int64>(0, (X * StepX) + (StepX >> 1) - 0x8000);
+				const int32 X0 = FMath::Min((int32)(SampleX >> 16), SourceSizeX - 1);
+				const int32 X1 = FMath::Min(X0 + 1, SourceSizeX - 1);
+				const int32 WeightX = (int32)(SampleX & 0xffff) >> 8;
+				const int32 Top = Row0[X0] * (256 - WeightX) + Row0[X1] * WeightX;
+				const int32 Bottom = Row1[X0] * (256 - WeightX) + Row1[X1] * WeightX;
+				DestRow[X] = (uint8)((Top * (256 - WeightY) + Bottom * WeightY + 0x8000) >> 16);
+			}
+		});
+}
+
+//Branch free contiguous loop per row so the compiler can vectorize it
+void FOrmTexturePacker::InterleavePlanes(const uint8* AmbientOcclusion, const uint8* Roughness, const uint8* Metallic,
+	int32 SizeX, int32 SizeY, uint8* OutBGRA)
+{
+	ParallelFor(SizeY, [=](int32 Row)
+		{
+			const int64 RowOffset = (int64)Row * SizeX;
+			const uint8* RESTRICT AmbientOcclusionRow = AmbientOcclusion + RowOffset;
+			const uint8* RESTRICT RoughnessRow = Roughness + RowOffset;
+			const uint8* RESTRICT MetallicRow = Metallic + RowOffset;
+			uint8* RESTRICT DestRow = OutBGRA + RowOffset * 4;
+			for (int32 X = 0; X < SizeX; ++X)
+			{
+				DestRow[X * 4 + 0] = MetallicRow[X];
+				DestRow[X * 4 + 1] = RoughnessRow[X];
+				DestRow[X * 4 + 2] = AmbientOcclusionRow[X];
+				DestRow[X * 4 + 3] = 255;
+			}
+		});
+}
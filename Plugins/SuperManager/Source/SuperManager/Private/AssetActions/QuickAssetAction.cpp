@@ -8,6 +8,10 @@
 #include "ObjectTools.h"
 #include "AssetRegistry/AssetRegistryModule.h"
 #include "AssetToolsModule.h"
+#include "Misc/ScopedSlowTask.h"
+#include "UObject/SavePackage.h"
+#include "AssetActions/BatchAssetRenamer.h"
+#include "SlateWidgets/AssetRenamePreviewWidget.h"
 
 
 
@@ -20,24 +24,61 @@ void UQuickAssetAction::DuplicateAssets(int32 NumOfDuplicates)
 	}
 
 	TArray<FAssetData> SelectedAssetsData = UEditorUtilityLibrary::GetSelectedAssetData();
-	uint32 Counter = 0;
+	const double StartTime = FPlatformTime::Seconds();
+	TArray<UObject*> DuplicatedObjects;
+	uint32 SkippedCounter = 0;
+	TSet<UPackage*> PackagesUserRefusedToFullyLoad;
 
-	for (const FAssetData& SelectedAssetData : SelectedAssetsData)
 	{
-		for (int32 i = 0; i < NumOfDuplicates; i++)
-		{
-			const FString SourceAssetPath = SelectedAssetData.ObjectPath.ToString();
-			const FString NewDuplicatedAssetName = SelectedAssetData.AssetName.ToString() + TEXT("_") + FString::FromInt(i + 1);
-			const FString NewPathName = FPaths::Combine(SelectedAssetData.PackagePath.ToString(), NewDuplicatedAssetName);
+		FScopedSlowTask DuplicationTask(SelectedAssetsData.Num() * NumOfDuplicates,
+			FText::FromString(TEXT("Duplicating assets")));
+		DuplicationTask.MakeDialog();
 
-			if (UEditorAssetLibrary::DuplicateAsset(SourceAssetPath, NewPathName))
+		for (const FAssetData& SelectedAssetData : SelectedAssetsData)
+		{
+			UObject* SourceObject = SelectedAssetData.GetAsset();
+			if (!SourceObject)
 			{
-				UEditorAssetLibrary::SaveAsset(NewPathName, false);
-				++Counter;
+				DuplicationTask.EnterProgressFrame(NumOfDuplicates);
+				continue;
+			}
+			for (int32 i = 0; i < NumOfDuplicates; i++)
+			{
+				DuplicationTask.EnterProgressFrame();
+				const FString NewDuplicatedAssetName = SelectedAssetData.AssetName.ToString() + TEXT("_") + FString::FromInt(i + 1);
+				const FString NewPackageName = FPaths::Combine(SelectedAssetData.PackagePath.ToString(), NewDuplicatedAssetName);
+				if (FindPackage(nullptr, *NewPackageName) || FPackageName::DoesPackageExist(NewPackageName))
+				{
+					++SkippedCounter;
+					continue;
+				}
+
+				//Same duplication the content browser does, worlds and blueprints get their fixups, but registry
+				//and content browser are only told once all copies exist
+				ObjectTools::FPackageGroupName PackageGroupName;
+				PackageGroupName.ObjectName = NewDuplicatedAssetName;
+				PackageGroupName.PackageName = NewPackageName;
+				UObject* DuplicatedObject = ObjectTools::DuplicateSingleObject(SourceObject, PackageGroupName,
+					PackagesUserRefusedToFullyLoad, false);
+				if (!DuplicatedObject)
+				{
+					++SkippedCounter;
+					continue;
+				}
+				DuplicatedObjects.Add(DuplicatedObject);
 			}
 		}
 	}
 
+	for (UObject* DuplicatedObject : DuplicatedObjects)
+	{
+		FAssetRegistryModule::AssetCreated(DuplicatedObject);
+	}
+	const uint32 Counter = SaveDuplicatedPackages(DuplicatedObjects);
+
+	DebugHeader::PrtLog(FString::Printf(TEXT("Duplicated %d assets (%u saved, %u skipped) from %d sources in %.3f seconds"),
+		DuplicatedObjects.Num(), Counter, SkippedCounter, SelectedAssetsData.Num(), FPlatformTime::Seconds() - StartTime));
+
 	if (Counter > 0)
 	{
 		DebugHeader::ShowNInfo(TEXT("Successfully duplicated " + FString::FromInt(Counter) + " files"));
@@ -45,40 +86,89 @@ void UQuickAssetAction::DuplicateAssets(int32 NumOfDuplicates)
 	}
 }
 
-void UQuickAssetAction::AddPrefixes()
+//Packages are serialized on the game thread, the file writes are handed to async IO and flushed once at the end
+uint32 UQuickAssetAction::SaveDuplicatedPackages(const TArray<UObject*>& DuplicatedObjects)
 {
-	TArray<UObject*>SelectedObjects = UEditorUtilityLibrary::GetSelectedAssets();
 	uint32 Counter = 0;
-	for (UObject* SelectedObject : SelectedObjects)
+	FSavePackageArgs SaveArgs;
+	SaveArgs.TopLevelFlags = RF_Public | RF_Standalone;
+	SaveArgs.SaveFlags = SAVE_Async | SAVE_NoError;
+	SaveArgs.Error = GWarn;
+
+	for (UObject* DuplicatedObject : DuplicatedObjects)
 	{
-		if (!SelectedObject) continue;
-		FString* PrefixFound = PrefixMap.Find(SelectedObject->GetClass());
+		UPackage* PackageToSave = DuplicatedObject->GetPackage();
+		const FString PackageFileName = FPackageName::LongPackageNameToFilename(PackageToSave->GetName(),
+			FPackageName::GetAssetPackageExtension());
+		if (UPackage::SavePackage(PackageToSave, DuplicatedObject, *PackageFileName, SaveArgs))
+		{
+			++Counter;
+		}
+		else
+		{
+			DebugHeader::PrtLog(TEXT("Failed to save ") + PackageToSave->GetName());
+		}
+	}
+	UPackage::WaitForAsyncFileWrites();
+	return Counter;
+}
+
+void UQuickAssetAction::AddPrefixes()
+{
+	//Only registry data is used here, none of the selected assets get loaded to find their prefix
+	TArray<FAssetData> SelectedAssetsData = UEditorUtilityLibrary::GetSelectedAssetData();
+	const TMap<FTopLevelAssetPath, FString>& PrefixByClassPath = GetPrefixMapByClassPath();
+	const FTopLevelAssetPath MaterialInstanceClassPath = UMaterialInstanceConstant::StaticClass()->GetClassPathName();
+	FBatchAssetRenamer BatchRenamer;
+	for (const FAssetData& SelectedAssetData : SelectedAssetsData)
+	{
+		const FString* PrefixFound = ClassAncestry.FindNearest(PrefixByClassPath, SelectedAssetData.AssetClassPath);
 		if (!PrefixFound || PrefixFound->IsEmpty())
 		{
-			DebugHeader::Print(TEXT("Failed to find prefix for class ") + SelectedObject->GetClass()->GetName(), FColor::Red);
+			DebugHeader::Print(TEXT("Failed to find prefix for class ") + SelectedAssetData.AssetClassPath.GetAssetName().ToString(), FColor::Red);
 			continue;
 		}
-		FString OldName = SelectedObject->GetName();
+		FString OldName = SelectedAssetData.AssetName.ToString();
 		if (OldName.StartsWith(*PrefixFound))
 		{
 			DebugHeader::Print(OldName + TEXT(" already has prefix added"), FColor::Red);
 			continue;
 		}
-		if (SelectedObject->IsA<UMaterialInstanceConstant>())
+		if (ClassAncestry.IsChildOf(SelectedAssetData.AssetClassPath, MaterialInstanceClassPath))
 		{
 			OldName.RemoveFromStart(TEXT("M_"));
 			OldName.RemoveFromEnd(TEXT("_Inst"));
 		}
-		const FString NewNameWithPrefix = *PrefixFound + OldName;
-		UEditorUtilityLibrary::RenameAsset(SelectedObject, NewNameWithPrefix);
-		++Counter;
+		BatchRenamer.AddRename(SelectedAssetData, *PrefixFound + OldName);
+	}
+	if (BatchRenamer.GetRows().Num() == 0) return;
+
+	const int32 CollisionCounter = BatchRenamer.DetectCollisions();
+	if (CollisionCounter > 0)
+	{
+		BatchRenamer.LogPreviewTable();
+		DebugHeader::Print(FString::FromInt(CollisionCounter) + TEXT(" assets can not be prefixed, check the output log"), FColor::Red);
 	}
+	const int32 Counter = BatchRenamer.Submit();
 	if (Counter > 0)
 	{
 		DebugHeader::ShowNInfo(TEXT("Successfully renamed " + FString::FromInt(Counter) + " assets"));
 	}
 }
 
+const TMap<FTopLevelAssetPath, FString>& UQuickAssetAction::GetPrefixMapByClassPath()
+{
+	if (PrefixMapByClassPath.Num() == 0)
+	{
+		for (const TPair<UClass*, FString>& PrefixPair : PrefixMap)
+		{
+			if (!PrefixPair.Key) continue;
+			PrefixMapByClassPath.Add(PrefixPair.Key->GetClassPathName(), PrefixPair.Value);
+		}
+	}
+	return PrefixMapByClassPath;
+}
+
 void UQuickAssetAction::RemoveUnusedAssets()
 {
 
@@ -129,11 +219,11 @@ void UQuickAssetAction::FixUpRedirectors()
 	AssetToolsModule.Get().FixupReferencers(RedirectorsToFixArray);
 }
 
-void UQuickAssetAction::RenameAssets(const FString& NamePattern, const FString& ReplaceWith, bool bPreviewOnly)
+void UQuickAssetAction::RenameAssets(const FString& NamePattern, const FString& ReplaceWith,
+	ERenamePatternMode PatternMode, bool bPreviewOnly)
 {
 	// Get all the selected asset data
 	TArray<FAssetData> SelectedAssetsData = UEditorUtilityLibrary::GetSelectedAssetData();
-	uint32 Counter = 0;
 
 	if (SelectedAssetsData.Num() == 0)
 	{
@@ -141,45 +231,53 @@ void UQuickAssetAction::RenameAssets(const FString& NamePattern, const FString&
 		return;
 	}
 
+	// Compile the pattern once, then plan every rename before touching any asset
+	const FAssetRenamePattern RenamePattern(PatternMode, NamePattern, ReplaceWith);
+	FString PatternError;
+	if (!RenamePattern.IsValid(PatternError))
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("Invalid pattern: ") + PatternError);
+		return;
+	}
+	FBatchAssetRenamer BatchRenamer;
+	int32 MatchCounter = 0;
 	for (const FAssetData& SelectedAssetData : SelectedAssetsData)
 	{
-		FString OldName = SelectedAssetData.AssetName.ToString();
-
-		// Check if the old name matches the pattern (sub-string match)
-		if (OldName.Contains(NamePattern))
+		FString NewName;
+		if (RenamePattern.Apply(SelectedAssetData.AssetName.ToString(), MatchCounter + 1, NewName))
 		{
-			// Generate the new name by replacing the pattern with the provided replacement string
-			FString NewName = OldName.Replace(*NamePattern, *ReplaceWith);
-
-			// Create the new asset path using the updated name
-			FString NewAssetPath = FPaths::Combine(SelectedAssetData.PackagePath.ToString(), NewName);
-
-			// If it's a preview only, just print the names
-			if (bPreviewOnly)
-			{
-				DebugHeader::Print(TEXT("Preview: ") + OldName + TEXT(" would be renamed to ") + NewName, FColor::Yellow);
-			}
-			else
-			{
-				// Attempt to rename the asset
-				if (UEditorAssetLibrary::RenameAsset(SelectedAssetData.ObjectPath.ToString(), NewAssetPath))
-				{
-					++Counter;
-					DebugHeader::Print(TEXT("Renamed: ") + OldName + TEXT(" to ") + NewName, FColor::Green);
-				}
-				else
-				{
-					DebugHeader::Print(TEXT("Failed to rename asset: ") + OldName, FColor::Red);
-				}
-			}
+			BatchRenamer.AddRename(SelectedAssetData, NewName);
+			++MatchCounter;
 		}
 	}
+	if (MatchCounter == 0)
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("No selected asset matches the pattern"));
+		return;
+	}
+
+	const int32 CollisionCounter = BatchRenamer.DetectCollisions();
+	BatchRenamer.LogPreviewTable();
+	if (bPreviewOnly)
+	{
+		SAssetRenamePreviewTable::OpenInWindow(BatchRenamer.GetRows(), TEXT("Rename Preview"));
+		return;
+	}
+	if (CollisionCounter > 0)
+	{
+		SAssetRenamePreviewTable::OpenInWindow(BatchRenamer.GetRows(), TEXT("Rename Collisions"));
+		EAppReturnType::Type ConfirmResult = DebugHeader::ShowMsgDialog(EAppMsgType::YesNo,
+			FString::FromInt(CollisionCounter) + TEXT(" assets can not be renamed.\nWould you like to rename the other ")
+			+ FString::FromInt(BatchRenamer.GetNumRenamable()) + TEXT(" assets?"));
+		if (ConfirmResult == EAppReturnType::No) return;
+	}
 
+	const int32 Counter = BatchRenamer.Submit();
 	if (Counter > 0)
 	{
 		DebugHeader::ShowNInfo(TEXT("Successfully renamed " + FString::FromInt(Counter) + " assets"));
 	}
-	else if (!bPreviewOnly)
+	else
 	{
 		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("No assets were renamed"));
 	}
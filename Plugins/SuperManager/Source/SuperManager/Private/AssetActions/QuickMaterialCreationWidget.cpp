@@ -8,6 +8,15 @@
 #include "Materials/MaterialInstanceConstant.h"
 #include "Factories/MaterialInstanceConstantFactoryNew.h"
 #include "Materials/MaterialExpressionTextureSampleParameter2D.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Async/ParallelFor.h"
+#include "Misc/ScopedSlowTask.h"
+#include "MaterialShared.h"
+#include "ShaderCompiler.h"
+#include "AssetActions/OrmTexturePacker.h"
+#include "AssetActions/MaterialParameterSchema.h"
+#include "SlateWidgets/AssetRenamePreviewWidget.h"
+#include "ScopedTransaction.h"
 
 #pragma region QuickMaterialCreationCore
 
@@ -52,6 +61,8 @@ void UQuickMaterialCreationWidget::CreateMaterialFromSelectedTextures()
 		// 	CreateMaterialInstanceAsset(CreatedMaterial, MaterialName, SelectedTextureFolderPath);
 		// }
 	}
+	//The graph is complete, compile it once
+	RequestMaterialCompile(CreatedMaterial);
 
 	MaterialName = TEXT("M_");
 }
@@ -123,103 +134,43 @@ UMaterial* UQuickMaterialCreationWidget::CreateMaterialAsset(const FString& Name
 void UQuickMaterialCreationWidget::Default_CreateMaterialNodes(UMaterial* CreatedMaterial,
 	UTexture2D* SelectedTexture, uint32& PinsConnectedCounter)
 {
-	if (bUseParameterizedTextures)
+	const E_TextureRole TextureRole = ClassifyTexture(SelectedTexture->GetName());
+	if (TextureRole == E_TextureRole::ETR_MAX)
 	{
-		UMaterialExpressionTextureSampleParameter2D* TextureParameterNode =
-			NewObject<UMaterialExpressionTextureSampleParameter2D>(CreatedMaterial);
-		if (!TextureParameterNode) return;
-
-		if (!CreatedMaterial->HasBaseColorConnected())
-		{
-			if (TryConnectBaseColor(TextureParameterNode, SelectedTexture, CreatedMaterial))
-			{
-				PinsConnectedCounter++;
-				return;
-			}
-		}
+		DebugHeader::Print(TEXT("Failed to connect the texture: ") + SelectedTexture->GetName(), FColor::Red);
+		return;
+	}
 
-		if (!CreatedMaterial->HasMetallicConnected())
-		{
-			if (TryConnectMetalic(TextureParameterNode, SelectedTexture, CreatedMaterial))
-			{
-				PinsConnectedCounter++;
-				return;
-			}
-		}
+	UMaterialExpressionTextureSample* TextureSampleNode = bUseParameterizedTextures ?
+		NewObject<UMaterialExpressionTextureSampleParameter2D>(CreatedMaterial) :
+		NewObject<UMaterialExpressionTextureSample>(CreatedMaterial);
+	if (!TextureSampleNode) return;
 
-		if (!CreatedMaterial->HasRoughnessConnected())
-		{
-			if (TryConnectRoughness(TextureParameterNode, SelectedTexture, CreatedMaterial))
-			{
-				PinsConnectedCounter++;
-				return;
-			}
-		}
-		if (!CreatedMaterial->HasNormalConnected())
-		{
-			if (TryConnectNormal(TextureParameterNode, SelectedTexture, CreatedMaterial))
-			{
-				PinsConnectedCounter++;
-				return;
-			}
-		}
-		if (!CreatedMaterial->HasAmbientOcclusionConnected())
-		{
-			if (TryConnectAO(TextureParameterNode, SelectedTexture, CreatedMaterial))
-			{
-				PinsConnectedCounter++;
-				return;
-			}
-		}
+	bool bConnected = false;
+	switch (TextureRole)
+	{
+	case E_TextureRole::ETR_BaseColor:
+		bConnected = !CreatedMaterial->HasBaseColorConnected() && TryConnectBaseColor(TextureSampleNode, SelectedTexture, CreatedMaterial);
+		break;
+	case E_TextureRole::ETR_Metallic:
+		bConnected = !CreatedMaterial->HasMetallicConnected() && TryConnectMetalic(TextureSampleNode, SelectedTexture, CreatedMaterial);
+		break;
+	case E_TextureRole::ETR_Roughness:
+		bConnected = !CreatedMaterial->HasRoughnessConnected() && TryConnectRoughness(TextureSampleNode, SelectedTexture, CreatedMaterial);
+		break;
+	case E_TextureRole::ETR_Normal:
+		bConnected = !CreatedMaterial->HasNormalConnected() && TryConnectNormal(TextureSampleNode, SelectedTexture, CreatedMaterial);
+		break;
+	case E_TextureRole::ETR_AmbientOcclusion:
+		bConnected = !CreatedMaterial->HasAmbientOcclusionConnected() && TryConnectAO(TextureSampleNode, SelectedTexture, CreatedMaterial);
+		break;
+	default:
+		break;
 	}
-	else
+	if (bConnected)
 	{
-		UMaterialExpressionTextureSample* TextureSampleNode =
-			NewObject<UMaterialExpressionTextureSample>(CreatedMaterial);
-		if (!TextureSampleNode) return;
-
-		if (!CreatedMaterial->HasBaseColorConnected())
-		{
-			if (TryConnectBaseColor(TextureSampleNode, SelectedTexture, CreatedMaterial))
-			{
-				PinsConnectedCounter++;
-				return;
-			}
-		}
-
-		if (!CreatedMaterial->HasMetallicConnected())
-		{
-			if (TryConnectMetalic(TextureSampleNode, SelectedTexture, CreatedMaterial))
-			{
-				PinsConnectedCounter++;
-				return;
-			}
-		}
-
-		if (!CreatedMaterial->HasRoughnessConnected())
-		{
-			if (TryConnectRoughness(TextureSampleNode, SelectedTexture, CreatedMaterial))
-			{
-				PinsConnectedCounter++;
-				return;
-			}
-		}
-		if (!CreatedMaterial->HasNormalConnected())
-		{
-			if (TryConnectNormal(TextureSampleNode, SelectedTexture, CreatedMaterial))
-			{
-				PinsConnectedCounter++;
-				return;
-			}
-		}
-		if (!CreatedMaterial->HasAmbientOcclusionConnected())
-		{
-			if (TryConnectAO(TextureSampleNode, SelectedTexture, CreatedMaterial))
-			{
-				PinsConnectedCounter++;
-				return;
-			}
-		}
+		PinsConnectedCounter++;
+		return;
 	}
 	DebugHeader::Print(TEXT("Failed to connect the texture: ") + SelectedTexture->GetName(), FColor::Red);
 }
@@ -229,165 +180,130 @@ void UQuickMaterialCreationWidget::Default_CreateMaterialNodes(UMaterial* Create
 bool UQuickMaterialCreationWidget::TryConnectBaseColor(UMaterialExpressionTextureSample* TextureSampleNode,
 	UTexture2D* SelectedTexture, UMaterial* CreatedMaterial)
 {
-	for (const FString& BaseColorName : BaseColorArray)
+	if (UMaterialExpressionTextureSampleParameter2D* ParameterNode = Cast<UMaterialExpressionTextureSampleParameter2D>(TextureSampleNode))
 	{
-		if (SelectedTexture->GetName().Contains(BaseColorName))
-		{
-			if (UMaterialExpressionTextureSampleParameter2D* ParameterNode = Cast<UMaterialExpressionTextureSampleParameter2D>(TextureSampleNode))
-			{
-				ParameterNode->ParameterName = FName(TEXT("BaseColor"));
-				ParameterNode->Texture = SelectedTexture;
-				CreatedMaterial->GetExpressionCollection().AddExpression(ParameterNode);
-				CreatedMaterial->GetExpressionInputForProperty(MP_BaseColor)->Connect(0, ParameterNode);
-			}
-			else
-			{
-				TextureSampleNode->Texture = SelectedTexture;
-				CreatedMaterial->GetExpressionCollection().AddExpression(TextureSampleNode);
-				CreatedMaterial->GetExpressionInputForProperty(MP_BaseColor)->Connect(0, TextureSampleNode);
-			}
-			CreatedMaterial->PostEditChange();
-			TextureSampleNode->MaterialExpressionEditorX -= 600;
-			return true;
-		}
+		ParameterNode->ParameterName = FName(TEXT("BaseColor"));
+		ParameterNode->Texture = SelectedTexture;
+		CreatedMaterial->GetExpressionCollection().AddExpression(ParameterNode);
+		CreatedMaterial->GetExpressionInputForProperty(MP_BaseColor)->Connect(0, ParameterNode);
 	}
-	return false;
+	else
+	{
+		TextureSampleNode->Texture = SelectedTexture;
+		CreatedMaterial->GetExpressionCollection().AddExpression(TextureSampleNode);
+		CreatedMaterial->GetExpressionInputForProperty(MP_BaseColor)->Connect(0, TextureSampleNode);
+	}
+	TextureSampleNode->MaterialExpressionEditorX -= 600;
+	return true;
 }
 
 bool UQuickMaterialCreationWidget::TryConnectMetalic(UMaterialExpressionTextureSample* TextureSampleNode,
 	UTexture2D* SelectedTexture, UMaterial* CreatedMaterial)
 {
-	for (const FString& MetalicName : MetallicArray)
-	{
-		if (SelectedTexture->GetName().Contains(MetalicName))
-		{
-			SelectedTexture->CompressionSettings = TextureCompressionSettings::TC_Default;
-			SelectedTexture->SRGB = false;
-			SelectedTexture->PostEditChange();
+	EnsureLinearTextureSettings(SelectedTexture);
 
-			if (UMaterialExpressionTextureSampleParameter2D* ParameterNode = Cast<UMaterialExpressionTextureSampleParameter2D>(TextureSampleNode))
-			{
-				ParameterNode->ParameterName = FName(TEXT("Metallic"));
-				ParameterNode->Texture = SelectedTexture;
-				ParameterNode->SamplerType = EMaterialSamplerType::SAMPLERTYPE_LinearColor;
-				CreatedMaterial->GetExpressionCollection().AddExpression(ParameterNode);
-				CreatedMaterial->GetExpressionInputForProperty(MP_Metallic)->Connect(0, ParameterNode);
-			}
-			else
-			{
-				TextureSampleNode->Texture = SelectedTexture;
-				TextureSampleNode->SamplerType = EMaterialSamplerType::SAMPLERTYPE_LinearColor;
-				CreatedMaterial->GetExpressionCollection().AddExpression(TextureSampleNode);
-				CreatedMaterial->GetExpressionInputForProperty(MP_Metallic)->Connect(0, TextureSampleNode);
-			}
-			CreatedMaterial->PostEditChange();
-			TextureSampleNode->MaterialExpressionEditorX -= 600;
-			TextureSampleNode->MaterialExpressionEditorY += 240;
-			return true;
-		}
+	if (UMaterialExpressionTextureSampleParameter2D* ParameterNode = Cast<UMaterialExpressionTextureSampleParameter2D>(TextureSampleNode))
+	{
+		ParameterNode->ParameterName = FName(TEXT("Metallic"));
+		ParameterNode->Texture = SelectedTexture;
+		ParameterNode->SamplerType = EMaterialSamplerType::SAMPLERTYPE_LinearColor;
+		CreatedMaterial->GetExpressionCollection().AddExpression(ParameterNode);
+		CreatedMaterial->GetExpressionInputForProperty(MP_Metallic)->Connect(0, ParameterNode);
 	}
-	return false;
+	else
+	{
+		TextureSampleNode->Texture = SelectedTexture;
+		TextureSampleNode->SamplerType = EMaterialSamplerType::SAMPLERTYPE_LinearColor;
+		CreatedMaterial->GetExpressionCollection().AddExpression(TextureSampleNode);
+		CreatedMaterial->GetExpressionInputForProperty(MP_Metallic)->Connect(0, TextureSampleNode);
+	}
+	TextureSampleNode->MaterialExpressionEditorX -= 600;
+	TextureSampleNode->MaterialExpressionEditorY += 240;
+	return true;
 }
 
 bool UQuickMaterialCreationWidget::TryConnectRoughness(UMaterialExpressionTextureSample* TextureSampleNode,
 	UTexture2D* SelectedTexture, UMaterial* CreatedMaterial)
 {
-	for (const FString& RoughnessName : RoughnessArray)
-	{
-		if (SelectedTexture->GetName().Contains(RoughnessName))
-		{
-			SelectedTexture->CompressionSettings = TextureCompressionSettings::TC_Default;
-			SelectedTexture->SRGB = false;
-			SelectedTexture->PostEditChange();
+	EnsureLinearTextureSettings(SelectedTexture);
 
-			if (UMaterialExpressionTextureSampleParameter2D* ParameterNode = Cast<UMaterialExpressionTextureSampleParameter2D>(TextureSampleNode))
-			{
-				ParameterNode->ParameterName = FName(TEXT("Roughness"));
-				ParameterNode->Texture = SelectedTexture;
-				ParameterNode->SamplerType = EMaterialSamplerType::SAMPLERTYPE_LinearColor;
-				CreatedMaterial->GetExpressionCollection().AddExpression(ParameterNode);
-				CreatedMaterial->GetExpressionInputForProperty(MP_Roughness)->Connect(0, ParameterNode);
-			}
-			else
-			{
-				TextureSampleNode->Texture = SelectedTexture;
-				TextureSampleNode->SamplerType = EMaterialSamplerType::SAMPLERTYPE_LinearColor;
-				CreatedMaterial->GetExpressionCollection().AddExpression(TextureSampleNode);
-				CreatedMaterial->GetExpressionInputForProperty(MP_Roughness)->Connect(0, TextureSampleNode);
-			}
-			CreatedMaterial->PostEditChange();
-			TextureSampleNode->MaterialExpressionEditorX -= 600;
-			TextureSampleNode->MaterialExpressionEditorY += 480;
-			return true;
-		}
+	if (UMaterialExpressionTextureSampleParameter2D* ParameterNode = Cast<UMaterialExpressionTextureSampleParameter2D>(TextureSampleNode))
+	{
+		ParameterNode->ParameterName = FName(TEXT("Roughness"));
+		ParameterNode->Texture = SelectedTexture;
+		ParameterNode->SamplerType = EMaterialSamplerType::SAMPLERTYPE_LinearColor;
+		CreatedMaterial->GetExpressionCollection().AddExpression(ParameterNode);
+		CreatedMaterial->GetExpressionInputForProperty(MP_Roughness)->Connect(0, ParameterNode);
 	}
-	return false;
+	else
+	{
+		TextureSampleNode->Texture = SelectedTexture;
+		TextureSampleNode->SamplerType = EMaterialSamplerType::SAMPLERTYPE_LinearColor;
+		CreatedMaterial->GetExpressionCollection().AddExpression(TextureSampleNode);
+		CreatedMaterial->GetExpressionInputForProperty(MP_Roughness)->Connect(0, TextureSampleNode);
+	}
+	TextureSampleNode->MaterialExpressionEditorX -= 600;
+	TextureSampleNode->MaterialExpressionEditorY += 480;
+	return true;
 }
 
 bool UQuickMaterialCreationWidget::TryConnectNormal(UMaterialExpressionTextureSample* TextureSampleNode,
 	UTexture2D* SelectedTexture, UMaterial* CreatedMaterial)
 {
-	for (const FString& NormalName : NormalArray)
+	if (UMaterialExpressionTextureSampleParameter2D* ParameterNode = Cast<UMaterialExpressionTextureSampleParameter2D>(TextureSampleNode))
 	{
-		if (SelectedTexture->GetName().Contains(NormalName))
-		{
-			if (UMaterialExpressionTextureSampleParameter2D* ParameterNode = Cast<UMaterialExpressionTextureSampleParameter2D>(TextureSampleNode))
-			{
-				ParameterNode->ParameterName = FName(TEXT("Normal"));
-				ParameterNode->Texture = SelectedTexture;
-				ParameterNode->SamplerType = EMaterialSamplerType::SAMPLERTYPE_Normal;
-				CreatedMaterial->GetExpressionCollection().AddExpression(ParameterNode);
-				CreatedMaterial->GetExpressionInputForProperty(MP_Normal)->Connect(0, ParameterNode);
-			}
-			else
-			{
-				TextureSampleNode->Texture = SelectedTexture;
-				TextureSampleNode->SamplerType = EMaterialSamplerType::SAMPLERTYPE_Normal;
-				CreatedMaterial->GetExpressionCollection().AddExpression(TextureSampleNode);
-				CreatedMaterial->GetExpressionInputForProperty(MP_Normal)->Connect(0, TextureSampleNode);
-			}
-			CreatedMaterial->PostEditChange();
-			TextureSampleNode->MaterialExpressionEditorX -= 600;
-			TextureSampleNode->MaterialExpressionEditorY += 720;
-			return true;
-		}
+		ParameterNode->ParameterName = FName(TEXT("Normal"));
+		ParameterNode->Texture = SelectedTexture;
+		ParameterNode->SamplerType = EMaterialSamplerType::SAMPLERTYPE_Normal;
+		CreatedMaterial->GetExpressionCollection().AddExpression(ParameterNode);
+		CreatedMaterial->GetExpressionInputForProperty(MP_Normal)->Connect(0, ParameterNode);
 	}
-	return false;
+	else
+	{
+		TextureSampleNode->Texture = SelectedTexture;
+		TextureSampleNode->SamplerType = EMaterialSamplerType::SAMPLERTYPE_Normal;
+		CreatedMaterial->GetExpressionCollection().AddExpression(TextureSampleNode);
+		CreatedMaterial->GetExpressionInputForProperty(MP_Normal)->Connect(0, TextureSampleNode);
+	}
+	TextureSampleNode->MaterialExpressionEditorX -= 600;
+	TextureSampleNode->MaterialExpressionEditorY += 720;
+	return true;
+}
+
+//Only touch textures whose settings differ, every PostEditChange rebuilds the texture
+void UQuickMaterialCreationWidget::EnsureLinearTextureSettings(UTexture2D* SelectedTexture)
+{
+	if (SelectedTexture->CompressionSettings == TextureCompressionSettings::TC_Default && !SelectedTexture->SRGB) return;
+
+	DebugHeader::PrtLog(SelectedTexture->GetName() + TEXT(" switched to default compression with sRGB off"));
+	SelectedTexture->CompressionSettings = TextureCompressionSettings::TC_Default;
+	SelectedTexture->SRGB = false;
+	SelectedTexture->PostEditChange();
 }
 
 bool UQuickMaterialCreationWidget::TryConnectAO(UMaterialExpressionTextureSample* TextureSampleNode,
 	UTexture2D* SelectedTexture, UMaterial* CreatedMaterial)
 {
-	for (const FString& AOName : AmbientOcclusionArray)
-	{
-		if (SelectedTexture->GetName().Contains(AOName))
-		{
-			SelectedTexture->CompressionSettings = TextureCompressionSettings::TC_Default;
-			SelectedTexture->SRGB = false;
-			SelectedTexture->PostEditChange();
+	EnsureLinearTextureSettings(SelectedTexture);
 
-			if (UMaterialExpressionTextureSampleParameter2D* ParameterNode = Cast<UMaterialExpressionTextureSampleParameter2D>(TextureSampleNode))
-			{
-				ParameterNode->ParameterName = FName(TEXT("AmbientOcclusion"));
-				ParameterNode->Texture = SelectedTexture;
-				ParameterNode->SamplerType = EMaterialSamplerType::SAMPLERTYPE_LinearColor;
-				CreatedMaterial->GetExpressionCollection().AddExpression(ParameterNode);
-				CreatedMaterial->GetExpressionInputForProperty(MP_AmbientOcclusion)->Connect(0, ParameterNode);
-			}
-			else
-			{
-				TextureSampleNode->Texture = SelectedTexture;
-				TextureSampleNode->SamplerType = EMaterialSamplerType::SAMPLERTYPE_LinearColor;
-				CreatedMaterial->GetExpressionCollection().AddExpression(TextureSampleNode);
-				CreatedMaterial->GetExpressionInputForProperty(MP_AmbientOcclusion)->Connect(0, TextureSampleNode);
-			}
-			CreatedMaterial->PostEditChange();
-			TextureSampleNode->MaterialExpressionEditorX -= 600;
-			TextureSampleNode->MaterialExpressionEditorY += 960;
-			return true;
-		}
+	if (UMaterialExpressionTextureSampleParameter2D* ParameterNode = Cast<UMaterialExpressionTextureSampleParameter2D>(TextureSampleNode))
+	{
+		ParameterNode->ParameterName = FName(TEXT("AmbientOcclusion"));
+		ParameterNode->Texture = SelectedTexture;
+		ParameterNode->SamplerType = EMaterialSamplerType::SAMPLERTYPE_LinearColor;
+		CreatedMaterial->GetExpressionCollection().AddExpression(ParameterNode);
+		CreatedMaterial->GetExpressionInputForProperty(MP_AmbientOcclusion)->Connect(0, ParameterNode);
 	}
-	return false;
+	else
+	{
+		TextureSampleNode->Texture = SelectedTexture;
+		TextureSampleNode->SamplerType = EMaterialSamplerType::SAMPLERTYPE_LinearColor;
+		CreatedMaterial->GetExpressionCollection().AddExpression(TextureSampleNode);
+		CreatedMaterial->GetExpressionInputForProperty(MP_AmbientOcclusion)->Connect(0, TextureSampleNode);
+	}
+	TextureSampleNode->MaterialExpressionEditorX -= 600;
+	TextureSampleNode->MaterialExpressionEditorY += 960;
+	return true;
 }
 
 UMaterialInstanceConstant* UQuickMaterialCreationWidget::CreateMaterialInstanceAsset(UMaterial* CreatedMaterial,
@@ -403,7 +319,6 @@ UMaterialInstanceConstant* UQuickMaterialCreationWidget::CreateMaterialInstanceA
 	{
 		CreatedMI->SetParentEditorOnly(CreatedMaterial);
 		CreatedMI->PostEditChange();
-		CreatedMaterial->PostEditChange();
 		return CreatedMI;
 	}
 	return nullptr;
@@ -456,7 +371,7 @@ void UQuickMaterialCreationWidget::CreateMaterialInstanceFromParent()
 		return;
 	}
 
-	if (CreateMaterialInstanceFromSelectedTextures(ParentMaterial, SelectedTexturesArray, SelectedTextureFolderPath))
+	if (CreateMaterialInstanceFromSelectedTextures(ParentMaterial, SelectedTexturesArray, SelectedTextureFolderPath, MaterialName))
 	{
 		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("Successfully created material instance"));
 	}
@@ -469,11 +384,12 @@ void UQuickMaterialCreationWidget::CreateMaterialInstanceFromParent()
 }
 
 bool UQuickMaterialCreationWidget::CreateMaterialInstanceFromSelectedTextures(UMaterialInterface* ParentMat,
-	const TArray<UTexture2D*>& SelectedTextures, const FString& TargetPath)
+	const TArray<UTexture2D*>& SelectedTextures, const FString& TargetPath, const FString& NameOfTheMaterial,
+	UTexture2D* PackedOrmTexture)
 {
 	if (!ParentMat || SelectedTextures.Num() == 0) return false;
 
-	FString NewMIName = MaterialName;
+	FString NewMIName = NameOfTheMaterial;
 	NewMIName.RemoveFromStart(TEXT("M_"));
 	NewMIName.InsertAt(0, TEXT("MI_"));
 
@@ -487,76 +403,602 @@ bool UQuickMaterialCreationWidget::CreateMaterialInstanceFromSelectedTextures(UM
 	{
 		CreatedMI->SetParentEditorOnly(ParentMat);
 
-		// Try to set texture parameters based on texture names
+		// Bind textures to the parent's parameters through its cached schema
+		const FMaterialParameterSchema& ParameterSchema = GetParameterSchema(ParentMat);
+		if (PackedOrmTexture && !ParameterSchema.FindPackedOrmSlot()) PackedOrmTexture = nullptr;
 		for (UTexture2D* SelectedTexture : SelectedTextures)
 		{
 			if (!SelectedTexture) continue;
 
-			for (const FString& BaseColorName : BaseColorArray)
-			{
-				if (SelectedTexture->GetName().Contains(BaseColorName))
-				{
-					TrySetTextureParameter(CreatedMI, TEXT("BC_Tex"), SelectedTexture);
-					break;
-				}
-			}
+			const E_TextureRole TextureRole = ClassifyTexture(SelectedTexture->GetName());
+			if (TextureRole == E_TextureRole::ETR_MAX) continue;
+			//Channels already live in the packed texture
+			if (PackedOrmTexture && TextureRole != E_TextureRole::ETR_BaseColor && TextureRole != E_TextureRole::ETR_Normal) continue;
+			BindTextureParameter(CreatedMI, ParameterSchema.FindSlotForRole(TextureRole), SelectedTexture);
+		}
+		if (PackedOrmTexture)
+		{
+			BindTextureParameter(CreatedMI, ParameterSchema.FindPackedOrmSlot(), PackedOrmTexture);
+		}
 
-			for (const FString& MetallicName : MetallicArray)
-			{
-				if (SelectedTexture->GetName().Contains(MetallicName))
-				{
-					TrySetTextureParameter(CreatedMI, TEXT("VT_ORM"), SelectedTexture);
-					break;
-				}
-			}
+		CreatedMI->PostEditChange();
+		return true;
+	}
+
+	return false;
+}
+
+void UQuickMaterialCreationWidget::BindTextureParameter(UMaterialInstanceConstant* MaterialInstance,
+	const FTextureParameterSlot* ParameterSlot, UTexture2D* Texture)
+{
+	if (!MaterialInstance || !ParameterSlot || !Texture) return;
+
+	//The parent already provides this texture, an override would only add an entry
+	if (ParameterSlot->DefaultTexture.Get() == Texture) return;
+
+	if (ParameterSlot->SamplerType == SAMPLERTYPE_Normal && Texture->CompressionSettings != TC_Normalmap)
+	{
+		DebugHeader::PrtLog(Texture->GetName() + TEXT(" is bound to normal map parameter ") +
+			ParameterSlot->ParameterName.ToString() + TEXT(" but is not compressed as a normal map"));
+	}
+	MaterialInstance->SetTextureParameterValueEditorOnly(FMaterialParameterInfo(ParameterSlot->ParameterName), Texture);
+}
+
+#pragma region BulkParameterEditing
+void UQuickMaterialCreationWidget::EditParametersOfMaterialInstances()
+{
+	if (BulkParameterName.IsNone())
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("Please enter a parameter name"));
+		return;
+	}
+	//Blueprints can still pass the hidden _MAX values, which index past the per-type tables
+	if (BulkOperation >= E_BulkParameterOperation::EBPO_MAX || BulkParameterType >= E_BulkParameterType::EBPT_MAX)
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("Please choose a parameter type and operation"));
+		return;
+	}
+	if (BulkOperation == E_BulkParameterOperation::EBPO_Offset && BulkParameterType == E_BulkParameterType::EBPT_Texture)
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("Texture parameters can only be set or cleared"));
+		return;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	TArray<FAssetData> InstancesData;
+	GatherBulkEditTargets(InstancesData);
+	if (InstancesData.Num() == 0)
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("No material instance to edit"));
+		return;
+	}
+
+	TArray<UMaterialInstanceConstant*> ChangedInstances;
+	TArray< TSharedPtr <FAssetRenamePreviewRow> > ChangedRows;
+	{
+		FScopedTransaction BulkEditTransaction(FText::FromString(TEXT("Bulk Edit Material Instance Parameters")));
+		FScopedSlowTask EditTask(InstancesData.Num(), FText::FromString(TEXT("Editing material instance parameters")));
+		EditTask.MakeDialog(true);
+		for (const FAssetData& InstanceData : InstancesData)
+		{
+			EditTask.EnterProgressFrame();
+			if (EditTask.ShouldCancel()) break;
+			UMaterialInstanceConstant* MaterialInstance = Cast<UMaterialInstanceConstant>(InstanceData.GetAsset());
+			FString ChangeDescription;
+			if (!MaterialInstance || !ApplyBulkEdit(MaterialInstance, ChangeDescription)) continue;
+
+			ChangedInstances.Add(MaterialInstance);
+			TSharedPtr<FAssetRenamePreviewRow> Row = MakeShared<FAssetRenamePreviewRow>();
+			Row->AssetData = InstanceData;
+			Row->NewName = ChangeDescription;
+			Row->Status = TEXT("Changed");
+			Row->bCanRename = true;
+			ChangedRows.Add(Row);
+		}
+
+		//One PostEditChange per changed instance, naming the parameter array so static permutations are left alone,
+		//and one update context so render state is refreshed once for the whole batch
+		static const FName ChangedPropertyNames[] = { GET_MEMBER_NAME_CHECKED(UMaterialInstance, ScalarParameterValues),
+			GET_MEMBER_NAME_CHECKED(UMaterialInstance, VectorParameterValues), GET_MEMBER_NAME_CHECKED(UMaterialInstance, TextureParameterValues) };
+		FProperty* ChangedProperty =
+			FindFProperty<FProperty>(UMaterialInstance::StaticClass(), ChangedPropertyNames[(int32)BulkParameterType]);
+		FMaterialUpdateContext UpdateContext;
+		for (UMaterialInstanceConstant* ChangedInstance : ChangedInstances)
+		{
+			FPropertyChangedEvent ChangedEvent(ChangedProperty, EPropertyChangeType::ValueSet);
+			ChangedInstance->PostEditChangeProperty(ChangedEvent);
+			UpdateContext.AddMaterialInstance(ChangedInstance);
+		}
+	}
 
-			for (const FString& RoughnessName : RoughnessArray)
+	DebugHeader::PrtLog(FString::Printf(TEXT("Bulk edited %s on %d of %d material instances in %.3f seconds"),
+		*BulkParameterName.ToString(), ChangedInstances.Num(), InstancesData.Num(), FPlatformTime::Seconds() - StartTime));
+	if (ChangedRows.Num() > 0)
+	{
+		SAssetRenamePreviewTable::OpenInWindow(ChangedRows, TEXT("Changed Material Instances"), TEXT("Change"));
+	}
+	DebugHeader::ShowNInfo(FString::Printf(TEXT("Changed %d of %d material instances"), ChangedInstances.Num(), InstancesData.Num()));
+}
+
+void UQuickMaterialCreationWidget::GatherBulkEditTargets(TArray<FAssetData>& OutInstancesData) const
+{
+	const FTopLevelAssetPath InstanceClassPath = UMaterialInstanceConstant::StaticClass()->GetClassPathName();
+	if (bBulkEditSelectedInstances)
+	{
+		for (const FAssetData& SelectedData : UEditorUtilityLibrary::GetSelectedAssetData())
+		{
+			if (SelectedData.AssetClassPath == InstanceClassPath) OutInstancesData.Add(SelectedData);
+		}
+		return;
+	}
+
+	IAssetRegistry& AssetRegistry =
+		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	FARFilter Filter;
+	Filter.PackagePaths.Add(FName(*BulkQueryFolder));
+	Filter.bRecursivePaths = true;
+	Filter.ClassPaths.Add(InstanceClassPath);
+	AssetRegistry.GetAssets(Filter, OutInstancesData);
+	if (!BulkQueryParent) return;
+
+	//The parent is a searchable tag, instances of other parents are never loaded
+	const FSoftObjectPath ParentPath(BulkQueryParent);
+	OutInstancesData.RemoveAll([&ParentPath](const FAssetData& InstanceData)
+		{
+			FString ParentTagValue;
+			if (!InstanceData.GetTagValue(GET_MEMBER_NAME_CHECKED(UMaterialInstance, Parent), ParentTagValue)) return true;
+			return FSoftObjectPath(FPackageName::ExportTextPathToObjectPath(ParentTagValue)) != ParentPath;
+		});
+}
+
+//Returns true only if the override actually changed, unknown parameters are never added as overrides
+bool UQuickMaterialCreationWidget::ApplyBulkEdit(UMaterialInstanceConstant* MaterialInstance, FString& OutChangeDescription) const
+{
+	const FName ParameterName = BulkParameterName;
+	const FMaterialParameterInfo ParameterInfo(ParameterName);
+	auto IsTargetParameter = [&ParameterInfo](const auto& ParameterValue) { return ParameterValue.ParameterInfo == ParameterInfo; };
+
+	if (BulkOperation == E_BulkParameterOperation::EBPO_Clear)
+	{
+		bool bHasOverride = false;
+		switch (BulkParameterType)
+		{
+		case E_BulkParameterType::EBPT_Scalar: bHasOverride = MaterialInstance->ScalarParameterValues.ContainsByPredicate(IsTargetParameter); break;
+		case E_BulkParameterType::EBPT_Vector: bHasOverride = MaterialInstance->VectorParameterValues.ContainsByPredicate(IsTargetParameter); break;
+		case E_BulkParameterType::EBPT_Texture: bHasOverride = MaterialInstance->TextureParameterValues.ContainsByPredicate(IsTargetParameter); break;
+		default: break;
+		}
+		if (!bHasOverride) return false;
+
+		MaterialInstance->Modify();
+		MaterialInstance->ScalarParameterValues.RemoveAll([&](const FScalarParameterValue& Value)
+			{ return BulkParameterType == E_BulkParameterType::EBPT_Scalar && IsTargetParameter(Value); });
+		MaterialInstance->VectorParameterValues.RemoveAll([&](const FVectorParameterValue& Value)
+			{ return BulkParameterType == E_BulkParameterType::EBPT_Vector && IsTargetParameter(Value); });
+		MaterialInstance->TextureParameterValues.RemoveAll([&](const FTextureParameterValue& Value)
+			{ return BulkParameterType == E_BulkParameterType::EBPT_Texture && IsTargetParameter(Value); });
+		OutChangeDescription = TEXT("Override cleared");
+		return true;
+	}
+
+	const bool bOffset = BulkOperation == E_BulkParameterOperation::EBPO_Offset;
+	switch (BulkParameterType)
+	{
+	case E_BulkParameterType::EBPT_Scalar:
+	{
+		float CurrentValue = 0.f;
+		if (!MaterialInstance->GetScalarParameterValue(ParameterInfo, CurrentValue)) return false;
+		const bool bHasOverride = MaterialInstance->ScalarParameterValues.ContainsByPredicate(IsTargetParameter);
+		const float NewValue = bOffset ? CurrentValue + BulkScalarValue : BulkScalarValue;
+		if (bHasOverride && NewValue == CurrentValue) return false;
+		MaterialInstance->Modify();
+		MaterialInstance->SetScalarParameterValueEditorOnly(ParameterInfo, NewValue);
+		OutChangeDescription = FString::Printf(TEXT("%g -> %g"), CurrentValue, NewValue);
+		return true;
+	}
+	case E_BulkParameterType::EBPT_Vector:
+	{
+		FLinearColor CurrentValue;
+		if (!MaterialInstance->GetVectorParameterValue(ParameterInfo, CurrentValue)) return false;
+		const bool bHasOverride = MaterialInstance->VectorParameterValues.ContainsByPredicate(IsTargetParameter);
+		const FLinearColor NewValue = bOffset ? CurrentValue + BulkVectorValue : BulkVectorValue;
+		if (bHasOverride && NewValue == CurrentValue) return false;
+		MaterialInstance->Modify();
+		MaterialInstance->SetVectorParameterValueEditorOnly(ParameterInfo, NewValue);
+		OutChangeDescription = CurrentValue.ToString() + TEXT(" -> ") + NewValue.ToString();
+		return true;
+	}
+	case E_BulkParameterType::EBPT_Texture:
+	{
+		UTexture* CurrentValue = nullptr;
+		if (!MaterialInstance->GetTextureParameterValue(ParameterInfo, CurrentValue)) return false;
+		const bool bHasOverride = MaterialInstance->TextureParameterValues.ContainsByPredicate(IsTargetParameter);
+		if (bHasOverride && BulkTextureValue == CurrentValue) return false;
+		MaterialInstance->Modify();
+		MaterialInstance->SetTextureParameterValueEditorOnly(ParameterInfo, BulkTextureValue);
+		OutChangeDescription = GetNameSafe(CurrentValue) + TEXT(" -> ") + GetNameSafe(BulkTextureValue);
+		return true;
+	}
+	default:
+		return false;
+	}
+}
+#pragma endregion
+
+#pragma region ParentParameterSchema
+//Walks the parent's parameter tables once, later instances of the same parent bind through the cached result
+const FMaterialParameterSchema& UQuickMaterialCreationWidget::GetParameterSchema(UMaterialInterface* ParentMat)
+{
+	FMaterialParameterSchemaCache& SchemaCache = FMaterialParameterSchemaCache::Get();
+	const uint32 ClassifierHash = GetRoleClassifier().GetSourceHash();
+	if (const FMaterialParameterSchema* CachedSchema = SchemaCache.Find(ParentMat, ClassifierHash))
+	{
+		return *CachedSchema;
+	}
+
+	FMaterialParameterSchema ParameterSchema;
+	ParameterSchema.ClassifierHash = ClassifierHash;
+	for (UMaterialInterface* ChainMaterial = ParentMat; ChainMaterial; )
+	{
+		ParameterSchema.SourcePackageNames.AddUnique(ChainMaterial->GetPackage()->GetFName());
+		UMaterialInstance* ChainInstance = Cast<UMaterialInstance>(ChainMaterial);
+		ChainMaterial = ChainInstance ? ChainInstance->Parent.Get() : nullptr;
+	}
+
+	TMap<FName, EMaterialSamplerType> SamplerTypeByName;
+	if (UMaterial* BaseMaterial = ParentMat->GetMaterial())
+	{
+		for (const UMaterialExpression* Expression : BaseMaterial->GetExpressions())
+		{
+			if (const UMaterialExpressionTextureSampleParameter* ParameterNode = Cast<UMaterialExpressionTextureSampleParameter>(Expression))
 			{
-				if (SelectedTexture->GetName().Contains(RoughnessName))
-				{
-					TrySetTextureParameter(CreatedMI, TEXT("Roughness"), SelectedTexture);
-					break;
-				}
+				SamplerTypeByName.Add(ParameterNode->ParameterName, ParameterNode->SamplerType);
 			}
+		}
+	}
+
+	TMap<FMaterialParameterInfo, FMaterialParameterMetadata> TextureParameters;
+	ParentMat->GetAllParametersOfType(EMaterialParameterType::Texture, TextureParameters);
+	TArray<FName> ParameterNames;
+	for (const TPair<FMaterialParameterInfo, FMaterialParameterMetadata>& TextureParameter : TextureParameters)
+	{
+		//Layer parameters can not be set through a plain parameter name
+		if (TextureParameter.Key.Association != EMaterialParameterAssociation::GlobalParameter) continue;
+		FTextureParameterSlot& ParameterSlot = ParameterSchema.TextureSlots.Add(TextureParameter.Key.Name);
+		ParameterSlot.ParameterName = TextureParameter.Key.Name;
+		ParameterSlot.DefaultTexture = static_cast<UTexture*>(TextureParameter.Value.Value.Texture);
+		if (const EMaterialSamplerType* SamplerType = SamplerTypeByName.Find(ParameterSlot.ParameterName))
+		{
+			ParameterSlot.SamplerType = *SamplerType;
+		}
+
+		const FString ParameterName = ParameterSlot.ParameterName.ToString();
+		//ORM has to be a whole upper case token, a plain substring test also finds it in "Normal"
+		TArray<FString> ParameterNameTokens;
+		ParameterName.ParseIntoArray(ParameterNameTokens, TEXT("_"));
+		if (ParameterNameTokens.ContainsByPredicate([](const FString& Token) { return Token.Equals(TEXT("ORM"), ESearchCase::CaseSensitive); }))
+		{
+			ParameterSlot.bExpectsPackedOrm = true;
+		}
+		else
+		{
+			//Parameter names rarely carry the leading separator the texture suffixes have
+			FString UnusedStem;
+			ParameterSlot.ExpectedRole = ClassifyTextureName(GetRoleClassifier(), TEXT("_") + ParameterName, UnusedStem);
+		}
+		if (ParameterSlot.ExpectedRole == E_TextureRole::ETR_MAX && ParameterSlot.SamplerType == SAMPLERTYPE_Normal)
+		{
+			ParameterSlot.ExpectedRole = E_TextureRole::ETR_Normal;
+		}
+		ParameterNames.Add(ParameterSlot.ParameterName);
+	}
+
+	//First parameter in name order wins a role, so the binding does not depend on map order
+	ParameterNames.Sort(FNameLexicalLess());
+	for (const FName& ParameterName : ParameterNames)
+	{
+		const FTextureParameterSlot& ParameterSlot = ParameterSchema.TextureSlots[ParameterName];
+		if (ParameterSlot.bExpectsPackedOrm && ParameterSchema.PackedOrmParameterName.IsNone())
+		{
+			ParameterSchema.PackedOrmParameterName = ParameterName;
+		}
+		if (ParameterSlot.ExpectedRole == E_TextureRole::ETR_MAX) continue;
+		FName& RoleParameterName = ParameterSchema.ParameterNameByRole[(int32)ParameterSlot.ExpectedRole];
+		if (RoleParameterName.IsNone())
+		{
+			RoleParameterName = ParameterName;
+		}
+	}
+
+	//Parents built for the original hard coded names keep binding the same way
+	static const FName LegacyParameterNames[] = { TEXT("BC_Tex"), TEXT("VT_ORM"), TEXT("Roughness"), TEXT("Normal"), TEXT("AmbientOcclusion") };
+	for (int32 RoleIndex = 0; RoleIndex < (int32)E_TextureRole::ETR_MAX; ++RoleIndex)
+	{
+		if (!ParameterSchema.ParameterNameByRole[RoleIndex].IsNone()) continue;
+		if (!ParameterSchema.TextureSlots.Contains(LegacyParameterNames[RoleIndex])) continue;
+		ParameterSchema.ParameterNameByRole[RoleIndex] = LegacyParameterNames[RoleIndex];
+	}
+
+	DebugHeader::PrtLog(FString::Printf(TEXT("Built parameter schema of %s with %d texture parameters"),
+		*ParentMat->GetName(), ParameterSchema.TextureSlots.Num()));
+	return SchemaCache.Add(ParentMat, MoveTemp(ParameterSchema));
+}
+#pragma endregion
+
+#pragma region BatchMaterialCreation
+
+void UQuickMaterialCreationWidget::CreateMaterialsFromTextureFolder()
+{
+	if (bCreateInstancesForSets && !ParentMaterial)
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("Please select a parent material"));
+		return;
+	}
+	const double StartTime = FPlatformTime::Seconds();
+	IAssetRegistry& AssetRegistry =
+		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	FARFilter TextureFilter;
+	TextureFilter.PackagePaths.Add(FName(*TextureSetFolder));
+	TextureFilter.bRecursivePaths = bSearchSubFolders;
+	TextureFilter.ClassPaths.Add(UTexture2D::StaticClass()->GetClassPathName());
+	TArray<FAssetData> TexturesData;
+	AssetRegistry.GetAssets(TextureFilter, TexturesData);
+	if (TexturesData.Num() == 0)
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("No texture found under ") + TextureSetFolder);
+		return;
+	}
+
+	TArray<FTextureSet> TextureSets;
+	GroupTexturesIntoSets(TexturesData, TextureSets);
+	if (TextureSets.Num() == 0)
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("No texture matches the supported texture names"));
+		return;
+	}
+
+	//Every package name already used in the folders we create into, looked up in O(1) instead of listing the folder per name
+	FARFilter ExistingFilter;
+	for (const FTextureSet& TextureSet : TextureSets)
+	{
+		ExistingFilter.PackagePaths.AddUnique(TextureSet.PackagePath);
+	}
+	TArray<FAssetData> ExistingAssetsData;
+	AssetRegistry.GetAssets(ExistingFilter, ExistingAssetsData);
+	TSet<FName> UsedPackageNames;
+	for (const FAssetData& ExistingAssetData : ExistingAssetsData)
+	{
+		UsedPackageNames.Add(ExistingAssetData.PackageName);
+	}
 
-			for (const FString& NormalName : NormalArray)
+	uint32 CreatedCounter = 0;
+	uint32 SkippedCounter = 0;
+	TArray<FString> CreatedAssetPaths;
+	bDeferringMaterialCompiles = bDeferCompilationAcrossBatch;
+	//Assets are still created one by one: the registry has no batched AssetCreated, and the content browser queues
+	//those events itself. What is per set stays cheap, saving is left to the user and the browser syncs once below
+	{
+		FScopedSlowTask CreationTask(TextureSets.Num(), FText::FromString(TEXT("Creating materials from texture sets")));
+		CreationTask.MakeDialog(true);
+		for (const FTextureSet& TextureSet : TextureSets)
+		{
+			CreationTask.EnterProgressFrame();
+			if (CreationTask.ShouldCancel()) break;
+
+			const FString NameOfTheMaterial = TEXT("M_") + TextureSet.Stem;
+			const FString NameOfTheAsset = bCreateInstancesForSets ? TEXT("MI_") + TextureSet.Stem : NameOfTheMaterial;
+			const FString NewPackageName = FPaths::Combine(TextureSet.PackagePath.ToString(), NameOfTheAsset);
+			bool bNameUsed = false;
+			UsedPackageNames.Add(FName(*NewPackageName), &bNameUsed);
+			if (bNameUsed)
 			{
-				if (SelectedTexture->GetName().Contains(NormalName))
-				{
-					TrySetTextureParameter(CreatedMI, TEXT("Normal"), SelectedTexture);
-					break;
-				}
+				DebugHeader::PrtLog(NameOfTheAsset + TEXT(" is already used by asset, skipped"));
+				++SkippedCounter;
+				continue;
 			}
-
-			for (const FString& AOName : AmbientOcclusionArray)
+			if (CreateMaterialForTextureSet(TextureSet, NameOfTheMaterial))
 			{
-				if (SelectedTexture->GetName().Contains(AOName))
-				{
-					TrySetTextureParameter(CreatedMI, TEXT("AmbientOcclusion"), SelectedTexture);
-					break;
-				}
+				CreatedAssetPaths.Add(NewPackageName);
+				++CreatedCounter;
 			}
 		}
+	}
 
-		CreatedMI->PostEditChange();
-		ParentMat->PostEditChange();
-		return true;
+	bDeferringMaterialCompiles = false;
+	FlushDeferredMaterialCompiles();
+
+	if (CreatedAssetPaths.Num() > 0)
+	{
+		UEditorAssetLibrary::SyncBrowserToObjects(CreatedAssetPaths);
 	}
+	DebugHeader::PrtLog(FString::Printf(TEXT("Grouped %d textures into %d sets, created %u and skipped %u in %.3f seconds"),
+		TexturesData.Num(), TextureSets.Num(), CreatedCounter, SkippedCounter, FPlatformTime::Seconds() - StartTime));
+	DebugHeader::ShowNInfo(TEXT("Successfully created ") + FString::FromInt(CreatedCounter) +
+		(bCreateInstancesForSets ? TEXT(" material instances") : TEXT(" materials")));
+}
 
-	return false;
+//Returns the role found by the configured suffixes, OutStem is the texture name without prefix and role suffix
+E_TextureRole UQuickMaterialCreationWidget::ClassifyTextureName(const FTextureRoleClassifier& Classifier,
+	FStringView TextureName, FString& OutStem)
+{
+	const FTextureRoleMatch Match = Classifier.Classify(TextureName);
+	if (!Match.IsValid()) return E_TextureRole::ETR_MAX;
+	OutStem = FTextureRoleClassifier::MakeStem(TextureName, Match);
+	return (E_TextureRole)Match.RoleIndex;
 }
 
-void UQuickMaterialCreationWidget::TrySetTextureParameter(UMaterialInstanceConstant* MaterialInstance,
-	const FName ParameterName, UTexture2D* Texture)
+//Compiled once and kept until the supported texture names are edited
+const FTextureRoleClassifier& UQuickMaterialCreationWidget::GetRoleClassifier()
 {
-	if (!MaterialInstance || !Texture) return;
+	if (bRoleClassifierDirty || !RoleClassifier.IsCompiled())
+	{
+		RoleClassifier.Compile({ BaseColorArray, MetallicArray, RoughnessArray, NormalArray, AmbientOcclusionArray });
+		bRoleClassifierDirty = false;
+	}
+	return RoleClassifier;
+}
 
-	FMaterialParameterInfo ParamInfo(ParameterName);
-	UTexture* ExistingTexture = nullptr;
-	MaterialInstance->GetTextureParameterValue(ParamInfo, ExistingTexture);
+#if WITH_EDITOR
+void UQuickMaterialCreationWidget::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+
+	//Array element edits report the array as the member property
+	const FName ChangedPropertyName = PropertyChangedEvent.GetMemberPropertyName();
+	if (ChangedPropertyName == GET_MEMBER_NAME_CHECKED(UQuickMaterialCreationWidget, BaseColorArray) ||
+		ChangedPropertyName == GET_MEMBER_NAME_CHECKED(UQuickMaterialCreationWidget, MetallicArray) ||
+		ChangedPropertyName == GET_MEMBER_NAME_CHECKED(UQuickMaterialCreationWidget, RoughnessArray) ||
+		ChangedPropertyName == GET_MEMBER_NAME_CHECKED(UQuickMaterialCreationWidget, NormalArray) ||
+		ChangedPropertyName == GET_MEMBER_NAME_CHECKED(UQuickMaterialCreationWidget, AmbientOcclusionArray))
+	{
+		bRoleClassifierDirty = true;
+	}
+}
+#endif
 
-	if (ExistingTexture != Texture)
+E_TextureRole UQuickMaterialCreationWidget::ClassifyTexture(const FString& TextureName)
+{
+	const FTextureRoleMatch Match = GetRoleClassifier().Classify(TextureName);
+	if (!Match.IsValid()) return E_TextureRole::ETR_MAX;
+	if (Match.bAmbiguous)
 	{
-		MaterialInstance->SetTextureParameterValueEditorOnly(ParamInfo, Texture);
+		DebugHeader::PrtLog(TextureName + TEXT(" matches several texture roles, using ") +
+			UEnum::GetDisplayValueAsText((E_TextureRole)Match.RoleIndex).ToString());
 	}
-}
\ No newline at end of file
+	return (E_TextureRole)Match.RoleIndex;
+}
+
+void UQuickMaterialCreationWidget::GroupTexturesIntoSets(const TArray<FAssetData>& TexturesData,
+	TArray<FTextureSet>& OutTextureSets)
+{
+	//Classification only reads names through the compiled classifier, so it runs on workers
+	const FTextureRoleClassifier& Classifier = GetRoleClassifier();
+	TArray<E_TextureRole> Roles;
+	TArray<FString> Stems;
+	Roles.SetNum(TexturesData.Num());
+	Stems.SetNum(TexturesData.Num());
+	ParallelFor(TexturesData.Num(), [&Classifier, &TexturesData, &Roles, &Stems](int32 Index)
+		{
+			TStringBuilder<NAME_SIZE> TextureName;
+			TexturesData[Index].AssetName.AppendString(TextureName);
+			Roles[Index] = ClassifyTextureName(Classifier, TextureName.ToView(), Stems[Index]);
+		});
+
+	TMap<FString, int32> SetIndexByKey;
+	for (int32 Index = 0; Index < TexturesData.Num(); ++Index)
+	{
+		if (Roles[Index] == E_TextureRole::ETR_MAX)
+		{
+			DebugHeader::PrtLog(TEXT("Could not classify texture ") + TexturesData[Index].AssetName.ToString());
+			continue;
+		}
+		const FString SetKey = TexturesData[Index].PackagePath.ToString() / Stems[Index];
+		int32& SetIndex = SetIndexByKey.FindOrAdd(SetKey, INDEX_NONE);
+		if (SetIndex == INDEX_NONE)
+		{
+			SetIndex = OutTextureSets.AddDefaulted();
+			OutTextureSets[SetIndex].Stem = Stems[Index];
+			OutTextureSets[SetIndex].PackagePath = TexturesData[Index].PackagePath;
+		}
+		FAssetData& RoleSlot = OutTextureSets[SetIndex].TexturesByRole[(int32)Roles[Index]];
+		if (RoleSlot.IsValid())
+		{
+			DebugHeader::PrtLog(TEXT("Texture ") + TexturesData[Index].AssetName.ToString() +
+				TEXT(" has the same role as ") + RoleSlot.AssetName.ToString() + TEXT(", ignored"));
+			continue;
+		}
+		RoleSlot = TexturesData[Index];
+	}
+}
+
+bool UQuickMaterialCreationWidget::CreateMaterialForTextureSet(const FTextureSet& TextureSet, const FString& NameOfTheMaterial)
+{
+	TArray<UTexture2D*> SetTextures;
+	for (const FAssetData& TextureData : TextureSet.TexturesByRole)
+	{
+		if (!TextureData.IsValid()) continue;
+		if (UTexture2D* Texture = Cast<UTexture2D>(TextureData.GetAsset()))
+		{
+			SetTextures.Add(Texture);
+		}
+	}
+	if (SetTextures.Num() == 0) return false;
+
+	if (bCreateInstancesForSets)
+	{
+		//A parent without a packed ORM parameter takes the channel textures one by one
+		const bool bParentTakesPackedOrm = bPackOrmTextures && ParentMaterial &&
+			GetParameterSchema(ParentMaterial).FindPackedOrmSlot() != nullptr;
+		UTexture2D* PackedOrmTexture = bParentTakesPackedOrm ? PackOrmTextureForSet(TextureSet) : nullptr;
+		return CreateMaterialInstanceFromSelectedTextures(ParentMaterial, SetTextures, TextureSet.PackagePath.ToString(),
+			NameOfTheMaterial, PackedOrmTexture);
+	}
+
+	UMaterial* CreatedMaterial = CreateMaterialAsset(NameOfTheMaterial, TextureSet.PackagePath.ToString());
+	if (!CreatedMaterial) return false;
+	uint32 PinsConnectedCounter = 0;
+	for (UTexture2D* SetTexture : SetTextures)
+	{
+		Default_CreateMaterialNodes(CreatedMaterial, SetTexture, PinsConnectedCounter);
+	}
+	RequestMaterialCompile(CreatedMaterial);
+	return true;
+}
+
+UTexture2D* UQuickMaterialCreationWidget::PackOrmTextureForSet(const FTextureSet& TextureSet)
+{
+	auto LoadRoleTexture = [&TextureSet](E_TextureRole TextureRole) -> UTexture2D*
+		{
+			const FAssetData& TextureData = TextureSet.TexturesByRole[(int32)TextureRole];
+			return TextureData.IsValid() ? Cast<UTexture2D>(TextureData.GetAsset()) : nullptr;
+		};
+
+	UTexture2D* AmbientOcclusionTexture = LoadRoleTexture(E_TextureRole::ETR_AmbientOcclusion);
+	UTexture2D* RoughnessTexture = LoadRoleTexture(E_TextureRole::ETR_Roughness);
+	UTexture2D* MetallicTexture = LoadRoleTexture(E_TextureRole::ETR_Metallic);
+	if (!AmbientOcclusionTexture && !RoughnessTexture && !MetallicTexture) return nullptr;
+
+	return FOrmTexturePacker::CreatePackedTexture(AmbientOcclusionTexture, RoughnessTexture, MetallicTexture,
+		TextureSet.PackagePath.ToString(), TEXT("T_") + TextureSet.Stem + TEXT("_ORM"));
+}
+
+//Compiles right away, or queues the material while a batch defers compilation
+void UQuickMaterialCreationWidget::RequestMaterialCompile(UMaterial* MaterialToCompile)
+{
+	if (!MaterialToCompile) return;
+	if (bDeferringMaterialCompiles)
+	{
+		bool bAlreadyPending = false;
+		PendingCompileMaterialSet.Add(MaterialToCompile, &bAlreadyPending);
+		if (!bAlreadyPending) PendingCompileMaterials.Add(MaterialToCompile);
+		return;
+	}
+	MaterialToCompile->PostEditChange();
+}
+
+//Kicks off every queued compile, then waits on the shader compiling manager once for the whole batch
+void UQuickMaterialCreationWidget::FlushDeferredMaterialCompiles()
+{
+	if (PendingCompileMaterials.Num() == 0) return;
+	const double StartTime = FPlatformTime::Seconds();
+	{
+		FMaterialUpdateContext UpdateContext;
+		for (UMaterial* PendingMaterial : PendingCompileMaterials)
+		{
+			if (!PendingMaterial) continue;
+			PendingMaterial->PostEditChange();
+			UpdateContext.AddMaterial(PendingMaterial);
+		}
+	}
+	const double SubmitTime = FPlatformTime::Seconds();
+	if (GShaderCompilingManager)
+	{
+		GShaderCompilingManager->FinishAllCompilation();
+	}
+	DebugHeader::PrtLog(FString::Printf(TEXT("Deferred compile of %d materials: submitted in %.3f seconds, shaders finished after %.3f seconds"),
+		PendingCompileMaterials.Num(), SubmitTime - StartTime, FPlatformTime::Seconds() - StartTime));
+	PendingCompileMaterials.Empty();
+	PendingCompileMaterialSet.Empty();
+}
+#pragma endregion
@@ -0,0 +1,149 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AssetActions/TextureRoleClassifier.h"
+
+void FTextureRoleClassifier::Compile(const TArray<TArray<FString>>& TokensPerRole)
+{
+	Nodes.Empty();
+	Tokens.Empty();
+	SourceHash = HashTokens(TokensPerRole);
+
+	FNode& Root = Nodes.AddDefaulted_GetRef();
+	FMemory::Memset(Root.Next, 0xff, sizeof(Root.Next));
+
+	//Build the trie of lower case tokens
+	for (int32 RoleIndex = 0; RoleIndex < TokensPerRole.Num(); ++RoleIndex)
+	{
+		for (const FString& TokenString : TokensPerRole[RoleIndex])
+		{
+			if (TokenString.IsEmpty()) continue;
+			int32 NodeIndex = 0;
+			bool bTokenSupported = true;
+			for (const TCHAR Character : TokenString)
+			{
+				const TCHAR LowerCharacter = FChar::ToLower(Character);
+				if (LowerCharacter >= AlphabetSize)
+				{
+					bTokenSupported = false;
+					break;
+				}
+				if (Nodes[NodeIndex].Next[LowerCharacter] == INDEX_NONE)
+				{
+					const int32 NewNodeIndex = Nodes.AddDefaulted();
+					FMemory::Memset(Nodes[NewNodeIndex].Next, 0xff, sizeof(Nodes[NewNodeIndex].Next));
+					Nodes[NodeIndex].Next[LowerCharacter] = NewNodeIndex;
+				}
+				NodeIndex = Nodes[NodeIndex].Next[LowerCharacter];
+			}
+			if (!bTokenSupported) continue;
+			const int32 TokenIndex = Tokens.Add({ RoleIndex, TokenString.Len() });
+			Nodes[NodeIndex].OutputTokens.Add(TokenIndex);
+		}
+	}
+
+	//Breadth first pass turns the trie into a full goto table with failure links merged into the outputs
+	TArray<int32> Queue;
+	for (int32 Character = 0; Character < AlphabetSize; ++Character)
+	{
+		int32& Next = Nodes[0].Next[Character];
+		if (Next == INDEX_NONE)
+		{
+			Next = 0;
+		}
+		else
+		{
+			Nodes[Next].Fail = 0;
+			Queue.Add(Next);
+		}
+	}
+	for (int32 QueueIndex = 0; QueueIndex < Queue.Num(); ++QueueIndex)
+	{
+		const int32 NodeIndex = Queue[QueueIndex];
+		const int32 FailIndex = Nodes[NodeIndex].Fail;
+		Nodes[NodeIndex].OutputTokens.Append(Nodes[FailIndex].OutputTokens);
+		for (int32 Character = 0; Character < AlphabetSize; ++Character)
+		{
+			const int32 Next = Nodes[NodeIndex].Next[Character];
+			if (Next == INDEX_NONE)
+			{
+				Nodes[NodeIndex].Next[Character] = Nodes[FailIndex].Next[Character];
+			}
+			else
+			{
+				Nodes[Next].Fail = Nodes[FailIndex].Next[Character];
+				Queue.Add(Next);
+			}
+		}
+	}
+}
+
+uint32 FTextureRoleClassifier::HashTokens(const TArray<TArray<FString>>& TokensPerRole)
+{
+	uint32 Hash = GetTypeHash(TokensPerRole.Num());
+	for (const TArray<FString>& RoleTokens : TokensPerRole)
+	{
+		Hash = HashCombine(Hash, GetTypeHash(RoleTokens.Num()));
+		for (const FString& TokenString : RoleTokens)
+		{
+			Hash = HashCombine(Hash, GetTypeHash(TokenString));
+		}
+	}
+	return Hash;
+}
+
+FTextureRoleMatch FTextureRoleClassifier::Classify(FStringView TextureName) const
+{
+	FTextureRoleMatch BestMatch;
+	if (Nodes.Num() == 0) return BestMatch;
+
+	int32 NodeIndex = 0;
+	const int32 NameLength = TextureName.Len();
+	for (int32 Position = 0; Position < NameLength; ++Position)
+	{
+		const TCHAR LowerCharacter = FChar::ToLower(TextureName[Position]);
+		NodeIndex = LowerCharacter < AlphabetSize ? Nodes[NodeIndex].Next[LowerCharacter] : 0;
+
+		const FNode& Node = Nodes[NodeIndex];
+		if (Node.OutputTokens.Num() == 0) continue;
+		//Token must end the name or be followed by a non-letter
+		const bool bAtBoundary = Position + 1 == NameLength || !FChar::IsAlpha(TextureName[Position + 1]);
+		if (!bAtBoundary) continue;
+
+		for (const int32 TokenIndex : Node.OutputTokens)
+		{
+			const FToken& Token = Tokens[TokenIndex];
+			BestMatch.MatchedRolesMask |= 1u << Token.RoleIndex;
+			const int32 MatchStart = Position + 1 - Token.Length;
+			const int32 BestEnd = BestMatch.MatchStart + BestMatch.MatchLength;
+			const bool bBetter = !BestMatch.IsValid() ||
+				Position + 1 > BestEnd ||
+				(Position + 1 == BestEnd && Token.Length > BestMatch.MatchLength) ||
+				(Position + 1 == BestEnd && Token.Length == BestMatch.MatchLength && Token.RoleIndex < BestMatch.RoleIndex);
+			if (bBetter)
+			{
+				BestMatch.RoleIndex = Token.RoleIndex;
+				BestMatch.MatchStart = MatchStart;
+				BestMatch.MatchLength = Token.Length;
+			}
+		}
+	}
+	BestMatch.bAmbiguous = FMath::CountBits(BestMatch.MatchedRolesMask) > 1;
+	return BestMatch;
+}
+
+FString FTextureRoleClassifier::MakeStem(FStringView TextureName, const FTextureRoleMatch& Match)
+{
+	FString Stem;
+	if (Match.IsValid())
+	{
+		Stem.Reserve(TextureName.Len() - Match.MatchLength);
+		Stem.Append(TextureName.Left(Match.MatchStart));
+		Stem.Append(TextureName.Mid(Match.MatchStart + Match.MatchLength));
+	}
+	else
+	{
+		Stem = FString(TextureName);
+	}
+	Stem.RemoveFromStart(TEXT("T_"));
+	return Stem;
+}
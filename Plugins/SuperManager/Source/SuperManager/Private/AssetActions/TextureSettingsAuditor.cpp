@@ -0,0 +1,174 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "AssetActions/TextureSettingsAuditor.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "Async/ParallelFor.h"
+#include "Engine/Texture2D.h"
+#include "FileHelpers.h"
+#include "Misc/ScopedSlowTask.h"
+#include "DebugHeader.h"
+#include "SuperManager.h"
+
+FString FTextureAuditFinding::DescribeFix() const
+{
+	TArray<FString> Fixes;
+	if (bDisableSRGB) Fixes.Add(TEXT("sRGB off"));
+	if (bCompressTexture) Fixes.Add(TEXT("compress"));
+	if (bPadToPowerOfTwo) Fixes.Add(TEXT("pad to power of two"));
+	return FString::Join(Fixes, TEXT(", "));
+}
+
+void FTextureSettingsAuditor::Run(const TArray<FString>& RootPaths, TArray<FTextureAuditFinding>& OutFindings,
+	int64& OutTotalGpuBytes) const
+{
+	OutFindings.Empty();
+	OutTotalGpuBytes = 0;
+	const double StartTime = FPlatformTime::Seconds();
+	IAssetRegistry& AssetRegistry =
+		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	FARFilter Filter;
+	for (const FString& RootPath : RootPaths)
+	{
+		Filter.PackagePaths.Add(FName(*RootPath));
+	}
+	Filter.bRecursivePaths = true;
+	Filter.bIncludeOnlyOnDiskAssets = true;
+	Filter.ClassPaths.Add(UTexture2D::StaticClass()->GetClassPathName());
+	TArray<FAssetData> TexturesData;
+	AssetRegistry.GetAssets(Filter, TexturesData);
+
+	TArray<FTextureAuditFinding> PerTextureResults;
+	PerTextureResults.SetNum(TexturesData.Num());
+	ParallelFor(TexturesData.Num(), [this, &TexturesData, &PerTextureResults](int32 Index)
+		{
+			if (FSuperManagerModule::IsPathExcludedFromScan(TexturesData[Index].PackagePath.ToString())) return;
+			AuditTexture(TexturesData[Index], PerTextureResults[Index]);
+		});
+
+	for (FTextureAuditFinding& Result : PerTextureResults)
+	{
+		OutTotalGpuBytes += Result.EstimatedGpuBytes;
+		if (Result.Message.IsEmpty()) continue;
+		OutFindings.Add(MoveTemp(Result));
+	}
+	OutFindings.Sort([](const FTextureAuditFinding& A, const FTextureAuditFinding& B)
+		{
+			return A.EstimatedGpuBytes > B.EstimatedGpuBytes;
+		});
+
+	DebugHeader::PrtLog(FString::Printf(TEXT("Audited %d textures (%.1f MiB estimated), found %d problems in %.3f seconds"),
+		TexturesData.Num(), OutTotalGpuBytes / (1024.0 * 1024.0), OutFindings.Num(), FPlatformTime::Seconds() - StartTime));
+}
+
+//Fills the estimate of every texture, returns true and a message if a setting wastes memory or quality
+bool FTextureSettingsAuditor::AuditTexture(const FAssetData& AssetData, FTextureAuditFinding& OutFinding) const
+{
+	FString Dimensions;
+	if (!AssetData.GetTagValue(FName("Dimensions"), Dimensions)) return false;
+	FString SizeXString;
+	FString SizeYString;
+	if (!Dimensions.Split(TEXT("x"), &SizeXString, &SizeYString)) return false;
+	OutFinding.SizeX = FCString::Atoi(*SizeXString);
+	OutFinding.SizeY = FCString::Atoi(*SizeYString);
+	if (OutFinding.SizeX <= 0 || OutFinding.SizeY <= 0) return false;
+
+	const FString PixelFormat = AssetData.GetTagValueRef<FString>(FName("Format"));
+	const FString CompressionSettings = AssetData.GetTagValueRef<FString>(FName("CompressionSettings"));
+	const FString LODGroup = AssetData.GetTagValueRef<FString>(FName("LODGroup"));
+	const FString MipGenSettings = AssetData.GetTagValueRef<FString>(FName("MipGenSettings"));
+	FString SRGBValue;
+	const bool bHasSRGBTag = AssetData.GetTagValue(FName("SRGB"), SRGBValue);
+
+	const bool bHasMips = !MipGenSettings.Equals(TEXT("TMGS_NoMipmaps"));
+	const int64 TopMipBytes = (int64)OutFinding.SizeX * OutFinding.SizeY * GetBitsPerPixel(PixelFormat, CompressionSettings) / 8;
+	//A full mip chain adds a third of the top mip
+	OutFinding.EstimatedGpuBytes = bHasMips ? TopMipBytes * 4 / 3 : TopMipBytes;
+
+	FString Message;
+	const int32 LongestSide = FMath::Max(OutFinding.SizeX, OutFinding.SizeY);
+	static const TSet<FString> UncompressedSettings = { TEXT("TC_VectorDisplacementmap"), TEXT("TC_HDR"),
+		TEXT("TC_EditorIcon"), TEXT("TC_Grayscale"), TEXT("TC_HalfFloat"), TEXT("TC_SingleFloat"), TEXT("TC_HDR_F32") };
+	if (LongestSide >= LargeTextureSize && UncompressedSettings.Contains(CompressionSettings))
+	{
+		Message += FString::Printf(TEXT("Uncompressed %dx%d (%s). "), OutFinding.SizeX, OutFinding.SizeY, *CompressionSettings);
+		OutFinding.bCompressTexture = true;
+	}
+
+	if (bHasMips && (!FMath::IsPowerOfTwo(OutFinding.SizeX) || !FMath::IsPowerOfTwo(OutFinding.SizeY)))
+	{
+		Message += TEXT("Non power of two, no mips and no streaming. ");
+		OutFinding.bPadToPowerOfTwo = true;
+	}
+
+	const bool bIsNormalMap = CompressionSettings.Equals(TEXT("TC_Normalmap")) || LODGroup.EndsWith(TEXT("NormalMap"));
+	const bool bIsMask = CompressionSettings.Equals(TEXT("TC_Masks"));
+	if (bHasSRGBTag && SRGBValue.ToBool() && (bIsNormalMap || bIsMask))
+	{
+		Message += bIsNormalMap ? TEXT("Normal map with sRGB on. ") : TEXT("Mask with sRGB on. ");
+		OutFinding.bDisableSRGB = true;
+	}
+
+	if (Message.IsEmpty()) return false;
+	OutFinding.AssetData = AssetData;
+	OutFinding.Message = Message.TrimEnd();
+	return true;
+}
+
+//Platform format when the tag is there, otherwise the worst case of the compression setting
+int32 FTextureSettingsAuditor::GetBitsPerPixel(const FString& PixelFormat, const FString& CompressionSettings)
+{
+	//The tag holds the GPixelFormats name, which has no PF_ prefix
+	static const TMap<FString, int32> BitsPerFormat = {
+		{ TEXT("DXT1"), 4 }, { TEXT("BC4"), 4 }, { TEXT("DXT5"), 8 }, { TEXT("BC5"), 8 },
+		{ TEXT("BC6H"), 8 }, { TEXT("BC7"), 8 }, { TEXT("G8"), 8 }, { TEXT("G16"), 16 },
+		{ TEXT("B8G8R8A8"), 32 }, { TEXT("FloatRGBA"), 64 }, { TEXT("R16F"), 16 },
+		{ TEXT("R32_FLOAT"), 32 }, { TEXT("A32B32G32R32F"), 128 }
+	};
+	static const TMap<FString, int32> BitsPerCompression = {
+		{ TEXT("TC_Alpha"), 4 }, { TEXT("TC_Grayscale"), 8 }, { TEXT("TC_Displacementmap"), 8 },
+		{ TEXT("TC_HalfFloat"), 16 }, { TEXT("TC_VectorDisplacementmap"), 32 }, { TEXT("TC_EditorIcon"), 32 },
+		{ TEXT("TC_SingleFloat"), 32 }, { TEXT("TC_HDR"), 64 }, { TEXT("TC_HDR_F32"), 128 }
+	};
+	if (const int32* FormatBits = BitsPerFormat.Find(PixelFormat)) return *FormatBits;
+	if (const int32* CompressionBits = BitsPerCompression.Find(CompressionSettings)) return *CompressionBits;
+	return 8;
+}
+
+int32 FTextureSettingsAuditor::Fix(const TArray<FTextureAuditFinding>& Findings)
+{
+	TArray<UPackage*> PackagesToSave;
+	FScopedSlowTask FixTask(Findings.Num(), FText::FromString(TEXT("Fixing texture settings")));
+	FixTask.MakeDialog();
+	for (const FTextureAuditFinding& Finding : Findings)
+	{
+		FixTask.EnterProgressFrame();
+		if (!Finding.CanFix()) continue;
+		UTexture2D* Texture = Cast<UTexture2D>(Finding.AssetData.GetAsset());
+		if (!Texture) continue;
+
+		Texture->Modify();
+		if (Finding.bDisableSRGB)
+		{
+			Texture->SRGB = false;
+		}
+		if (Finding.bCompressTexture)
+		{
+			const bool bIsHDR = Texture->CompressionSettings == TC_HDR || Texture->CompressionSettings == TC_HDR_F32
+				|| Texture->CompressionSettings == TC_HalfFloat || Texture->CompressionSettings == TC_SingleFloat;
+			Texture->CompressionSettings = bIsHDR ? TC_HDR_Compressed : TC_Default;
+		}
+		if (Finding.bPadToPowerOfTwo)
+		{
+			Texture->PowerOfTwoMode = ETexturePowerOfTwoSetting::PadToPowerOfTwo;
+		}
+		Texture->PostEditChange();
+		PackagesToSave.Add(Texture->GetPackage());
+	}
+
+	if (PackagesToSave.Num() > 0)
+	{
+		UEditorLoadingAndSavingUtils::SavePackages(PackagesToSave, true);
+	}
+	return PackagesToSave.Num();
+}
@@ -0,0 +1,294 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Commandlets/SuperManagerAuditCommandlet.h"
+#include "AssetActions/NamingConventionLinter.h"
+#include "AssetRegistry/AssetRegistryModule.h"
+#include "FileHelpers.h"
+#include "AssetActions/QuickMaterialCreationWidget.h"
+#include "AssetActions/TextureRoleClassifier.h"
+#include "AssetActions/TextureSettingsAuditor.h"
+#include "AssetActions/MaterialInstanceDeduplicator.h"
+#include "AssetActions/MaterialGraphHasher.h"
+#include "AssetActions/MaterialUsageAuditor.h"
+#include "ActorActions/LevelCostProfiler.h"
+#include "WorldPartition/WorldPartition.h"
+#include "WorldPartition/LoaderAdapter/LoaderAdapterShape.h"
+
+DEFINE_LOG_CATEGORY_STATIC(LogSuperManagerAudit, Log, All);
+
+USuperManagerAuditCommandlet::USuperManagerAuditCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 USuperManagerAuditCommandlet::Main(const FString& Params)
+{
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamsMap;
+	ParseCommandLine(*Params, Tokens, Switches, ParamsMap);
+
+	const FString AuditName = ParamsMap.Contains(TEXT("Audit")) ? ParamsMap[TEXT("Audit")] : TEXT("Naming");
+	TArray<FString> RootPaths;
+	if (ParamsMap.Contains(TEXT("Paths")))
+	{
+		ParamsMap[TEXT("Paths")].ParseIntoArray(RootPaths, TEXT("+"));
+	}
+	if (RootPaths.Num() == 0)
+	{
+		RootPaths.Add(TEXT("/Game"));
+	}
+	const bool bAutoFix = Switches.Contains(TEXT("AutoFix"));
+
+	//Registry data is all the audits need, make sure the initial scan is complete
+	IAssetRegistry& AssetRegistry =
+		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+	AssetRegistry.SearchAllAssets(true);
+
+	if (AuditName.Equals(TEXT("Naming")))
+	{
+		return RunNamingAudit(RootPaths, bAutoFix);
+	}
+	if (AuditName.Equals(TEXT("TextureSettings")))
+	{
+		return RunTextureSettingsAudit(RootPaths, bAutoFix);
+	}
+	if (AuditName.Equals(TEXT("MaterialInstanceDuplicates")))
+	{
+		return RunMaterialInstanceDuplicatesAudit(RootPaths);
+	}
+	if (AuditName.Equals(TEXT("MaterialGraphDuplicates")))
+	{
+		const int32 BatchSize = ParamsMap.Contains(TEXT("BatchSize")) ? FCString::Atoi(*ParamsMap[TEXT("BatchSize")]) : 64;
+		return RunMaterialGraphDuplicatesAudit(RootPaths, FMath::Max(BatchSize, 1));
+	}
+	if (AuditName.Equals(TEXT("MaterialUsage")))
+	{
+		return RunMaterialUsageAudit(RootPaths, bAutoFix);
+	}
+	if (AuditName.Equals(TEXT("TextureRoleBenchmark")))
+	{
+		const int32 NumNames = ParamsMap.Contains(TEXT("Count")) ? FCString::Atoi(*ParamsMap[TEXT("Count")]) : 1000000;
+		return RunTextureRoleBenchmark(FMath::Max(NumNames, 1));
+	}
+	if (AuditName.Equals(TEXT("LevelCost")))
+	{
+		const FString MapPath = ParamsMap.Contains(TEXT("Map")) ? ParamsMap[TEXT("Map")] : FString();
+		const FString GroupBy = ParamsMap.Contains(TEXT("GroupBy")) ? ParamsMap[TEXT("GroupBy")] : TEXT("Class");
+		const FString OutputPath = ParamsMap.Contains(TEXT("Output")) ? ParamsMap[TEXT("Output")] :
+			FPaths::ProjectSavedDir() / TEXT("SuperManager") / FString::Printf(TEXT("LevelCost_%s.csv"), *GroupBy);
+		return RunLevelCostExport(MapPath, GroupBy, OutputPath);
+	}
+	UE_LOG(LogSuperManagerAudit, Error, TEXT("Unknown audit %s"), *AuditName);
+	return 1;
+}
+
+int32 USuperManagerAuditCommandlet::RunNamingAudit(const TArray<FString>& RootPaths, bool bAutoFix)
+{
+	FNamingConventionLinter NamingLinter(GetDefault<UNamingConventionSettings>()->GetEffectiveRules());
+	TArray<FNamingViolation> Violations;
+	NamingLinter.Run(RootPaths, Violations);
+
+	for (const FNamingViolation& Violation : Violations)
+	{
+		UE_LOG(LogSuperManagerAudit, Display, TEXT("%s: %s%s"), *Violation.AssetData.PackageName.ToString(), *Violation.Message,
+			Violation.bCanAutoFix ? *(TEXT(" Suggested: ") + Violation.SuggestedName) : TEXT(""));
+	}
+	UE_LOG(LogSuperManagerAudit, Display, TEXT("%d naming violations found"), Violations.Num());
+
+	if (bAutoFix && Violations.Num() > 0)
+	{
+		const int32 RenamedCounter = FNamingConventionLinter::AutoFix(Violations);
+		//Nobody is around to save the renamed packages in a commandlet
+		UEditorLoadingAndSavingUtils::SaveDirtyPackages(false, true);
+		UE_LOG(LogSuperManagerAudit, Display, TEXT("Renamed %d assets"), RenamedCounter);
+	}
+	return Violations.Num() > 0 ? 1 : 0;
+}
+
+int32 USuperManagerAuditCommandlet::RunTextureSettingsAudit(const TArray<FString>& RootPaths, bool bAutoFix)
+{
+	FTextureSettingsAuditor TextureAuditor;
+	TArray<FTextureAuditFinding> Findings;
+	int64 TotalGpuBytes = 0;
+	TextureAuditor.Run(RootPaths, Findings, TotalGpuBytes);
+
+	for (const FTextureAuditFinding& Finding : Findings)
+	{
+		UE_LOG(LogSuperManagerAudit, Display, TEXT("%s: %.1f MiB. %s%s"), *Finding.AssetData.PackageName.ToString(),
+			Finding.EstimatedGpuBytes / (1024.0 * 1024.0), *Finding.Message,
+			Finding.CanFix() ? *(TEXT(" Fix: ") + Finding.DescribeFix()) : TEXT(""));
+	}
+	UE_LOG(LogSuperManagerAudit, Display, TEXT("%d texture setting problems found, %.1f MiB estimated for all textures"),
+		Findings.Num(), TotalGpuBytes / (1024.0 * 1024.0));
+
+	if (bAutoFix && Findings.Num() > 0)
+	{
+		UE_LOG(LogSuperManagerAudit, Display, TEXT("Fixed %d textures"), FTextureSettingsAuditor::Fix(Findings));
+	}
+	return Findings.Num() > 0 ? 1 : 0;
+}
+
+int32 USuperManagerAuditCommandlet::RunMaterialInstanceDuplicatesAudit(const TArray<FString>& RootPaths)
+{
+	FMaterialInstanceDeduplicator Deduplicator;
+	TArray<FMaterialInstanceCluster> Clusters;
+	Deduplicator.Scan(RootPaths, Clusters);
+
+	int32 DuplicateCounter = 0;
+	for (const FMaterialInstanceCluster& Cluster : Clusters)
+	{
+		UE_LOG(LogSuperManagerAudit, Display, TEXT("%s is duplicated by:"), *Cluster.Instances[0].PackageName.ToString());
+		for (int32 Index = 1; Index < Cluster.Instances.Num(); ++Index)
+		{
+			UE_LOG(LogSuperManagerAudit, Display, TEXT("    %s"), *Cluster.Instances[Index].PackageName.ToString());
+			++DuplicateCounter;
+		}
+	}
+	UE_LOG(LogSuperManagerAudit, Display, TEXT("%d duplicate material instances found in %d groups"), DuplicateCounter, Clusters.Num());
+	return Clusters.Num() > 0 ? 1 : 0;
+}
+
+int32 USuperManagerAuditCommandlet::RunMaterialGraphDuplicatesAudit(const TArray<FString>& RootPaths, int32 BatchSize)
+{
+	FMaterialGraphHasher GraphHasher;
+	GraphHasher.BatchSize = BatchSize;
+	TArray<FMaterialShaderGroup> Groups;
+	int32 NumMaterials = 0;
+	GraphHasher.Scan(RootPaths, Groups, NumMaterials);
+
+	int32 SavedPermutations = 0;
+	for (const FMaterialShaderGroup& Group : Groups)
+	{
+		UE_LOG(LogSuperManagerAudit, Display, TEXT("%s (%s), merging saves about %d permutations:"),
+			*Group.Materials[0].PackageName.ToString(), *Group.StructuralHash.ToString(), Group.GetSavedPermutations());
+		for (int32 Index = 1; Index < Group.Materials.Num(); ++Index)
+		{
+			UE_LOG(LogSuperManagerAudit, Display, TEXT("    %s"), *Group.Materials[Index].PackageName.ToString());
+		}
+		SavedPermutations += Group.GetSavedPermutations();
+	}
+	UE_LOG(LogSuperManagerAudit, Display, TEXT("%d groups of identical shaders among %d materials, about %d permutations saved by merging"),
+		Groups.Num(), NumMaterials, SavedPermutations);
+	return Groups.Num() > 0 ? 1 : 0;
+}
+
+int32 USuperManagerAuditCommandlet::RunMaterialUsageAudit(const TArray<FString>& RootPaths, bool bAutoFix)
+{
+	FMaterialUsageAuditor UsageAuditor;
+	TArray<FMaterialUsageReport> Reports;
+	UsageAuditor.Run(RootPaths, Reports);
+
+	int32 UnneededFlagCounter = 0;
+	int64 TotalPermutations = 0;
+	int64 TotalPermutationsAfterStripping = 0;
+	for (const FMaterialUsageReport& Report : Reports)
+	{
+		UE_LOG(LogSuperManagerAudit, Display, TEXT("%s: %lld permutations (%lld after stripping). Flags: %s. Toggles: %s"),
+			*Report.AssetData.PackageName.ToString(), Report.EstimatedPermutations, Report.PermutationsAfterStripping,
+			*Report.DescribeFlags(), *Report.DescribeToggles());
+		UnneededFlagCounter += Report.GetNumUnneededFlags();
+		TotalPermutations += Report.EstimatedPermutations;
+		TotalPermutationsAfterStripping += Report.PermutationsAfterStripping;
+	}
+	UE_LOG(LogSuperManagerAudit, Display, TEXT("%d materials, %lld permutations, %d unneeded usage flags worth %lld permutations"),
+		Reports.Num(), TotalPermutations, UnneededFlagCounter, TotalPermutations - TotalPermutationsAfterStripping);
+
+	if (bAutoFix && UnneededFlagCounter > 0)
+	{
+		UE_LOG(LogSuperManagerAudit, Display, TEXT("Stripped %d usage flags"), FMaterialUsageAuditor::StripUnneededFlags(Reports));
+	}
+	return UnneededFlagCounter > 0 ? 1 : 0;
+}
+
+int32 USuperManagerAuditCommandlet::RunTextureRoleBenchmark(int32 NumNames)
+{
+	const UQuickMaterialCreationWidget* DefaultWidget = GetDefault<UQuickMaterialCreationWidget>();
+	const TArray< TArray<FString> > TokensPerRole = { DefaultWidget->BaseColorArray, DefaultWidget->MetallicArray,
+		DefaultWidget->RoughnessArray, DefaultWidget->NormalArray, DefaultWidget->AmbientOcclusionArray };
+	FTextureRoleClassifier Classifier;
+	Classifier.Compile(TokensPerRole);
+
+	//Realistic names built from every configured token, plus names that must not match
+	TArray<FString> SampleNames;
+	for (const TArray<FString>& RoleTokens : TokensPerRole)
+	{
+		for (const FString& Token : RoleTokens)
+		{
+			SampleNames.Add(TEXT("T_castle_brick_02_red") + Token + TEXT("_2k"));
+			SampleNames.Add(TEXT("T_Rock") + Token);
+		}
+	}
+	SampleNames.Add(TEXT("T_Rock_AOMask"));
+	SampleNames.Add(TEXT("T_metal_grate_rusty_arm_2k"));
+
+	const double StartTime = FPlatformTime::Seconds();
+	int32 MatchedCounter = 0;
+	for (int32 Index = 0; Index < NumNames; ++Index)
+	{
+		if (Classifier.Classify(SampleNames[Index % SampleNames.Num()]).IsValid())
+		{
+			++MatchedCounter;
+		}
+	}
+	const double ElapsedSeconds = FMath::Max(FPlatformTime::Seconds() - StartTime, UE_DOUBLE_SMALL_NUMBER);
+	UE_LOG(LogSuperManagerAudit, Display, TEXT("Classified %d texture names (%d matched) in %.3f seconds, %.0f names per second"),
+		NumNames, MatchedCounter, ElapsedSeconds, NumNames / ElapsedSeconds);
+	return 0;
+}
+
+//GroupBy takes the same names as the panel buttons: Class, Mesh or Folder
+int32 USuperManagerAuditCommandlet::RunLevelCostExport(const FString& MapPath, const FString& GroupBy, const FString& OutputPath)
+{
+	//Opened as the editor world, so it is initialized and its streaming levels come with it
+	const FString MapPackageName = MapPath.Contains(TEXT(".")) ? FPackageName::ObjectPathToPackageName(MapPath) : MapPath;
+	UWorld* World = MapPath.IsEmpty() ? nullptr : UEditorLoadingAndSavingUtils::LoadMap(MapPackageName);
+	if (!World)
+	{
+		UE_LOG(LogSuperManagerAudit, Error, TEXT("Could not load map %s, pass it with -Map=/Game/Path/To/Map"), *MapPath);
+		return 1;
+	}
+	World->LoadSecondaryLevels(true);
+	World->FlushLevelStreaming(EFlushLevelStreamingType::Full);
+
+	//World Partition keeps its actors in external packages, every cell is loaded for the duration of the export
+	TUniquePtr<FLoaderAdapterShape> WorldPartitionLoader;
+	if (UWorldPartition* WorldPartition = World->GetWorldPartition())
+	{
+		WorldPartitionLoader = MakeUnique<FLoaderAdapterShape>(World, WorldPartition->GetEditorWorldBounds(), TEXT("Level Cost Export"));
+		WorldPartitionLoader->Load();
+	}
+
+	E_LevelCostGrouping Grouping = E_LevelCostGrouping::ELCG_Class;
+	for (int32 GroupingIndex = 0; GroupingIndex < static_cast<int32>(E_LevelCostGrouping::ELCG_MAX); ++GroupingIndex)
+	{
+		const E_LevelCostGrouping CandidateGrouping = static_cast<E_LevelCostGrouping>(GroupingIndex);
+		if (GroupBy.Equals(FLevelCostProfiler::GetGroupingName(CandidateGrouping))) Grouping = CandidateGrouping;
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	FLevelCostProfiler Profiler;
+	Profiler.Gather(World);
+	const double GatherSeconds = FPlatformTime::Seconds() - StartTime;
+	TArray< TSharedPtr<FLevelCostRow> > Rows;
+	Profiler.Aggregate(Grouping, Rows);
+	UE_LOG(LogSuperManagerAudit, Display, TEXT("Gathered %d actors in %.3f seconds, aggregated %d groups by %s in %.3f seconds"),
+		Profiler.NumActors(), GatherSeconds, Rows.Num(), *FLevelCostProfiler::GetGroupingName(Grouping),
+		FPlatformTime::Seconds() - StartTime - GatherSeconds);
+
+	for (const TSharedPtr<FLevelCostRow>& Row : Rows)
+	{
+		UE_LOG(LogSuperManagerAudit, Display, TEXT("%s: %d actors, %lld LOD0 triangles, %d shadow casters, %d ticking"),
+			*Row->GroupName, Row->NumActors, Row->Lod0Triangles, Row->NumShadowCasters, Row->NumTicking);
+	}
+	if (!FLevelCostProfiler::ExportCsv(Rows, OutputPath))
+	{
+		UE_LOG(LogSuperManagerAudit, Error, TEXT("Failed to write %s"), *OutputPath);
+		return 1;
+	}
+	UE_LOG(LogSuperManagerAudit, Display, TEXT("Level cost written to %s"), *OutputPath);
+	return 0;
+}
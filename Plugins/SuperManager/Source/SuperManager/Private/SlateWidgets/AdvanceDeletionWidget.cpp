@@ -15,6 +15,7 @@ void SAdvanceDeletionTab::Construct(const FArguments& InArgs)
 
 	StoredAssetsData = InArgs._AssetsDataToStore;
 	DisplayedAssetsData = StoredAssetsData;
+	SelectedRootFolders = InArgs._SelectedRootFolders;
 
 	CheckBoxesArray.Empty();
 	AssetsDataToDeleteArray.Empty();
@@ -60,11 +61,14 @@ void SAdvanceDeletionTab::Construct(const FArguments& InArgs)
 							ConstructComboHelpTexts(TEXT("Specify the listing condition in the drop down. Left mouse click to go to where asset is located"),
 								ETextJustify::Center)
 						]
-						//Help text for folder path
+						//Help text for folder paths, with the number of listed assets under each root
 						+ SHorizontalBox::Slot()
 						.FillWidth(.1f)
 						[
-							ConstructComboHelpTexts(TEXT("Current Folder:\n") + InArgs._CurrentSelectedFolder, ETextJustify::Right)
+							SAssignNew(RootBreakdownTextBlock, STextBlock)
+								.Text(FText::FromString(ConstructRootBreakdownText()))
+								.Justification(ETextJustify::Right)
+								.AutoWrapText(true)
 						]
 				]
 
@@ -132,6 +136,37 @@ void SAdvanceDeletionTab::RefreshAssetListView()
 	{
 		ConstructedAssetListView->RebuildList();
 	}
+	if (RootBreakdownTextBlock.IsValid())
+	{
+		RootBreakdownTextBlock->SetText(FText::FromString(ConstructRootBreakdownText()));
+	}
+}
+
+FString SAdvanceDeletionTab::ConstructRootBreakdownText() const
+{
+	TArray<int32> AssetsCountPerRoot;
+	AssetsCountPerRoot.SetNumZeroed(SelectedRootFolders.Num());
+	for (const TSharedPtr<FAssetData>& DataSharedPtr : DisplayedAssetsData)
+	{
+		if (!DataSharedPtr.IsValid()) continue;
+		const FString PackagePath = DataSharedPtr->PackagePath.ToString();
+		for (int32 RootIndex = 0; RootIndex < SelectedRootFolders.Num(); ++RootIndex)
+		{
+			const FString& RootFolder = SelectedRootFolders[RootIndex];
+			if (PackagePath.Equals(RootFolder) || PackagePath.StartsWith(RootFolder + TEXT("/")))
+			{
+				++AssetsCountPerRoot[RootIndex];
+				break;
+			}
+		}
+	}
+
+	FString BreakdownText = SelectedRootFolders.Num() > 1 ? TEXT("Current Folders:") : TEXT("Current Folder:");
+	for (int32 RootIndex = 0; RootIndex < SelectedRootFolders.Num(); ++RootIndex)
+	{
+		BreakdownText += FString::Printf(TEXT("\n%s (%d)"), *SelectedRootFolders[RootIndex], AssetsCountPerRoot[RootIndex]);
+	}
+	return BreakdownText;
 }
 
 #pragma region ComboBoxForListingCondition
@@ -0,0 +1,90 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SlateWidgets/AssetAuditReportWidget.h"
+#include "SlateBasics.h"
+
+void SAssetAuditReportTable::Construct(const FArguments& InArgs)
+{
+	AuditRows = InArgs._AuditRows;
+
+	ChildSlot
+		[
+			SNew(SVerticalBox)
+
+				//First slot for column titles
+				+ SVerticalBox::Slot()
+				.AutoHeight()
+				.Padding(5.f)
+				[
+					ConstructColumns(TEXT("Asset"), TEXT("Path"), TEXT("Finding"), InArgs._DetailColumnTitle, TEXT("Fix"),
+						FSlateColor::UseForeground())
+				]
+
+				//Second slot for the findings
+				+ SVerticalBox::Slot()
+				.VAlign(VAlign_Fill)
+				[
+					SNew(SListView< TSharedPtr <FAssetAuditRow> >)
+						.ItemHeight(20.f)
+						.ListItemsSource(&AuditRows)
+						.OnGenerateRow(this, &SAssetAuditReportTable::OnGenerateRowForList)
+				]
+		];
+}
+
+void SAssetAuditReportTable::OpenInWindow(const TArray<TSharedPtr<FAssetAuditRow>>& AuditRows,
+	const FString& WindowTitle, const FString& DetailColumnTitle)
+{
+	TSharedRef<SWindow> ReportWindow = SNew(SWindow)
+		.Title(FText::FromString(WindowTitle))
+		.ClientSize(FVector2D(1100.f, 600.f))
+		[
+			SNew(SAssetAuditReportTable)
+				.AuditRows(AuditRows)
+				.DetailColumnTitle(DetailColumnTitle)
+		];
+	FSlateApplication::Get().AddWindow(ReportWindow);
+}
+
+TSharedRef<ITableRow> SAssetAuditReportTable::OnGenerateRowForList(TSharedPtr<FAssetAuditRow> RowToDisplay,
+	const TSharedRef<STableViewBase>& OwnerTable)
+{
+	if (!RowToDisplay.IsValid()) return SNew(STableRow < TSharedPtr <FAssetAuditRow> >, OwnerTable);
+	const FSlateColor FixStatusColor = RowToDisplay->bCanFix ? FSlateColor(FColor::Green) : FSlateColor::UseSubduedForeground();
+	return SNew(STableRow < TSharedPtr <FAssetAuditRow> >, OwnerTable).Padding(FMargin(5.f, 2.f))
+		[
+			ConstructColumns(RowToDisplay->AssetData.AssetName.ToString(), RowToDisplay->AssetData.PackagePath.ToString(),
+				RowToDisplay->Finding, RowToDisplay->Detail, RowToDisplay->bCanFix ? TEXT("Fixable") : TEXT("Report only"), FixStatusColor)
+		];
+}
+
+TSharedRef<SHorizontalBox> SAssetAuditReportTable::ConstructColumns(const FString& AssetName, const FString& AssetPath,
+	const FString& Finding, const FString& Detail, const FString& FixStatus, const FSlateColor& FixStatusColor)
+{
+	return SNew(SHorizontalBox)
+		+ SHorizontalBox::Slot()
+		.FillWidth(.2f)
+		[
+			SNew(STextBlock).Text(FText::FromString(AssetName))
+		]
+		+ SHorizontalBox::Slot()
+		.FillWidth(.2f)
+		[
+			SNew(STextBlock).Text(FText::FromString(AssetPath))
+		]
+		+ SHorizontalBox::Slot()
+		.FillWidth(.3f)
+		[
+			SNew(STextBlock).Text(FText::FromString(Finding)).AutoWrapText(true)
+		]
+		+ SHorizontalBox::Slot()
+		.FillWidth(.2f)
+		[
+			SNew(STextBlock).Text(FText::FromString(Detail)).AutoWrapText(true)
+		]
+		+ SHorizontalBox::Slot()
+		.FillWidth(.1f)
+		[
+			SNew(STextBlock).Text(FText::FromString(FixStatus)).ColorAndOpacity(FixStatusColor)
+		];
+}
@@ -0,0 +1,78 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SlateWidgets/AssetRenamePreviewWidget.h"
+#include "SlateBasics.h"
+
+void SAssetRenamePreviewTable::Construct(const FArguments& InArgs)
+{
+	PreviewRows = InArgs._PreviewRows;
+
+	ChildSlot
+		[
+			SNew(SVerticalBox)
+
+				//First slot for column titles
+				+ SVerticalBox::Slot()
+				.AutoHeight()
+				.Padding(5.f)
+				[
+					ConstructColumns(TEXT("Asset"), InArgs._SecondColumnTitle, TEXT("Status"), FSlateColor::UseForeground())
+				]
+
+				//Second slot for the planned renames
+				+ SVerticalBox::Slot()
+				.VAlign(VAlign_Fill)
+				[
+					SNew(SListView< TSharedPtr <FAssetRenamePreviewRow> >)
+						.ItemHeight(20.f)
+						.ListItemsSource(&PreviewRows)
+						.OnGenerateRow(this, &SAssetRenamePreviewTable::OnGenerateRowForList)
+				]
+		];
+}
+
+void SAssetRenamePreviewTable::OpenInWindow(const TArray<TSharedPtr<FAssetRenamePreviewRow>>& PreviewRows,
+	const FString& WindowTitle, const FString& SecondColumnTitle)
+{
+	TSharedRef<SWindow> PreviewWindow = SNew(SWindow)
+		.Title(FText::FromString(WindowTitle))
+		.ClientSize(FVector2D(900.f, 600.f))
+		[
+			SNew(SAssetRenamePreviewTable)
+				.PreviewRows(PreviewRows)
+				.SecondColumnTitle(SecondColumnTitle)
+		];
+	FSlateApplication::Get().AddWindow(PreviewWindow);
+}
+
+TSharedRef<ITableRow> SAssetRenamePreviewTable::OnGenerateRowForList(TSharedPtr<FAssetRenamePreviewRow> RowToDisplay,
+	const TSharedRef<STableViewBase>& OwnerTable)
+{
+	if (!RowToDisplay.IsValid()) return SNew(STableRow < TSharedPtr <FAssetRenamePreviewRow> >, OwnerTable);
+	const FSlateColor StatusColor = RowToDisplay->bCanRename ? FSlateColor(FColor::Green) : FSlateColor(FColor::Red);
+	return SNew(STableRow < TSharedPtr <FAssetRenamePreviewRow> >, OwnerTable).Padding(FMargin(5.f, 2.f))
+		[
+			ConstructColumns(RowToDisplay->AssetData.AssetName.ToString(), RowToDisplay->NewName, RowToDisplay->Status, StatusColor)
+		];
+}
+
+TSharedRef<SHorizontalBox> SAssetRenamePreviewTable::ConstructColumns(const FString& OldName, const FString& NewName,
+	const FString& Status, const FSlateColor& StatusColor)
+{
+	return SNew(SHorizontalBox)
+		+ SHorizontalBox::Slot()
+		.FillWidth(.4f)
+		[
+			SNew(STextBlock).Text(FText::FromString(OldName))
+		]
+		+ SHorizontalBox::Slot()
+		.FillWidth(.4f)
+		[
+			SNew(STextBlock).Text(FText::FromString(NewName))
+		]
+		+ SHorizontalBox::Slot()
+		.FillWidth(.2f)
+		[
+			SNew(STextBlock).Text(FText::FromString(Status)).ColorAndOpacity(StatusColor)
+		];
+}
@@ -0,0 +1,258 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SlateWidgets/LevelCostProfilerWidget.h"
+#include "SlateBasics.h"
+#include "DebugHeader.h"
+#include "Editor.h"
+
+namespace
+{
+	struct FLevelCostColumn
+	{
+		FName ColumnId;
+		const TCHAR* Title;
+		float FillWidth;
+	};
+
+	const FLevelCostColumn LevelCostColumns[] =
+	{
+		{ FName("Group"), TEXT("Group"), .3f },
+		{ FName("Actors"), TEXT("Actors"), .08f },
+		{ FName("Components"), TEXT("Components"), .08f },
+		{ FName("Lod0Triangles"), TEXT("LOD0 Triangles"), .1f },
+		{ FName("LastLodTriangles"), TEXT("Last LOD Triangles"), .1f },
+		{ FName("MaterialSlots"), TEXT("Material Slots"), .08f },
+		{ FName("ShadowCasters"), TEXT("Shadow Casters"), .08f },
+		{ FName("Ticking"), TEXT("Ticking"), .08f },
+		{ FName("Movable"), TEXT("Movable"), .08f },
+	};
+
+	class SLevelCostTableRow : public SMultiColumnTableRow< TSharedPtr <FLevelCostRow> >
+	{
+	public:
+		SLATE_BEGIN_ARGS(SLevelCostTableRow) {}
+		SLATE_END_ARGS()
+
+		void Construct(const FArguments& InArgs, const TSharedRef<STableViewBase>& OwnerTable, TSharedPtr<FLevelCostRow> InRow)
+		{
+			Row = InRow;
+			SMultiColumnTableRow< TSharedPtr <FLevelCostRow> >::Construct(FSuperRowType::FArguments().Padding(FMargin(5.f, 2.f)), OwnerTable);
+		}
+
+		virtual TSharedRef<SWidget> GenerateWidgetForColumn(const FName& ColumnId) override
+		{
+			const FString CellText = ColumnId == FName("Group") ? Row->GroupName :
+				FText::AsNumber(SLevelCostProfilerTab::GetColumnValue(*Row, ColumnId)).ToString();
+			return SNew(STextBlock).Text(FText::FromString(CellText));
+		}
+
+	private:
+		TSharedPtr<FLevelCostRow> Row;
+	};
+}
+
+void SLevelCostProfilerTab::Construct(const FArguments& InArgs)
+{
+	FSlateFontInfo TitleTextFont = FCoreStyle::Get().GetFontStyle(FName("EmbossedText"));
+	TitleTextFont.Size = 30;
+	ChildSlot
+		[	//Main vertical box
+			SNew(SVerticalBox)
+
+				//First vertical slot for title text
+				+ SVerticalBox::Slot()
+				.AutoHeight()
+				[
+					SNew(STextBlock)
+						.Text(FText::FromString(TEXT("Level Cost Profiler")))
+						.Font(TitleTextFont)
+						.Justification(ETextJustify::Center)
+						.ColorAndOpacity(FColor::White)
+				]
+
+				//Second slot for grouping, refresh and export buttons
+				+ SVerticalBox::Slot()
+				.AutoHeight()
+				[
+					SNew(SHorizontalBox)
+						+ SHorizontalBox::Slot().FillWidth(10.f).Padding(5.f)
+						[
+							ConstructTabButton(TEXT("By Class"), FOnClicked::CreateSP(this, &SLevelCostProfilerTab::OnGroupingButtonClicked, E_LevelCostGrouping::ELCG_Class))
+						]
+						+ SHorizontalBox::Slot().FillWidth(10.f).Padding(5.f)
+						[
+							ConstructTabButton(TEXT("By Mesh"), FOnClicked::CreateSP(this, &SLevelCostProfilerTab::OnGroupingButtonClicked, E_LevelCostGrouping::ELCG_Mesh))
+						]
+						+ SHorizontalBox::Slot().FillWidth(10.f).Padding(5.f)
+						[
+							ConstructTabButton(TEXT("By Folder"), FOnClicked::CreateSP(this, &SLevelCostProfilerTab::OnGroupingButtonClicked, E_LevelCostGrouping::ELCG_Folder))
+						]
+						+ SHorizontalBox::Slot().FillWidth(10.f).Padding(5.f)
+						[
+							ConstructTabButton(TEXT("Refresh"), FOnClicked::CreateSP(this, &SLevelCostProfilerTab::OnRefreshButtonClicked))
+						]
+						+ SHorizontalBox::Slot().FillWidth(10.f).Padding(5.f)
+						[
+							ConstructTabButton(TEXT("Export CSV"), FOnClicked::CreateSP(this, &SLevelCostProfilerTab::OnExportButtonClicked))
+						]
+				]
+
+				//Third slot for the totals of the current grouping
+				+ SVerticalBox::Slot()
+				.AutoHeight()
+				.Padding(5.f)
+				[
+					SAssignNew(SummaryTextBlock, STextBlock)
+				]
+
+				//Fourth slot for the sortable table
+				+ SVerticalBox::Slot()
+				.VAlign(VAlign_Fill)
+				[
+					SAssignNew(ConstructedRowListView, SListView< TSharedPtr <FLevelCostRow> >)
+						.ItemHeight(20.f)
+						.ListItemsSource(&DisplayedRows)
+						.OnGenerateRow(this, &SLevelCostProfilerTab::OnGenerateRowForList)
+						.HeaderRow(ConstructHeaderRow())
+				]
+		];
+
+	GatherLevelStats();
+}
+
+int64 SLevelCostProfilerTab::GetColumnValue(const FLevelCostRow& Row, const FName& ColumnId)
+{
+	if (ColumnId == FName("Actors")) return Row.NumActors;
+	if (ColumnId == FName("Components")) return Row.NumComponents;
+	if (ColumnId == FName("Lod0Triangles")) return Row.Lod0Triangles;
+	if (ColumnId == FName("LastLodTriangles")) return Row.LastLodTriangles;
+	if (ColumnId == FName("MaterialSlots")) return Row.NumMaterialSlots;
+	if (ColumnId == FName("ShadowCasters")) return Row.NumShadowCasters;
+	if (ColumnId == FName("Ticking")) return Row.NumTicking;
+	if (ColumnId == FName("Movable")) return Row.NumMovable;
+	return 0;
+}
+
+//Walking actors is the only game thread work, regrouping and sorting reuse the gathered arrays
+void SLevelCostProfilerTab::GatherLevelStats()
+{
+	const double StartTime = FPlatformTime::Seconds();
+	Profiler.Gather(GEditor ? GEditor->GetEditorWorldContext().World() : nullptr);
+	UE_LOG(LogTemp, Log, TEXT("Gathered cost of %d actors in %.3f seconds"), Profiler.NumActors(), FPlatformTime::Seconds() - StartTime);
+	RefreshRows();
+}
+
+void SLevelCostProfilerTab::RefreshRows()
+{
+	const double StartTime = FPlatformTime::Seconds();
+	Profiler.Aggregate(Grouping, DisplayedRows);
+	SortRows();
+	UE_LOG(LogTemp, Log, TEXT("Aggregated level cost by %s in %.3f seconds"),
+		*FLevelCostProfiler::GetGroupingName(Grouping), FPlatformTime::Seconds() - StartTime);
+
+	if (SummaryTextBlock.IsValid())
+	{
+		SummaryTextBlock->SetText(FText::FromString(FString::Printf(TEXT("%d actors in %d groups by %s"),
+			Profiler.NumActors(), DisplayedRows.Num(), *FLevelCostProfiler::GetGroupingName(Grouping))));
+	}
+}
+
+void SLevelCostProfilerTab::SortRows()
+{
+	const FName ColumnId = SortColumnId;
+	const bool bAscending = SortMode == EColumnSortMode::Ascending;
+	DisplayedRows.Sort([ColumnId, bAscending](const TSharedPtr<FLevelCostRow>& RowA, const TSharedPtr<FLevelCostRow>& RowB)
+		{
+			if (ColumnId == FName("Group"))
+			{
+				return bAscending ? RowA->GroupName < RowB->GroupName : RowB->GroupName < RowA->GroupName;
+			}
+			const int64 ValueA = GetColumnValue(*RowA, ColumnId);
+			const int64 ValueB = GetColumnValue(*RowB, ColumnId);
+			return bAscending ? ValueA < ValueB : ValueB < ValueA;
+		});
+	if (ConstructedRowListView.IsValid())
+	{
+		ConstructedRowListView->RequestListRefresh();
+	}
+}
+
+#pragma region SortableColumns
+TSharedRef<SHeaderRow> SLevelCostProfilerTab::ConstructHeaderRow()
+{
+	TSharedRef<SHeaderRow> HeaderRow = SNew(SHeaderRow);
+	for (const FLevelCostColumn& Column : LevelCostColumns)
+	{
+		HeaderRow->AddColumn(SHeaderRow::Column(Column.ColumnId)
+			.DefaultLabel(FText::FromString(Column.Title))
+			.FillWidth(Column.FillWidth)
+			.SortMode(this, &SLevelCostProfilerTab::GetColumnSortMode, Column.ColumnId)
+			.OnSort(this, &SLevelCostProfilerTab::OnColumnSortModeChanged));
+	}
+	return HeaderRow;
+}
+
+EColumnSortMode::Type SLevelCostProfilerTab::GetColumnSortMode(FName ColumnId) const
+{
+	return ColumnId == SortColumnId ? SortMode : EColumnSortMode::None;
+}
+
+void SLevelCostProfilerTab::OnColumnSortModeChanged(const EColumnSortPriority::Type SortPriority, const FName& ColumnId,
+	const EColumnSortMode::Type NewSortMode)
+{
+	SortColumnId = ColumnId;
+	SortMode = NewSortMode;
+	SortRows();
+}
+#pragma endregion
+
+TSharedRef<ITableRow> SLevelCostProfilerTab::OnGenerateRowForList(TSharedPtr<FLevelCostRow> RowToDisplay,
+	const TSharedRef<STableViewBase>& OwnerTable)
+{
+	return SNew(SLevelCostTableRow, OwnerTable, RowToDisplay);
+}
+
+#pragma region TabButtons
+TSharedRef<SButton> SLevelCostProfilerTab::ConstructTabButton(const FString& TextContent, FOnClicked OnClicked)
+{
+	FSlateFontInfo ButtonTextFont = FCoreStyle::Get().GetFontStyle(FName("EmbossedText"));
+	ButtonTextFont.Size = 15;
+	return SNew(SButton)
+		.ContentPadding(FMargin(5.f))
+		.OnClicked(OnClicked)
+		[
+			SNew(STextBlock)
+				.Text(FText::FromString(TextContent))
+				.Font(ButtonTextFont)
+				.Justification(ETextJustify::Center)
+		];
+}
+
+FReply SLevelCostProfilerTab::OnRefreshButtonClicked()
+{
+	GatherLevelStats();
+	return FReply::Handled();
+}
+
+FReply SLevelCostProfilerTab::OnGroupingButtonClicked(E_LevelCostGrouping NewGrouping)
+{
+	Grouping = NewGrouping;
+	RefreshRows();
+	return FReply::Handled();
+}
+
+FReply SLevelCostProfilerTab::OnExportButtonClicked()
+{
+	const FString FilePath = FPaths::ProjectSavedDir() / TEXT("SuperManager") /
+		FString::Printf(TEXT("LevelCost_%s.csv"), *FLevelCostProfiler::GetGroupingName(Grouping));
+	if (FLevelCostProfiler::ExportCsv(DisplayedRows, FilePath))
+	{
+		DebugHeader::ShowNInfo(TEXT("Exported level cost to ") + FilePath);
+	}
+	else
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("Failed to write ") + FilePath);
+	}
+	return FReply::Handled();
+}
+#pragma endregion
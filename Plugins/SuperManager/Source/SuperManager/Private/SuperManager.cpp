@@ -15,6 +15,21 @@
 #include "SceneOutlinerModule.h"
 #include "CustomOutlinerColumn/OutlinerSelectionColumn.h"
 #include "CustomUICommands/SuperManagerUICommands.h"
+#include "Async/ParallelFor.h"
+#include "AssetActions/NamingConventionLinter.h"
+#include "AssetActions/TextureSettingsAuditor.h"
+#include "AssetActions/MaterialInstanceDeduplicator.h"
+#include "AssetActions/MaterialGraphHasher.h"
+#include "AssetActions/MaterialUsageAuditor.h"
+#include "AssetActions/MaterialParameterSchema.h"
+#include "SlateWidgets/AssetAuditReportWidget.h"
+#include "ActorActions/ActorActionsLog.h"
+#include "ActorActions/EditorActorEvents.h"
+#include "ActorActions/ActorLabelIndex.h"
+#include "ActorActions/ActorSpatialIndex.h"
+#include "SlateWidgets/LevelCostProfilerWidget.h"
+
+DEFINE_LOG_CATEGORY(LogSuperManagerActorActions);
 
 #define LOCTEXT_NAMESPACE "FSuperManagerModule"
 
@@ -27,6 +42,12 @@ void FSuperManagerModule::StartupModule()
 	InitLevelEditorExtention();
 	InitCustomSelectionEvent();
 	InitSceneOutlinerColumnExtension();
+	RegisterAdvanceDeletionTab();
+	RegisterLevelCostProfilerTab();
+	FEditorActorEvents::Get().Register();
+	FActorLabelIndex::Get().Register();
+	FActorSpatialIndex::Get().Register();
+	FMaterialParameterSchemaCache::Get().Register();
 }
 
 
@@ -86,6 +107,48 @@ void FSuperManagerModule::AddCBMenuEntry(FMenuBuilder& MenuBuilder)
 		FSlateIcon(FSuperManagerStyle::GetStyleSetName(), "ContentBrowser.AdvanceDeletion"),	//Custom icon
 		FExecuteAction::CreateRaw(this, &FSuperManagerModule::OnAdvanceDeletionButtonClicked) //The actual function to excute
 	);
+	MenuBuilder.AddMenuEntry
+	(
+		FText::FromString(TEXT("Advance Deletion (Whole Project)")), //Title text for menu entry
+		FText::FromString(TEXT("List assets of the whole project in the advance deletion tab")), //Tooltip text
+		FSlateIcon(FSuperManagerStyle::GetStyleSetName(), "ContentBrowser.AdvanceDeletion"),	//Custom icon
+		FExecuteAction::CreateRaw(this, &FSuperManagerModule::OnAdvanceDeletionForProjectButtonClicked) //The actual function to excute
+	);
+	MenuBuilder.AddMenuEntry
+	(
+		FText::FromString(TEXT("Lint Naming Conventions")), //Title text for menu entry
+		FText::FromString(TEXT("Check asset names under folder against the naming convention settings")), //Tooltip text
+		FSlateIcon(),
+		FExecuteAction::CreateRaw(this, &FSuperManagerModule::OnLintNamingConventionsButtonClicked) //The actual function to excute
+	);
+	MenuBuilder.AddMenuEntry
+	(
+		FText::FromString(TEXT("Audit Texture Settings")), //Title text for menu entry
+		FText::FromString(TEXT("Find wasteful texture settings under folder without loading the textures")), //Tooltip text
+		FSlateIcon(),
+		FExecuteAction::CreateRaw(this, &FSuperManagerModule::OnAuditTextureSettingsButtonClicked) //The actual function to excute
+	);
+	MenuBuilder.AddMenuEntry
+	(
+		FText::FromString(TEXT("Find Duplicate Material Instances")), //Title text for menu entry
+		FText::FromString(TEXT("Find material instances under folder with identical parents and parameters")), //Tooltip text
+		FSlateIcon(),
+		FExecuteAction::CreateRaw(this, &FSuperManagerModule::OnFindDuplicateMaterialInstancesButtonClicked) //The actual function to excute
+	);
+	MenuBuilder.AddMenuEntry
+	(
+		FText::FromString(TEXT("Find Duplicate Material Graphs")), //Title text for menu entry
+		FText::FromString(TEXT("Find materials under folder whose graphs compile to the same shaders")), //Tooltip text
+		FSlateIcon(),
+		FExecuteAction::CreateRaw(this, &FSuperManagerModule::OnFindDuplicateMaterialGraphsButtonClicked) //The actual function to excute
+	);
+	MenuBuilder.AddMenuEntry
+	(
+		FText::FromString(TEXT("Audit Material Usage Flags")), //Title text for menu entry
+		FText::FromString(TEXT("List usage flags and shader permutations of materials under folder, strip flags no asset needs")), //Tooltip text
+		FSlateIcon(),
+		FExecuteAction::CreateRaw(this, &FSuperManagerModule::OnAuditMaterialUsageButtonClicked) //The actual function to excute
+	);
 }
 
 void FSuperManagerModule::OnDeleteUnusedAssetClicked()
@@ -95,48 +158,47 @@ void FSuperManagerModule::OnDeleteUnusedAssetClicked()
 		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("Please close advance deletion tab before this operation"));
 		return;
 	}
-	if (FolderPathsSelected.Num() > 1)
+	const TArray<FString> RootPaths = GetNormalizedSelectedRoots();
+	if (RootPaths.Num() == 0) return;
+
+	//Only counted here, the parallel scan below does the real work
+	FARFilter CountFilter;
+	CountFilter.bRecursivePaths = true;
+	CountFilter.bIncludeOnlyOnDiskAssets = true;
+	for (const FString& RootPath : RootPaths)
 	{
-		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("You can only do this to one folder"));
-		return;
+		CountFilter.PackagePaths.Add(FName(*RootPath));
 	}
-	TArray<FString> AssetsPathNames = UEditorAssetLibrary::ListAssets(FolderPathsSelected[0]);
-	if (AssetsPathNames.Num() == 0)
+	TArray<FAssetData> AssetsDataToCheck;
+	FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get().GetAssets(CountFilter, AssetsDataToCheck);
+	//Same folders the scan skips
+	AssetsDataToCheck.RemoveAll([](const FAssetData& AssetData)
+		{
+			return IsPathExcludedFromScan(AssetData.PackagePath.ToString());
+		});
+	if (AssetsDataToCheck.Num() == 0)
 	{
 		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("No asset found under selected folder"), false);
 		return;
 	}
+
 	EAppReturnType::Type ConfirmResult =
-		DebugHeader::ShowMsgDialog(EAppMsgType::YesNo, TEXT("A total of ") + FString::FromInt(AssetsPathNames.Num())
-			+ TEXT(" assets need to be checked.\nWould you like to procceed?"), false);
+		DebugHeader::ShowMsgDialog(EAppMsgType::YesNo, TEXT("A total of ") + FString::FromInt(AssetsDataToCheck.Num())
+			+ TEXT(" assets under ") + FString::FromInt(RootPaths.Num())
+			+ TEXT(" folder(s) need to be checked.\nWould you like to procceed?"), false);
 	if (ConfirmResult == EAppReturnType::No) return;
 
 	FixUpRedirectors();
 
+	TArray<FSelectedRootAssets> UnusedRootsAssets;
+	ScanRootsInParallel(RootPaths, true, UnusedRootsAssets);
+
 	TArray<FAssetData> UnusedAssetsDataArray;
-	for (const FString& AssetPathName : AssetsPathNames)
+	for (const FSelectedRootAssets& RootAssets : UnusedRootsAssets)
 	{
-		//Don't touch root folder
-		if (AssetPathName.Contains(TEXT("Developers")) ||
-			AssetPathName.Contains(TEXT("Collections")) ||
-			AssetPathName.Contains(TEXT("__ExternalActors__")) ||
-			AssetPathName.Contains(TEXT("__ExternalObjects__")))
-			{
-				continue;
-		}
-		if (!UEditorAssetLibrary::DoesAssetExist(AssetPathName)) continue;
-
-		// ����Ƿ�Ϊ�ؿ��ļ�
-		FAssetData AssetData = UEditorAssetLibrary::FindAssetData(AssetPathName);
-		if (AssetData.AssetClassPath.ToString() == TEXT("/Script/Engine.World"))  // ʹ�� AssetClassPath ����ʲ�����
+		for (const TSharedPtr<FAssetData>& DataSharedPtr : RootAssets.AssetsData)
 		{
-			continue;  // �����ؿ��ļ�
-		}
-
-		TArray<FString> AssetReferencers = UEditorAssetLibrary::FindPackageReferencersForAsset(AssetPathName);
-		if (AssetReferencers.Num() == 0)
-		{
-			UnusedAssetsDataArray.Add(AssetData);
+			UnusedAssetsDataArray.Add(*DataSharedPtr.Get());
 		}
 	}
 
@@ -158,7 +220,11 @@ void FSuperManagerModule::OnDeleteEmptyFoldersButtonClicked()
 		return;
 	}
 	FixUpRedirectors();
-	TArray<FString> FolderPathsArray = UEditorAssetLibrary::ListAssets(FolderPathsSelected[0], true, true);
+	TArray<FString> FolderPathsArray;
+	for (const FString& RootPath : GetNormalizedSelectedRoots())
+	{
+		FolderPathsArray.Append(UEditorAssetLibrary::ListAssets(RootPath, true, true));
+	}
 	uint32 Counter = 0;
 	FString EmptyFolderPathsNames;
 	TArray<FString> EmptyFoldersPathsArray;
@@ -211,6 +277,208 @@ void FSuperManagerModule::OnAdvanceDeletionButtonClicked()
 	FGlobalTabmanager::Get()->TryInvokeTab(FName("AdvanceDeletion"));
 }
 
+void FSuperManagerModule::OnAdvanceDeletionForProjectButtonClicked()
+{
+	FolderPathsSelected.Empty();
+	FolderPathsSelected.Add(TEXT("/Game"));
+	OnAdvanceDeletionButtonClicked();
+}
+
+void FSuperManagerModule::OnLintNamingConventionsButtonClicked()
+{
+	FNamingConventionLinter NamingLinter(GetDefault<UNamingConventionSettings>()->GetEffectiveRules());
+	TArray<FNamingViolation> Violations;
+	NamingLinter.Run(GetNormalizedSelectedRoots(), Violations);
+	if (Violations.Num() == 0)
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("No naming violation found under selected folder"), false);
+		return;
+	}
+
+	TArray< TSharedPtr <FAssetAuditRow> > ViolationRows;
+	int32 FixableCounter = 0;
+	for (const FNamingViolation& Violation : Violations)
+	{
+		TSharedPtr<FAssetAuditRow> Row = MakeShared<FAssetAuditRow>();
+		Row->AssetData = Violation.AssetData;
+		Row->Finding = Violation.Message;
+		Row->Detail = Violation.bCanAutoFix ? Violation.SuggestedName : FString();
+		Row->bCanFix = Violation.bCanAutoFix;
+		ViolationRows.Add(Row);
+		if (Violation.bCanAutoFix) ++FixableCounter;
+	}
+	SAssetAuditReportTable::OpenInWindow(ViolationRows, TEXT("Naming Violations"), TEXT("Suggested Name"));
+	if (FixableCounter == 0) return;
+
+	EAppReturnType::Type ConfirmResult = DebugHeader::ShowMsgDialog(EAppMsgType::YesNo,
+		FString::FromInt(Violations.Num()) + TEXT(" naming violations found.\nWould you like to fix ")
+		+ FString::FromInt(FixableCounter) + TEXT(" of them by renaming?"), false);
+	if (ConfirmResult == EAppReturnType::No) return;
+
+	const int32 RenamedCounter = FNamingConventionLinter::AutoFix(Violations);
+	if (RenamedCounter > 0)
+	{
+		DebugHeader::ShowNInfo(TEXT("Successfully renamed ") + FString::FromInt(RenamedCounter) + TEXT(" assets"));
+	}
+}
+
+void FSuperManagerModule::OnAuditTextureSettingsButtonClicked()
+{
+	FTextureSettingsAuditor TextureAuditor;
+	TArray<FTextureAuditFinding> Findings;
+	int64 TotalGpuBytes = 0;
+	TextureAuditor.Run(GetNormalizedSelectedRoots(), Findings, TotalGpuBytes);
+	if (Findings.Num() == 0)
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("No texture setting problem found under selected folder"), false);
+		return;
+	}
+
+	TArray< TSharedPtr <FAssetAuditRow> > FindingRows;
+	int32 FixableCounter = 0;
+	int64 FlaggedGpuBytes = 0;
+	for (const FTextureAuditFinding& Finding : Findings)
+	{
+		TSharedPtr<FAssetAuditRow> Row = MakeShared<FAssetAuditRow>();
+		Row->AssetData = Finding.AssetData;
+		Row->Finding = FString::Printf(TEXT("%.1f MiB. %s"), Finding.EstimatedGpuBytes / (1024.0 * 1024.0), *Finding.Message);
+		Row->Detail = Finding.DescribeFix();
+		Row->bCanFix = Finding.CanFix();
+		FindingRows.Add(Row);
+		FlaggedGpuBytes += Finding.EstimatedGpuBytes;
+		if (Finding.CanFix()) ++FixableCounter;
+	}
+	SAssetAuditReportTable::OpenInWindow(FindingRows, TEXT("Texture Settings Audit"), TEXT("Planned Fix"));
+	if (FixableCounter == 0) return;
+
+	EAppReturnType::Type ConfirmResult = DebugHeader::ShowMsgDialog(EAppMsgType::YesNo,
+		FString::Printf(TEXT("%d textures using %.1f MiB of %.1f MiB have setting problems.\nWould you like to fix %d of them?"),
+			Findings.Num(), FlaggedGpuBytes / (1024.0 * 1024.0), TotalGpuBytes / (1024.0 * 1024.0), FixableCounter), false);
+	if (ConfirmResult == EAppReturnType::No) return;
+
+	const int32 FixedCounter = FTextureSettingsAuditor::Fix(Findings);
+	if (FixedCounter > 0)
+	{
+		DebugHeader::ShowNInfo(TEXT("Successfully fixed ") + FString::FromInt(FixedCounter) + TEXT(" textures"));
+	}
+}
+
+void FSuperManagerModule::OnFindDuplicateMaterialInstancesButtonClicked()
+{
+	FMaterialInstanceDeduplicator Deduplicator;
+	TArray<FMaterialInstanceCluster> Clusters;
+	Deduplicator.Scan(GetNormalizedSelectedRoots(), Clusters);
+	if (Clusters.Num() == 0)
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("No duplicate material instance found under selected folder"), false);
+		return;
+	}
+
+	TArray< TSharedPtr <FAssetAuditRow> > DuplicateRows;
+	for (const FMaterialInstanceCluster& Cluster : Clusters)
+	{
+		for (int32 Index = 1; Index < Cluster.Instances.Num(); ++Index)
+		{
+			TSharedPtr<FAssetAuditRow> Row = MakeShared<FAssetAuditRow>();
+			Row->AssetData = Cluster.Instances[Index];
+			Row->Finding = TEXT("Same parent and parameter values");
+			Row->Detail = Cluster.Instances[0].PackageName.ToString();
+			Row->bCanFix = true;
+			DuplicateRows.Add(Row);
+		}
+	}
+	SAssetAuditReportTable::OpenInWindow(DuplicateRows, TEXT("Duplicate Material Instances"), TEXT("Replace With"));
+
+	EAppReturnType::Type ConfirmResult = DebugHeader::ShowMsgDialog(EAppMsgType::YesNo,
+		FString::FromInt(DuplicateRows.Num()) + TEXT(" duplicate material instances found in ") + FString::FromInt(Clusters.Num())
+		+ TEXT(" groups.\nWould you like to replace their references and delete them?"), false);
+	if (ConfirmResult == EAppReturnType::No) return;
+
+	const int32 ConsolidatedCounter = FMaterialInstanceDeduplicator::Consolidate(Clusters);
+	FixUpRedirectors();
+	if (ConsolidatedCounter > 0)
+	{
+		DebugHeader::ShowNInfo(TEXT("Successfully consolidated ") + FString::FromInt(ConsolidatedCounter) + TEXT(" material instances"));
+	}
+}
+
+void FSuperManagerModule::OnFindDuplicateMaterialGraphsButtonClicked()
+{
+	FMaterialGraphHasher GraphHasher;
+	TArray<FMaterialShaderGroup> Groups;
+	int32 NumMaterials = 0;
+	GraphHasher.Scan(GetNormalizedSelectedRoots(), Groups, NumMaterials);
+	if (Groups.Num() == 0)
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("No duplicate material graph found under selected folder"), false);
+		return;
+	}
+
+	TArray< TSharedPtr <FAssetAuditRow> > DuplicateRows;
+	int32 SavedPermutations = 0;
+	for (const FMaterialShaderGroup& Group : Groups)
+	{
+		SavedPermutations += Group.GetSavedPermutations();
+		for (int32 Index = 1; Index < Group.Materials.Num(); ++Index)
+		{
+			TSharedPtr<FAssetAuditRow> Row = MakeShared<FAssetAuditRow>();
+			Row->AssetData = Group.Materials[Index];
+			Row->Finding = FString::Printf(TEXT("Same shaders, about %d permutations each"), Group.PermutationsPerMaterial);
+			Row->Detail = Group.Materials[0].PackageName.ToString();
+			//Merging graphs is left to the user, the audit only reports
+			Row->bCanFix = false;
+			DuplicateRows.Add(Row);
+		}
+	}
+	SAssetAuditReportTable::OpenInWindow(DuplicateRows, TEXT("Duplicate Material Graphs"), TEXT("Same As"));
+	DebugHeader::ShowNInfo(FString::Printf(TEXT("%d of %d materials duplicate another graph, merging saves about %d permutations"),
+		DuplicateRows.Num(), NumMaterials, SavedPermutations));
+}
+
+void FSuperManagerModule::OnAuditMaterialUsageButtonClicked()
+{
+	FMaterialUsageAuditor UsageAuditor;
+	TArray<FMaterialUsageReport> Reports;
+	UsageAuditor.Run(GetNormalizedSelectedRoots(), Reports);
+	if (Reports.Num() == 0)
+	{
+		DebugHeader::ShowMsgDialog(EAppMsgType::Ok, TEXT("No material found under selected folder"), false);
+		return;
+	}
+
+	TArray< TSharedPtr <FAssetAuditRow> > ReportRows;
+	int32 UnneededFlagCounter = 0;
+	int64 TotalPermutations = 0;
+	int64 TotalPermutationsAfterStripping = 0;
+	for (const FMaterialUsageReport& Report : Reports)
+	{
+		TSharedPtr<FAssetAuditRow> Row = MakeShared<FAssetAuditRow>();
+		Row->AssetData = Report.AssetData;
+		Row->Finding = Report.DescribeFlags();
+		const FString Toggles = Report.DescribeToggles();
+		if (!Toggles.IsEmpty()) Row->Finding += (Row->Finding.IsEmpty() ? TEXT("") : TEXT("; ")) + Toggles;
+		Row->Detail = FString::Printf(TEXT("%lld -> %lld"), Report.EstimatedPermutations, Report.PermutationsAfterStripping);
+		Row->bCanFix = Report.GetNumUnneededFlags() > 0;
+		ReportRows.Add(Row);
+		UnneededFlagCounter += Report.GetNumUnneededFlags();
+		TotalPermutations += Report.EstimatedPermutations;
+		TotalPermutationsAfterStripping += Report.PermutationsAfterStripping;
+	}
+	SAssetAuditReportTable::OpenInWindow(ReportRows, TEXT("Material Usage Flags"), TEXT("Permutations"));
+	if (UnneededFlagCounter == 0) return;
+
+	EAppReturnType::Type ConfirmResult = DebugHeader::ShowMsgDialog(EAppMsgType::YesNo,
+		FString::Printf(TEXT("%d usage flags are not needed by any referencer.\nStripping them cuts about %lld of %lld permutations.\nWould you like to strip them?"),
+			UnneededFlagCounter, TotalPermutations - TotalPermutationsAfterStripping, TotalPermutations), false);
+	if (ConfirmResult == EAppReturnType::No) return;
+
+	const int32 StrippedCounter = FMaterialUsageAuditor::StripUnneededFlags(Reports);
+	if (StrippedCounter > 0)
+	{
+		DebugHeader::ShowNInfo(TEXT("Successfully stripped ") + FString::FromInt(StrippedCounter) + TEXT(" usage flags"));
+	}
+}
+
 void FSuperManagerModule::FixUpRedirectors()
 {
 	TArray<UObjectRedirector*> RedirectorsToFixArray;
@@ -249,12 +517,18 @@ void FSuperManagerModule::RegisterAdvanceDeletionTab()
 TSharedRef<SDockTab> FSuperManagerModule::OnSpawnAdvanceDeletionTab(const FSpawnTabArgs&SpawnTabArgs)
 {
 	if (FolderPathsSelected.Num() == 0) return SNew(SDockTab).TabRole(ETabRole::NomadTab);
+	TArray< TSharedPtr <FAssetData> > AssetsDataToStore = GetAllAssetDataUnderSelectedFolder();
+	TArray<FString> SelectedRootFolders;
+	for (const FSelectedRootAssets& RootAssets : SelectedRootsAssets)
+	{
+		SelectedRootFolders.Add(RootAssets.RootPath);
+	}
 	ConstructedDockTab =
 		SNew(SDockTab).TabRole(ETabRole::NomadTab)
 		[
 			SNew(SAdvanceDeletionTab)
-				.AssetsDataToStore(GetAllAssetDataUnderSelectedFolder())
-				.CurrentSelectedFolder(FolderPathsSelected[0])
+				.AssetsDataToStore(AssetsDataToStore)
+				.SelectedRootFolders(SelectedRootFolders)
 		];
 
 	ConstructedDockTab->SetOnTabClosed(
@@ -262,25 +536,136 @@ TSharedRef<SDockTab> FSuperManagerModule::OnSpawnAdvanceDeletionTab(const FSpawn
 	return ConstructedDockTab.ToSharedRef();
 }
 
+void FSuperManagerModule::RegisterLevelCostProfilerTab()
+{
+	FGlobalTabmanager::Get()->RegisterNomadTabSpawner(FName("LevelCostProfiler"),
+		FOnSpawnTab::CreateRaw(this, &FSuperManagerModule::OnSpawnLevelCostProfilerTab))
+		.SetDisplayName(FText::FromString(TEXT("Level Cost Profiler")));
+}
+
+TSharedRef<SDockTab> FSuperManagerModule::OnSpawnLevelCostProfilerTab(const FSpawnTabArgs& SpawnTabArgs)
+{
+	return SNew(SDockTab).TabRole(ETabRole::NomadTab)
+		[
+			SNew(SLevelCostProfilerTab)
+		];
+}
+
 TArray<TSharedPtr<FAssetData>> FSuperManagerModule::GetAllAssetDataUnderSelectedFolder()
 {
 	TArray< TSharedPtr <FAssetData> > AvaiableAssetsData;
-	TArray<FString> AssetsPathNames = UEditorAssetLibrary::ListAssets(FolderPathsSelected[0]);
-	for (const FString& AssetPathName : AssetsPathNames)
-	{
-		//Don't touch root folder
-		if (AssetPathName.Contains(TEXT("Developers")) ||
-			AssetPathName.Contains(TEXT("Collections")) ||
-			AssetPathName.Contains(TEXT("__ExternalActors__")) ||
-			AssetPathName.Contains(TEXT("__ExternalObjects__")))
+	ScanRootsInParallel(GetNormalizedSelectedRoots(), false, SelectedRootsAssets);
+	for (const FSelectedRootAssets& RootAssets : SelectedRootsAssets)
+	{
+		AvaiableAssetsData.Append(RootAssets.AssetsData);
+	}
+	return AvaiableAssetsData;
+}
+
+//Strip the content browser's virtual prefix and drop roots nested inside another selected root,
+//so every root can be scanned as an independent shard without overlapping another one
+TArray<FString> FSuperManagerModule::GetNormalizedSelectedRoots() const
+{
+	TArray<FString> RootPaths;
+	for (FString FolderPath : FolderPathsSelected)
+	{
+		FolderPath.RemoveFromStart(TEXT("/All"));
+		FolderPath.RemoveFromEnd(TEXT("/"));
+		if (FolderPath.IsEmpty()) continue;
+		RootPaths.AddUnique(FolderPath);
+	}
+	RootPaths.Sort();
+
+	TArray<FString> NormalizedRoots;
+	for (const FString& RootPath : RootPaths)
+	{
+		const bool bNestedInOtherRoot = NormalizedRoots.ContainsByPredicate([&RootPath](const FString& KeptRoot)
+			{
+				return RootPath.StartsWith(KeptRoot + TEXT("/"));
+			});
+		if (!bNestedInOtherRoot)
 		{
-			continue;
+			NormalizedRoots.Add(RootPath);
 		}
-		if (!UEditorAssetLibrary::DoesAssetExist(AssetPathName)) continue;
-		const FAssetData Data = UEditorAssetLibrary::FindAssetData(AssetPathName);
-		AvaiableAssetsData.Add(MakeShared<FAssetData>(Data));
 	}
-	return AvaiableAssetsData;
+	return NormalizedRoots;
+}
+
+void FSuperManagerModule::ScanRootsInParallel(const TArray<FString>& RootPaths, bool bOnlyUnused,
+	TArray<FSelectedRootAssets>& OutRootsAssets)
+{
+	OutRootsAssets.Empty();
+	const double StartTime = FPlatformTime::Seconds();
+	IAssetRegistry& AssetRegistry =
+		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	//Every folder under every root is its own shard, so one big root still spreads across all workers
+	struct FScanShard
+	{
+		int32 RootIndex = 0;
+		FName FolderPath;
+		TArray<FAssetData> FoundAssetsData;
+	};
+	TArray<FScanShard> Shards;
+	for (int32 RootIndex = 0; RootIndex < RootPaths.Num(); ++RootIndex)
+	{
+		TArray<FString> SubPaths;
+		AssetRegistry.GetSubPaths(RootPaths[RootIndex], SubPaths, true);
+		SubPaths.Add(RootPaths[RootIndex]);
+		for (const FString& SubPath : SubPaths)
+		{
+			if (IsPathExcludedFromScan(SubPath)) continue;
+			FScanShard& Shard = Shards.AddDefaulted_GetRef();
+			Shard.RootIndex = RootIndex;
+			Shard.FolderPath = FName(*SubPath);
+		}
+	}
+
+	ParallelFor(Shards.Num(), [&Shards, &AssetRegistry, bOnlyUnused](int32 ShardIndex)
+		{
+			FScanShard& Shard = Shards[ShardIndex];
+			FARFilter Filter;
+			Filter.PackagePaths.Add(Shard.FolderPath);
+			Filter.bRecursivePaths = false;
+			//In-memory assets can only be enumerated on the game thread
+			Filter.bIncludeOnlyOnDiskAssets = true;
+			TArray<FAssetData> ShardAssetsData;
+			AssetRegistry.GetAssets(Filter, ShardAssetsData);
+
+			for (FAssetData& AssetData : ShardAssetsData)
+			{
+				if (bOnlyUnused)
+				{
+					//Never delete levels
+					if (AssetData.AssetClassPath == UWorld::StaticClass()->GetClassPathName()) continue;
+					if (HasPackageReferencers(AssetRegistry, AssetData.PackageName)) continue;
+				}
+				Shard.FoundAssetsData.Add(MoveTemp(AssetData));
+			}
+		});
+
+	//Merge shards back per root, the same package is only listed once
+	OutRootsAssets.SetNum(RootPaths.Num());
+	for (int32 RootIndex = 0; RootIndex < RootPaths.Num(); ++RootIndex)
+	{
+		OutRootsAssets[RootIndex].RootPath = RootPaths[RootIndex];
+	}
+	TSet<FName> MergedPackageNames;
+	int32 MergedCounter = 0;
+	for (FScanShard& Shard : Shards)
+	{
+		for (FAssetData& AssetData : Shard.FoundAssetsData)
+		{
+			bool bAlreadyMerged = false;
+			MergedPackageNames.Add(AssetData.PackageName, &bAlreadyMerged);
+			if (bAlreadyMerged) continue;
+			OutRootsAssets[Shard.RootIndex].AssetsData.Add(MakeShared<FAssetData>(MoveTemp(AssetData)));
+			++MergedCounter;
+		}
+	}
+
+	DebugHeader::PrtLog(FString::Printf(TEXT("Scanned %d folders under %d roots, found %d assets in %.3f seconds"),
+		Shards.Num(), RootPaths.Num(), MergedCounter, FPlatformTime::Seconds() - StartTime));
 }
 
 void FSuperManagerModule::OnAdvanceDeletionTabClosed(TSharedRef<SDockTab> TabToClose)
@@ -289,6 +674,7 @@ void FSuperManagerModule::OnAdvanceDeletionTabClosed(TSharedRef<SDockTab> TabToC
 	{
 		ConstructedDockTab.Reset();
 		FolderPathsSelected.Empty();
+		SelectedRootsAssets.Empty();
 	}
 }
 #pragma endregion
@@ -321,13 +707,21 @@ void FSuperManagerModule::ListUnusedAssetsForAssetList(const TArray<TSharedPtr<F
 	TArray<TSharedPtr<FAssetData>>& OutUnusedAssetsData)
 {
 	OutUnusedAssetsData.Empty();
-	for (const TSharedPtr<FAssetData>& DataSharedPtr : AssetsDataToFilter)
+	IAssetRegistry& AssetRegistry =
+		FModuleManager::LoadModuleChecked<FAssetRegistryModule>(TEXT("AssetRegistry")).Get();
+
+	TArray<bool> UnusedFlags;
+	UnusedFlags.SetNumZeroed(AssetsDataToFilter.Num());
+	ParallelFor(AssetsDataToFilter.Num(), [&AssetsDataToFilter, &AssetRegistry, &UnusedFlags](int32 Index)
+		{
+			UnusedFlags[Index] = !HasPackageReferencers(AssetRegistry, AssetsDataToFilter[Index]->PackageName);
+		});
+
+	for (int32 Index = 0; Index < AssetsDataToFilter.Num(); ++Index)
 	{
-		TArray<FString> AssetReferencers =
-			UEditorAssetLibrary::FindPackageReferencersForAsset(DataSharedPtr->ObjectPath.ToString());
-		if (AssetReferencers.Num() == 0)
+		if (UnusedFlags[Index])
 		{
-			OutUnusedAssetsData.Add(DataSharedPtr);
+			OutUnusedAssetsData.Add(AssetsDataToFilter[Index]);
 		}
 	}
 }
@@ -412,6 +806,13 @@ void FSuperManagerModule::AddLevelEditorMenuEntry(FMenuBuilder& MenuBuilder)
 		FSlateIcon(FSuperManagerStyle::GetStyleSetName(), "LevelEditor.UnlockSelection"),
 		FExecuteAction::CreateRaw(this, &FSuperManagerModule::OnUnlockActorSelectionButtonClicked)
 	);
+	MenuBuilder.AddMenuEntry
+	(
+		FText::FromString(TEXT("Profile Level Cost")),
+		FText::FromString(TEXT("Open a table of triangles, components, shadow casters and ticking actors by class, mesh or folder")),
+		FSlateIcon(),
+		FExecuteAction::CreateRaw(this, &FSuperManagerModule::OnProfileLevelCostButtonClicked)
+	);
 }
 void FSuperManagerModule::OnLockActorSelectionButtonClicked()
 {
@@ -435,6 +836,10 @@ void FSuperManagerModule::OnLockActorSelectionButtonClicked()
 
 	DebugHeader::ShowNInfo(CurrentLockedActorNames);
 }
+void FSuperManagerModule::OnProfileLevelCostButtonClicked()
+{
+	FGlobalTabmanager::Get()->TryInvokeTab(FName("LevelCostProfiler"));
+}
 void FSuperManagerModule::OnUnlockActorSelectionButtonClicked()
 {
 	if (!GetEditorActorSubsystem()) return;
@@ -508,6 +913,24 @@ bool FSuperManagerModule::CheckIsActorSelectionLocked(AActor* ActorToProcess)
 	return ActorToProcess->ActorHasTag(FName("Locked"));
 }
 
+//Don't touch root folders owned by the engine or other users
+bool FSuperManagerModule::IsPathExcludedFromScan(const FString& PathToCheck)
+{
+	return PathToCheck.Contains(TEXT("Developers")) ||
+		PathToCheck.Contains(TEXT("Collections")) ||
+		PathToCheck.Contains(TEXT("__ExternalActors__")) ||
+		PathToCheck.Contains(TEXT("__ExternalObjects__"));
+}
+
+//Hard and soft package references only, searchable name and management references do not keep an asset in use
+bool FSuperManagerModule::HasPackageReferencers(const IAssetRegistry& AssetRegistry, FName PackageName)
+{
+	TArray<FName> Referencers;
+	AssetRegistry.GetReferencers(PackageName, Referencers, UE::AssetRegistry::EDependencyCategory::Package,
+		UE::AssetRegistry::EDependencyQuery::NoRequirements);
+	return Referencers.Num() > 0;
+}
+
 void FSuperManagerModule::RefreshSceneOutliner()
 {
 	FLevelEditorModule& LevelEditorModule =
@@ -592,8 +1015,13 @@ void FSuperManagerModule::ShutdownModule()
 	// This function may be called during shutdown to clean up your module.  For modules that support dynamic reloading,
 	// we call this function before unloading the module.
 	FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(FName("AdvanceDeletion"));
+	FGlobalTabmanager::Get()->UnregisterNomadTabSpawner(FName("LevelCostProfiler"));
 	FSuperManagerStyle::ShutDown();
 	FSuperManagerUICommands::Unregister();
+	FActorLabelIndex::Get().Unregister();
+	FActorSpatialIndex::Get().Unregister();
+	FEditorActorEvents::Get().Unregister();
+	FMaterialParameterSchemaCache::Get().Unregister();
 }
 
 #undef LOCTEXT_NAMESPACE
@@ -0,0 +1,8 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+//Timings of the actor actions and indexes, logged at Verbose. Turn on with -LogCmds="LogSuperManagerActorActions Verbose"
+SUPERMANAGER_API DECLARE_LOG_CATEGORY_EXTERN(LogSuperManagerActorActions, Log, All);
@@ -0,0 +1,67 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+/**
+ * Bounding volume hierarchy over actor bounds, stored as a flat node array.
+ * Built top down by splitting at the median centroid on the longest axis. Moved actors refit their leaf
+ * and its ancestors, added actors wait in a pending list until enough changes pile up to rebuild.
+ */
+class SUPERMANAGER_API FActorBoundsBVH
+{
+public:
+	static constexpr int32 MaxItemsPerLeaf = 4;
+
+	void Build(const TArray<AActor*>& Actors);
+	void Reset();
+	int32 Num() const { return ItemActors.Num() - NumRemovedItems; }
+
+#pragma region IncrementalUpdates
+	void AddActor(AActor* Actor);
+	void RemoveActor(const AActor* Actor);
+	void UpdateActor(AActor* Actor);
+	/** Owners rebuild through Build once this is true, from their own source of actors */
+	bool NeedsRebuild() const;
+#pragma endregion
+
+	bool Overlaps(const FBox& QueryBox) const;
+	void QueryOverlapping(const FBox& QueryBox, TArray<AActor*>& OutActors) const;
+	/** Overlapping actors along with the bounds the hierarchy holds for them, so callers can refine without asking the actor */
+	void ForEachOverlapping(const FBox& QueryBox, TFunctionRef<void(AActor*, const FBox&)> Visitor) const;
+	/** Actors whose bounds come closest to the point, nearest first */
+	void FindNearest(const FVector& Point, int32 MaxActors, TFunctionRef<bool(AActor*)> Filter, TArray<AActor*>& OutActors) const;
+
+private:
+	struct FNode
+	{
+		FBox Bounds = FBox(ForceInit);
+		int32 Parent = INDEX_NONE;
+		int32 LeftChild = INDEX_NONE;
+		int32 RightChild = INDEX_NONE;
+		//Leaves own ItemOrder[FirstItem, FirstItem + NumItems)
+		int32 FirstItem = 0;
+		int32 NumItems = 0;
+
+		bool IsLeaf() const { return LeftChild == INDEX_NONE; }
+	};
+
+	int32 BuildNode(int32 Parent, int32 FirstItem, int32 NumItems);
+	void RefitFromLeaf(int32 LeafIndex);
+
+	template<typename VisitorType>
+	void VisitOverlapping(const FBox& QueryBox, VisitorType&& Visitor) const;
+
+	TArray<FNode> Nodes;
+	TArray<FBox> ItemBounds;
+	TArray< TWeakObjectPtr<AActor> > ItemActors;
+	//Leaf holding each item, INDEX_NONE while the item is pending
+	TArray<int32> ItemLeaves;
+	TBitArray<> ItemRemoved;
+	TArray<int32> ItemOrder;
+	TArray<int32> PendingItems;
+	TMap<TObjectKey<AActor>, int32> ItemIndexByActor;
+	int32 NumRemovedItems = 0;
+};
@@ -0,0 +1,49 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+
+/**
+ * Actors of each editor world bucketed by normalized label stem, "SM_Rock_12" and "SM_Rock3" both land in "sm_rock".
+ * A world is indexed on its first query and kept up to date from the events FEditorActorEvents passes on.
+ * A world whose actors were invalidated drops its index so the next query rebuilds it.
+ */
+class SUPERMANAGER_API FActorLabelIndex
+{
+public:
+	static FActorLabelIndex& Get();
+
+	void Register();
+	void Unregister();
+
+	/** Label without trailing digits and separators, lower case so buckets ignore case */
+	static FString MakeStem(const FString& ActorLabel);
+
+	void FindActorsWithStem(UWorld* World, const FString& Stem, TArray<AActor*>& OutActors);
+	void ForEachActor(UWorld* World, TFunctionRef<void(AActor*)> Visitor);
+
+private:
+	struct FWorldLabelIndex
+	{
+		TMap<FString, TArray< TWeakObjectPtr<AActor> >> ActorsByStem;
+		TMap<TObjectKey<AActor>, FString> StemByActor;
+	};
+
+	FWorldLabelIndex& GetOrBuildWorldIndex(UWorld* World);
+	static void AddActor(FWorldLabelIndex& WorldIndex, AActor* Actor);
+	static void RemoveActor(FWorldLabelIndex& WorldIndex, AActor* Actor);
+	FWorldLabelIndex* FindWorldIndex(const AActor* Actor);
+
+	void OnActorLabelChanged(AActor* Actor);
+	void OnLevelActorAdded(AActor* Actor);
+	void OnLevelActorDeleted(AActor* Actor);
+	void OnWorldActorsInvalidated(UWorld* World);
+
+	TMap<TObjectKey<UWorld>, FWorldLabelIndex> IndexByWorld;
+	FDelegateHandle ActorLabelChangedHandle;
+	FDelegateHandle LevelActorAddedHandle;
+	FDelegateHandle LevelActorDeletedHandle;
+	FDelegateHandle WorldActorsInvalidatedHandle;
+};
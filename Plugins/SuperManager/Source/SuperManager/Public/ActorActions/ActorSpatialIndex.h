@@ -0,0 +1,39 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "ActorActions/ActorBoundsBVH.h"
+
+/**
+ * One bounds hierarchy per editor world, built on its first query and kept current from the events FEditorActorEvents passes on.
+ * A world whose actors were invalidated drops its hierarchy so the next query rebuilds it.
+ */
+class SUPERMANAGER_API FActorSpatialIndex
+{
+public:
+	static FActorSpatialIndex& Get();
+
+	void Register();
+	void Unregister();
+
+	/** Hierarchy of the world, rebuilt first if too many changes piled up */
+	const FActorBoundsBVH& GetWorldBVH(UWorld* World);
+
+private:
+	//Enumerates the world again, actors from levels loaded since the last build get picked up
+	static void BuildWorldBVH(UWorld* World, FActorBoundsBVH& WorldBVH);
+	FActorBoundsBVH* FindWorldBVH(const AActor* Actor);
+
+	void OnActorMoved(AActor* Actor);
+	void OnLevelActorAdded(AActor* Actor);
+	void OnLevelActorDeleted(AActor* Actor);
+	void OnWorldActorsInvalidated(UWorld* World);
+
+	TMap<TObjectKey<UWorld>, FActorBoundsBVH> BVHByWorld;
+	FDelegateHandle ActorMovedHandle;
+	FDelegateHandle LevelActorAddedHandle;
+	FDelegateHandle LevelActorDeletedHandle;
+	FDelegateHandle WorldActorsInvalidatedHandle;
+};
@@ -0,0 +1,27 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+
+/**
+ * Finds where actors come to rest when dropped straight down onto the surface below the bottom of their bounds.
+ * Every trace ignores all the dropped actors, so actors dropped together never land on each other.
+ */
+class SUPERMANAGER_API FActorSurfaceDropper
+{
+public:
+	//Traces start this far above the bottom of the bounds, anything within that height can catch the actor
+	float TraceHeight = 1.f;
+	float TraceDistance = 10000.f;
+	ECollisionChannel TraceChannel = ECC_Visibility;
+	//Sweeps a flat box the size of the bounds footprint instead of a line through the pivot
+	bool bSweepFootprint = false;
+	//Tilts to the surface normal, keeping the facing
+	bool bAlignToNormal = false;
+
+	/** Resting transform of each actor in input order, OutLanded is false where nothing was found below */
+	void FindDropTransforms(UWorld* World, const TArray<AActor*>& Actors,
+		TArray<FTransform>& OutTransforms, TArray<bool>& OutLanded) const;
+};
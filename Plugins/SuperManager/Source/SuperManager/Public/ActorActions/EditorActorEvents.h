@@ -0,0 +1,49 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnEditorActorChanged, AActor*);
+DECLARE_MULTICAST_DELEGATE_OneParam(FOnEditorWorldActorsInvalidated, UWorld*);
+
+/**
+ * One place that listens to the engine for actor changes and passes them on to the per-world actor indexes.
+ * Per-actor events are forwarded as they come. Changes that bring or take actors without per-actor events
+ * (level streaming, World Partition loading, undo/redo, world cleanup) are reported as invalidating a world.
+ */
+class SUPERMANAGER_API FEditorActorEvents
+{
+public:
+	static FEditorActorEvents& Get();
+
+	void Register();
+	void Unregister();
+
+	FOnEditorActorChanged OnActorAdded;
+	FOnEditorActorChanged OnActorDeleted;
+	FOnEditorActorChanged OnActorMoved;
+	FOnEditorActorChanged OnActorLabelChanged;
+	/** Null world means every world, for events that do not say which world changed */
+	FOnEditorWorldActorsInvalidated OnWorldActorsInvalidated;
+
+private:
+	//GEngine does not exist yet when the module starts at PreDefault
+	void RegisterEngineDelegates();
+
+	void OnWorldCleanup(UWorld* World, bool bSessionEnded, bool bCleanupResources);
+	void OnLevelChanged(ULevel* Level, UWorld* World);
+	void OnLevelActorListChanged();
+	void OnPostUndoRedo();
+
+	FDelegateHandle ActorLabelChangedHandle;
+	FDelegateHandle ActorMovedHandle;
+	FDelegateHandle LevelActorAddedHandle;
+	FDelegateHandle LevelActorDeletedHandle;
+	FDelegateHandle WorldCleanupHandle;
+	FDelegateHandle LevelAddedHandle;
+	FDelegateHandle LevelRemovedHandle;
+	FDelegateHandle LevelActorListChangedHandle;
+	FDelegateHandle PostUndoRedoHandle;
+	FDelegateHandle PostEngineInitHandle;
+};
@@ -0,0 +1,62 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+enum class E_LevelCostGrouping : uint8
+{
+	ELCG_Class,
+	ELCG_Mesh,
+	ELCG_Folder,
+	ELCG_MAX
+};
+
+/** Totals of one class, mesh or folder */
+struct FLevelCostRow
+{
+	FString GroupName;
+	int32 NumActors = 0;
+	int32 NumComponents = 0;
+	int64 Lod0Triangles = 0;
+	//Triangles of the last LOD, what the group costs when seen from far away
+	int64 LastLodTriangles = 0;
+	int32 NumMaterialSlots = 0;
+	int32 NumShadowCasters = 0;
+	int32 NumTicking = 0;
+	int32 NumMovable = 0;
+};
+
+/**
+ * Per-actor statistics of one world. Gathering touches UObjects and runs on the game thread into
+ * flat arrays, aggregation only reads those arrays and runs on workers.
+ */
+class SUPERMANAGER_API FLevelCostProfiler
+{
+public:
+	void Gather(UWorld* World);
+	void Aggregate(E_LevelCostGrouping Grouping, TArray< TSharedPtr<FLevelCostRow> >& OutRows) const;
+	int32 NumActors() const { return ActorClassIndices.Num(); }
+
+	static FString GetGroupingName(E_LevelCostGrouping Grouping);
+	static bool ExportCsv(const TArray< TSharedPtr<FLevelCostRow> >& Rows, const FString& FilePath);
+
+private:
+	//Group names, actors store an index into these
+	TArray<FString> ClassNames;
+	TArray<FString> MeshNames;
+	TArray<FString> FolderNames;
+
+	TArray<int32> ActorClassIndices;
+	TArray<int32> ActorMeshIndices;
+	TArray<int32> ActorFolderIndices;
+	TArray<int32> ActorComponentCounts;
+	TArray<int64> ActorLod0Triangles;
+	TArray<int64> ActorLastLodTriangles;
+	TArray<int32> ActorMaterialSlots;
+	TArray<uint8> ActorCastsShadow;
+	TArray<uint8> ActorTicks;
+	TArray<uint8> ActorIsMovable;
+
+	void Reset();
+};
@@ -0,0 +1,20 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Bridson's Poisson-disk sampling over a rectangle, with neighbours found through a grid of cells sized
+ * MinDistance / sqrt(2) so each cell holds at most one point.
+ */
+class SUPERMANAGER_API FPoissonDiskSampler
+{
+public:
+	static constexpr int32 CandidatesPerPoint = 30;
+	//New fronts tried once the active list runs dry, so regions cut in two by rejected areas still fill
+	static constexpr int32 MaxSeedAttempts = 64;
+
+	static void Sample(const FBox2D& Region, float MinDistance, int32 MaxPoints, int32 Seed,
+		TFunctionRef<bool(const FVector2D&)> IsPointAllowed, TArray<FVector2D>& OutPoints);
+};
@@ -4,6 +4,7 @@
 
 #include "CoreMinimal.h"
 #include "EditorUtilityWidget.h"
+#include "Async/ParallelFor.h"
 #include "QuickActorActionsWidget.generated.h"
 
 UENUM(BlueprintType)
@@ -15,6 +16,16 @@ enum class E_DuplicationAxis : uint8
 	EDA_MAX UMETA(DisplayName = "Default Max")
 };
 
+UENUM(BlueprintType)
+enum class E_SimilarActorMatch : uint8
+{
+	ESAM_NameStem UMETA(DisplayName = "Name Stem"),
+	ESAM_Regex UMETA(DisplayName = "Regex"),
+	ESAM_SameClass UMETA(DisplayName = "Same Class"),
+	ESAM_SameMesh UMETA(DisplayName = "Same Mesh"),
+	ESAM_MAX UMETA(DisplayName = "Default Max")
+};
+
 USTRUCT(BlueprintType)
 struct FRandomActorRotation
 {
@@ -54,6 +65,44 @@ public:
 
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ActorBatchSelection")
 	TEnumAsByte<ESearchCase::Type> SearchCase = ESearchCase::IgnoreCase;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ActorBatchSelection")
+	E_SimilarActorMatch SimilarActorMatch = E_SimilarActorMatch::ESAM_NameStem;
+	//Found anywhere in the actor label unless anchored with ^ and $, empty means the selected actor's name stem
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ActorBatchSelection", meta = (EditCondition = "SimilarActorMatch == E_SimilarActorMatch::ESAM_Regex"))
+	FString SimilarNamePattern;
+#pragma endregion
+#pragma region SpatialSelection
+	//Queries are centred on the selected actor, results replace the selection
+	UFUNCTION(BlueprintCallable, Category = "SpatialSelection")
+	void SelectActorsInRadius();
+	UFUNCTION(BlueprintCallable, Category = "SpatialSelection")
+	void SelectActorsInBox();
+	//The selected actor has to be a volume
+	UFUNCTION(BlueprintCallable, Category = "SpatialSelection")
+	void SelectActorsInsideVolume();
+	UFUNCTION(BlueprintCallable, Category = "SpatialSelection")
+	void SelectNearestActors();
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SpatialSelection", meta = (ClampMin = "0.0"))
+	float SpatialQueryRadius = 5000.f;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SpatialSelection")
+	FVector SpatialQueryBoxExtent = FVector(2500.f);
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SpatialSelection", meta = (ClampMin = "1"))
+	int32 SpatialQueryCount = 10;
+	//Empty means any class
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "SpatialSelection")
+	TSubclassOf<AActor> SpatialQueryClass;
+#pragma endregion
+
+#pragma region StackedDuplicates
+	//Selects only the extra copies of plain static mesh actors, deleting the selection keeps one actor of every stack
+	UFUNCTION(BlueprintCallable, Category = "StackedDuplicates")
+	void SelectStackedDuplicates();
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "StackedDuplicates", meta = (ClampMin = "0.01"))
+	float StackedLocationTolerance = 1.f;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "StackedDuplicates", meta = (ClampMin = "0.0"))
+	float StackedRotationTolerance = 1.f;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "StackedDuplicates", meta = (ClampMin = "0.0"))
+	float StackedScaleTolerance = .01f;
 #pragma endregion
 #pragma region ActorBatchDuplication
 	UFUNCTION(BlueprintCallable, Category = "ActorBatchDuplication")
@@ -66,12 +115,69 @@ public:
 	float OffsetDist = 300.f;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ActorBatchDuplication", meta = (ClampMin = "0.0", ClampMax = "360.0", UIMin = "0.0", UIMax = "360.0"))
 	float DuplicationRotationAngle = 0.f;
+	//Static mesh actors become instances of one ISM/HISM actor per mesh and material set
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ActorBatchDuplication")
+	bool bDuplicateAsInstances = false;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ActorBatchDuplication", meta = (EditCondition = "bDuplicateAsInstances"))
+	bool bUseHierarchicalInstances = true;
+#pragma endregion
+
+#pragma region DropToSurface
+	UFUNCTION(BlueprintCallable, Category = "DropToSurface")
+	void DropActorsToSurface();
+	//Traces start this far above the bottom of the bounds, raise it to bring sunken actors back up
+	//but ceilings, bridges and canopies within that height will then catch the actor
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "DropToSurface", meta = (ClampMin = "0.0"))
+	float SnapTraceHeight = 1.f;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "DropToSurface", meta = (ClampMin = "0.0"))
+	float SnapTraceDistance = 10000.f;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "DropToSurface")
+	TEnumAsByte<ECollisionChannel> SnapTraceChannel = ECC_Visibility;
+	//Sweeps the footprint of the actor bounds instead of a line through its pivot
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "DropToSurface")
+	bool bSweepActorFootprint = false;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "DropToSurface")
+	bool bAlignToSurfaceNormal = false;
+#pragma endregion
+
+#pragma region ActorScatter
+	//Fills a box around the first selected actor, or the band around a selected spline, with copies of the selection
+	UFUNCTION(BlueprintCallable, Category = "ActorScatter")
+	void ScatterActors();
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ActorScatter", meta = (ClampMin = "1.0"))
+	float ScatterMinSpacing = 200.f;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ActorScatter")
+	FVector2D ScatterExtent = FVector2D(2000.f, 2000.f);
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ActorScatter", meta = (ClampMin = "0.0"))
+	float ScatterSplineWidth = 500.f;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ActorScatter", meta = (ClampMin = "1", ClampMax = "1000000"))
+	int32 ScatterMaxPoints = 1000;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ActorScatter")
+	int32 ScatterSeed = 0;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ActorScatter")
+	bool bAvoidExistingActors = true;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ActorScatter")
+	bool bScatterAsInstances = true;
+#pragma endregion
+
+#pragma region ActorInstancing
+	UFUNCTION(BlueprintCallable, Category = "ActorInstancing")
+	void MergeActorsIntoInstances();
+	//Only splits actors made by merging, instanced duplication or scatter, foliage and Blueprints are left alone
+	UFUNCTION(BlueprintCallable, Category = "ActorInstancing")
+	void SplitInstancesIntoActors();
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "ActorInstancing")
+	bool bMergeIntoHierarchicalInstances = true;
 #pragma endregion
 
 #pragma region RandomizeActorTransform
 
 	UFUNCTION(BlueprintCallable, Category = "RandomizeActorTransform")
 	void RandomizeActorTransform();
+
+	/** Randomized transform of each actor in input order, seeded per actor so threading never changes the result */
+	void MakeRandomTransforms(const TArray<AActor*>& Actors, TArray<FTransform>& OutTransforms,
+		EParallelForFlags ParallelForFlags = EParallelForFlags::None) const;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "RandomizeActorTransform")
 	FRandomActorRotation RandomActorRotation;
 
@@ -87,6 +193,9 @@ public:
 	float OffsetMin = -50.f;
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "RandomizeActorTransform", meta = (EditCondition = "bRandomizeOffset"))
 	float OffsetMax = 50.f;
+	//Same seed and selection always give the same transforms
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "RandomizeActorTransform")
+	int32 RandomSeed = 0;
 #pragma endregion
 
 private:
@@ -94,4 +203,16 @@ private:
 	class UEditorActorSubsystem* EditorActorSubsystem;
 
 	bool GetEditorActorSubsystem();
+
+	void FindSimilarActors(AActor* ReferenceActor, TArray<AActor*>& OutSimilarActors) const;
+
+	FTransform MakeRandomTransform(const FTransform& CurrentTransform, int32 ActorSeed) const;
+
+	bool ComputeDuplicationOffset(int32 DuplicateIndex, float CosTheta, float SinTheta, FVector& OutOffset) const;
+	AActor* GetSpatialQueryReferenceActor();
+	bool PassesSpatialQueryClass(const AActor* Actor) const;
+	void ApplySpatialQueryResult(AActor* ReferenceActor, const TArray<AActor*>& FoundActors, double QueryStartTime);
+
+	int32 DuplicateActorsAsInstances(const TArray<AActor*>& SourceActors, float CosTheta, float SinTheta,
+		class FScopedActorBatch& ActorBatch, TArray<AActor*>& OutNonMeshActors);
 };
\ No newline at end of file
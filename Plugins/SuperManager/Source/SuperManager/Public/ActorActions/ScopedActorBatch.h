@@ -0,0 +1,55 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ScopedTransaction.h"
+
+class FComponentRecreateRenderStateContext;
+
+/**
+ * Runs an actor action as one undo step. Selection changes, move notifications and the render state
+ * of touched actors are held back and sent or recreated once when the scope closes, and the per-actor cost is logged at Verbose.
+ */
+class SUPERMANAGER_API FScopedActorBatch
+{
+public:
+	explicit FScopedActorBatch(const FText& SessionName);
+	~FScopedActorBatch();
+
+	FScopedActorBatch(const FScopedActorBatch&) = delete;
+	FScopedActorBatch& operator=(const FScopedActorBatch&) = delete;
+
+	/** Records the actor for undo, once per scope */
+	void ModifyActor(AActor* Actor);
+
+	/** Teleports the actor, PostEditMove runs and its render state is recreated when the scope closes */
+	void SetActorTransform(AActor* Actor, const FTransform& NewTransform);
+
+	/** Drops the render state of the actor's components until the scope closes, for actors changed many times */
+	void SuspendRenderState(AActor* Actor);
+
+	/** Actors created inside the scope that should be counted and selected */
+	void AddSpawnedActor(AActor* Actor, bool bSelect = true);
+
+	/** Queues the actor for the single selection update at the end */
+	void SelectActor(AActor* Actor);
+
+	/** Clears the current selection before the queued actors are selected */
+	void DeselectAll() { bDeselectAll = true; }
+
+	int32 NumSelectedActors() const { return ActorsToSelect.Num(); }
+
+private:
+	FScopedTransaction Transaction;
+	FString SessionName;
+	double StartTime;
+	int32 NumSpawnedActors = 0;
+	bool bDeselectAll = false;
+
+	TSet<AActor*> ModifiedActors;
+	TSet<AActor*> SuspendedActors;
+	TSet<AActor*> MovedActors;
+	TArray<TUniquePtr<FComponentRecreateRenderStateContext>> SuspendedRenderStates;
+	TArray<AActor*> ActorsToSelect;
+};
@@ -0,0 +1,32 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class USplineComponent;
+
+/**
+ * Band of a given half width around a spline, seen from above. The spline is sampled once into segments
+ * bucketed in a grid, so each query only measures the few segments near the point.
+ */
+class SUPERMANAGER_API FSplineBand
+{
+public:
+	void Build(const USplineComponent* Spline, float InHalfWidth);
+
+	/** Returns false if the point lies outside the band, OutHeight is the spline height at the closest location */
+	bool FindClosestHeight(const FVector2D& Point, double& OutHeight) const;
+
+	/** Bounds of the band, the spline bounds grown by the half width */
+	const FBox2D& GetBounds() const { return Bounds; }
+
+private:
+	FIntPoint CellOf(const FVector2D& Point) const;
+
+	TArray<FVector> SegmentPoints;
+	TMap<FIntPoint, TArray<int32>> SegmentsByCell;
+	FBox2D Bounds = FBox2D(ForceInit);
+	double HalfWidth = 0.0;
+	double CellSize = 1.0;
+};
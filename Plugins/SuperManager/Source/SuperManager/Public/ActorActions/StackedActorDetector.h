@@ -0,0 +1,24 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * Finds actors sitting on top of an identical actor. Actors are bucketed by what they draw and by their
+ * location snapped to a grid of LocationTolerance, so each actor is only compared with the 27 cells around it.
+ * Only plain static mesh actors are considered, other actors can differ in settings no key captures.
+ */
+class SUPERMANAGER_API FStackedActorDetector
+{
+public:
+	float LocationTolerance = 1.f;
+	float RotationToleranceDegrees = 1.f;
+	float ScaleTolerance = .01f;
+
+	/** Every actor after the first of its stack, in input order, so deleting them keeps one of each */
+	void FindStackedDuplicates(const TArray<AActor*>& Actors, TArray<AActor*>& OutDuplicates) const;
+
+private:
+	bool AreTransformsCoincident(const FTransform& TransformA, const FTransform& TransformB) const;
+};
@@ -0,0 +1,70 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UStaticMesh;
+class UMaterialInterface;
+class UStaticMeshComponent;
+class UInstancedStaticMeshComponent;
+class ULevel;
+
+/** Everything that has to match for two meshes to be drawn by one instanced component */
+struct FStaticMeshInstanceKey
+{
+	UStaticMesh* StaticMesh = nullptr;
+	TArray<UMaterialInterface*> Materials;
+	FName CollisionProfileName;
+
+	static FStaticMeshInstanceKey FromComponent(const UStaticMeshComponent* MeshComponent);
+
+	bool operator==(const FStaticMeshInstanceKey& Other) const
+	{
+		return StaticMesh == Other.StaticMesh && Materials == Other.Materials &&
+			CollisionProfileName == Other.CollisionProfileName;
+	}
+	friend uint32 GetTypeHash(const FStaticMeshInstanceKey& Key)
+	{
+		uint32 Hash = HashCombine(GetTypeHash(Key.StaticMesh), GetTypeHash(Key.CollisionProfileName));
+		for (const UMaterialInterface* Material : Key.Materials)
+		{
+			Hash = HashCombine(Hash, GetTypeHash(Material));
+		}
+		return Hash;
+	}
+};
+
+struct FInstanceMergeReport
+{
+	int32 SourceActors = 0;
+	int32 InstanceActors = 0;
+	int32 SkippedActors = 0;
+	//One draw per mesh section for each actor before, one per section for each instanced actor after
+	int32 DrawCallsBefore = 0;
+	int32 DrawCallsAfter = 0;
+};
+
+class SUPERMANAGER_API FStaticMeshInstancer
+{
+public:
+	/**
+	 * Mesh component of a plain static mesh actor whose only primitive it is, null for anything else.
+	 * Blueprints and actors with extra components would lose them when turned into an instance.
+	 */
+	static UStaticMeshComponent* FindSourceMeshComponent(AActor* Actor);
+
+	/** Spawns an actor into the level whose root is an empty ISM or HISM component set up from the key */
+	static UInstancedStaticMeshComponent* SpawnInstanceActor(ULevel* Level, const FStaticMeshInstanceKey& Key,
+		const FTransform& ActorTransform, bool bHierarchical, const FString& ActorLabel);
+
+	/** Replaces static mesh actors with one instanced actor per key and level, the caller owns the transaction */
+	static FInstanceMergeReport MergeIntoInstances(const TArray<AActor*>& Actors, bool bHierarchical,
+		TArray<AActor*>& OutInstanceActors);
+
+	/** Actor made by SpawnInstanceActor: a plain actor holding nothing but its instanced root */
+	static bool IsInstanceActor(const AActor* Actor);
+
+	/** Turns every instance of the instance actors back into a static mesh actor, other actors are left alone */
+	static int32 SplitInstances(const TArray<AActor*>& Actors, TArray<AActor*>& OutSpawnedActors);
+};
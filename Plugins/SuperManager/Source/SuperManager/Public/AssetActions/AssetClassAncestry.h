@@ -0,0 +1,57 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/TopLevelAssetPath.h"
+
+/**
+ * Maps asset class paths to their class ancestry using the asset registry's inheritance data,
+ * so rules keyed by a base class also apply to subclasses without loading any asset.
+ */
+class SUPERMANAGER_API FAssetClassAncestry
+{
+public:
+	/** Resolve and store the ancestry of every class path, call on the game thread before reading in parallel */
+	void Precompute(const TSet<FTopLevelAssetPath>& ClassPaths);
+
+	/** The class path itself followed by its ancestors, nearest first */
+	const TArray<FTopLevelAssetPath>& GetAncestry(const FTopLevelAssetPath& ClassPath);
+
+	/** Same as GetAncestry but never modifies the table, returns nullptr if the class was not precomputed */
+	const TArray<FTopLevelAssetPath>* FindAncestry(const FTopLevelAssetPath& ClassPath) const { return AncestryTable.Find(ClassPath); }
+
+	bool IsChildOf(const FTopLevelAssetPath& ClassPath, const FTopLevelAssetPath& BaseClassPath);
+
+	/** Value registered for the nearest class in the ancestry of ClassPath */
+	template<typename ValueType>
+	const ValueType* FindNearest(const TMap<FTopLevelAssetPath, ValueType>& ValuesByClassPath, const FTopLevelAssetPath& ClassPath)
+	{
+		for (const FTopLevelAssetPath& AncestorPath : GetAncestry(ClassPath))
+		{
+			if (const ValueType* FoundValue = ValuesByClassPath.Find(AncestorPath))
+			{
+				return FoundValue;
+			}
+		}
+		return nullptr;
+	}
+
+	template<typename ValueType>
+	const ValueType* FindNearestPrecomputed(const TMap<FTopLevelAssetPath, ValueType>& ValuesByClassPath, const FTopLevelAssetPath& ClassPath) const
+	{
+		const TArray<FTopLevelAssetPath>* Ancestry = FindAncestry(ClassPath);
+		if (!Ancestry) return nullptr;
+		for (const FTopLevelAssetPath& AncestorPath : *Ancestry)
+		{
+			if (const ValueType* FoundValue = ValuesByClassPath.Find(AncestorPath))
+			{
+				return FoundValue;
+			}
+		}
+		return nullptr;
+	}
+
+private:
+	TMap<FTopLevelAssetPath, TArray<FTopLevelAssetPath>> AncestryTable;
+};
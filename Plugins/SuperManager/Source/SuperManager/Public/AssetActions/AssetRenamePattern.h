@@ -0,0 +1,54 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Internationalization/Regex.h"
+#include "AssetRenamePattern.generated.h"
+
+UENUM(BlueprintType)
+enum class ERenamePatternMode : uint8
+{
+	ERPM_Substring UMETA(DisplayName = "Substring"),
+	ERPM_Regex UMETA(DisplayName = "Regex"),
+	ERPM_Glob UMETA(DisplayName = "Glob")
+};
+
+/**
+ * Search pattern and replacement compiled once per rename invocation.
+ * Substring mode inserts the replacement as typed. Regex and Glob replacements take tokens:
+ * $0-$9 capture groups, $$ literal dollar, {#} counter ({###} zero pads to 3 digits),
+ * \U and \L upper/lower case until \E.
+ * Glob patterns must match the whole name, * and ? become capture groups $1, $2...
+ */
+class SUPERMANAGER_API FAssetRenamePattern
+{
+public:
+	FAssetRenamePattern(ERenamePatternMode InMode, const FString& InSearchPattern, const FString& InReplacement);
+
+	/** Returns false if OldName does not match, Counter is substituted for {#} tokens */
+	bool Apply(const FString& OldName, int32 Counter, FString& OutNewName) const;
+
+	/** The regex engine fails silently on a broken pattern, so it is checked up front */
+	bool IsValid(FString& OutError) const;
+
+	static FString GlobToRegex(const FString& GlobPattern);
+
+private:
+	struct FReplacementToken
+	{
+		enum class EType : uint8 { Literal, Capture, Counter, UpperCase, LowerCase, EndCase };
+		EType Type = EType::Literal;
+		FString Literal;
+		int32 Value = 0;
+	};
+
+	void TokenizeReplacement(const FString& Replacement);
+	FString ExpandReplacement(const FRegexMatcher* Matcher, const FString& WholeMatch, int32 Counter) const;
+
+	ERenamePatternMode Mode;
+	FString SearchPattern;
+	FString Replacement;
+	TOptional<FRegexPattern> CompiledPattern;
+	TArray<FReplacementToken> ReplacementTokens;
+};
@@ -0,0 +1,42 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+
+/** One planned rename, shown in the preview table */
+struct FAssetRenamePreviewRow
+{
+	FAssetData AssetData;
+	FString NewName;
+	FString Status;
+	bool bCanRename = false;
+};
+
+/**
+ * Collects planned renames, checks them for collisions up front and submits them
+ * as one IAssetTools::RenameAssets call followed by a single redirector fixup.
+ * Renames onto a name another row frees (chains and swaps) move that source aside first.
+ */
+class SUPERMANAGER_API FBatchAssetRenamer
+{
+public:
+	void AddRename(const FAssetData& AssetData, const FString& NewName);
+
+	/** Check new names against existing packages in the target folders and against each other, returns the number of collisions */
+	int32 DetectCollisions();
+
+	/** Rename every row without collision, returns the number of renamed assets */
+	int32 Submit();
+
+	const TArray< TSharedPtr <FAssetRenamePreviewRow> >& GetRows() const { return Rows; }
+	int32 GetNumRenamable() const;
+	void LogPreviewTable() const;
+
+private:
+	void FixUpRenamedRedirectors(const TArray<FSoftObjectPath>& OldObjectPaths);
+
+	TArray< TSharedPtr <FAssetRenamePreviewRow> > Rows;
+	bool bCollisionsDetected = false;
+};
@@ -0,0 +1,45 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+#include "Misc/SecureHash.h"
+
+class UMaterial;
+
+/** Materials whose graphs hash the same and therefore compile the same shaders, the first one is kept when merging */
+struct FMaterialShaderGroup
+{
+	FSHAHash StructuralHash;
+	TArray<FAssetData> Materials;
+	int32 PermutationsPerMaterial = 0;
+
+	int32 GetSavedPermutations() const { return (Materials.Num() - 1) * PermutationsPerMaterial; }
+};
+
+/**
+ * Hashes the structure of material expression graphs: node types, node settings, connections and the
+ * material settings that change the generated shader. Layout, comments and nodes that do not reach a
+ * material input are ignored, so hand-copied variants of one graph hash the same.
+ */
+class SUPERMANAGER_API FMaterialGraphHasher
+{
+public:
+	/** Materials loaded per batch, each batch is hashed in parallel before the next one is loaded */
+	int32 BatchSize = 64;
+
+	void Scan(const TArray<FString>& RootPaths, TArray<FMaterialShaderGroup>& OutGroups, int32& OutNumMaterials) const;
+
+	/** Reads the loaded material only, safe to call from workers while the game thread waits. False for cyclic graphs */
+	static bool ComputeStructuralHash(const UMaterial* Material, FSHAHash& OutHash);
+
+	/** One permutation per vertex factory the usage flags enable, on top of the default local vertex factory */
+	static int32 EstimatePermutations(const UMaterial* Material);
+
+private:
+	static void AppendMaterialSettings(const UMaterial* Material, FSHA1& HashState);
+	/** Settings as text with every node reference written as @, the referenced objects are listed in the same order */
+	static void DescribeExpressionSettings(const class UMaterialExpression* Expression, FString& OutDescription,
+		TArray<const UObject*>& OutReferences);
+};
@@ -0,0 +1,44 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+#include "Misc/SecureHash.h"
+#include "IO/IoHash.h"
+
+class UMaterialInstanceConstant;
+
+/** Material instances sharing one fingerprint, the first instance is the one the others are consolidated into */
+struct FMaterialInstanceCluster
+{
+	FSHAHash Fingerprint;
+	TArray<FAssetData> Instances;
+};
+
+/**
+ * Finds material instance constants that render identically: same parent chain, same static switch
+ * permutation and same parameter overrides. Fingerprints are cached by package saved hash so only
+ * instances saved since the last scan are loaded again.
+ */
+class SUPERMANAGER_API FMaterialInstanceDeduplicator
+{
+public:
+	void Scan(const TArray<FString>& RootPaths, TArray<FMaterialInstanceCluster>& OutClusters);
+
+	/** Replace references to every duplicate with its cluster's first instance, returns the number of replaced instances */
+	static int32 Consolidate(const TArray<FMaterialInstanceCluster>& Clusters);
+
+	/** Canonical text of everything that makes the instance render differently, hashed into the fingerprint */
+	static FString BuildCanonicalDescription(const UMaterialInstanceConstant* MaterialInstance);
+
+private:
+	struct FCachedFingerprint
+	{
+		FIoHash PackageSavedHash;
+		FSHAHash Fingerprint;
+	};
+	static TMap<FName, FCachedFingerprint> FingerprintCache;
+
+	static void SortClusterByReferencers(FMaterialInstanceCluster& Cluster);
+};
@@ -0,0 +1,56 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/ObjectKey.h"
+#include "AssetActions/QuickMaterialCreationWidget.h"
+
+class UMaterialInterface;
+class UTexture;
+class FObjectPostSaveContext;
+
+/** One texture parameter of a parent material and the texture role it expects */
+struct FTextureParameterSlot
+{
+	FName ParameterName;
+	TEnumAsByte<EMaterialSamplerType> SamplerType = SAMPLERTYPE_Color;
+	E_TextureRole ExpectedRole = E_TextureRole::ETR_MAX;
+	bool bExpectsPackedOrm = false;
+	TWeakObjectPtr<UTexture> DefaultTexture;
+};
+
+/** Texture parameters of a parent material, built once so binding a texture is a lookup */
+struct FMaterialParameterSchema
+{
+	TMap<FName, FTextureParameterSlot> TextureSlots;
+	FName ParameterNameByRole[(int32)E_TextureRole::ETR_MAX];
+	FName PackedOrmParameterName;
+
+	/** Parent and every material up its chain, saving any of them invalidates the schema */
+	TArray<FName> SourcePackageNames;
+	/** Role classifier the expected roles came from */
+	uint32 ClassifierHash = 0;
+
+	const FTextureParameterSlot* FindSlotForRole(E_TextureRole TextureRole) const;
+	const FTextureParameterSlot* FindPackedOrmSlot() const { return TextureSlots.Find(PackedOrmParameterName); }
+};
+
+/** Schemas per parent material, dropped when a package they were built from is saved */
+class SUPERMANAGER_API FMaterialParameterSchemaCache
+{
+public:
+	static FMaterialParameterSchemaCache& Get();
+
+	void Register();
+	void Unregister();
+
+	const FMaterialParameterSchema* Find(const UMaterialInterface* ParentMaterial, uint32 ClassifierHash) const;
+	const FMaterialParameterSchema& Add(const UMaterialInterface* ParentMaterial, FMaterialParameterSchema&& Schema);
+
+private:
+	void OnPackageSaved(const FString& PackageFileName, UPackage* SavedPackage, FObjectPostSaveContext SaveContext);
+
+	TMap<FObjectKey, FMaterialParameterSchema> SchemasByParent;
+	FDelegateHandle PackageSavedHandle;
+};
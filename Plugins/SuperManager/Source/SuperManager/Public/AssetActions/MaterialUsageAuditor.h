@@ -0,0 +1,69 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+#include "MaterialShared.h"
+
+enum class E_UsageFlagNeed : uint8
+{
+	EUFN_Needed,
+	EUFN_PossiblyNeeded,
+	EUFN_Unneeded,
+	//The registry can not tell which assets rely on this flag
+	EUFN_Unknown
+};
+
+struct FMaterialUsageFlag
+{
+	EMaterialUsage Usage = MATUSAGE_MAX;
+	E_UsageFlagNeed Need = E_UsageFlagNeed::EUFN_Unknown;
+};
+
+struct FMaterialUsageReport
+{
+	FAssetData AssetData;
+	TArray<FMaterialUsageFlag> EnabledFlags;
+	int32 NumStaticSwitchBits = 0;
+	int32 NumChildInstances = 0;
+	bool bHasQualitySwitch = false;
+	bool bHasFeatureLevelSwitch = false;
+	bool bHasShadingPathSwitch = false;
+	int64 EstimatedPermutations = 0;
+	int64 PermutationsAfterStripping = 0;
+
+	int32 GetNumUnneededFlags() const;
+	FString DescribeFlags() const;
+	FString DescribeToggles() const;
+};
+
+/**
+ * Lists usage flags, static switches and quality/feature level toggles of materials and estimates the shader
+ * permutations they imply, without compiling anything. The referencers of each material, through its instances
+ * and static meshes, tell which usage flags real assets need.
+ * Switches inside material functions and references made only from code or soft paths are not seen.
+ */
+class SUPERMANAGER_API FMaterialUsageAuditor
+{
+public:
+	void Run(const TArray<FString>& RootPaths, TArray<FMaterialUsageReport>& OutReports) const;
+
+	/** Clear every unneeded usage flag and save the touched materials in one pass, returns the number of stripped flags */
+	static int32 StripUnneededFlags(const TArray<FMaterialUsageReport>& Reports);
+
+	static const TCHAR* LexNeed(E_UsageFlagNeed Need);
+
+private:
+	/** Asset classes met while walking referencers, split by whether a static mesh was in between */
+	struct FMaterialUsers
+	{
+		TSet<FTopLevelAssetPath> DirectUserClasses;
+		TSet<FTopLevelAssetPath> MeshUserClasses;
+		int32 NumChildInstances = 0;
+	};
+
+	static void CollectUsers(const IAssetRegistry& AssetRegistry, FName MaterialPackageName, FMaterialUsers& OutUsers);
+	static E_UsageFlagNeed ClassifyNeed(EMaterialUsage Usage, const FMaterialUsers& Users);
+	static int64 EstimatePermutations(int32 NumUsageFlags, const FMaterialUsageReport& Report);
+};
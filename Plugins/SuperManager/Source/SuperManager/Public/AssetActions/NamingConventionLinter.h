@@ -0,0 +1,70 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/DeveloperSettings.h"
+#include "AssetRegistry/AssetData.h"
+#include "AssetActions/AssetClassAncestry.h"
+#include "NamingConventionLinter.generated.h"
+
+/** Naming rule for one asset class, the rule of the nearest class in an asset's ancestry applies */
+USTRUCT(BlueprintType)
+struct FNamingConventionRule
+{
+	GENERATED_BODY()
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "NamingConvention", meta = (AllowAbstract = "true"))
+	FSoftClassPath AssetClass;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "NamingConvention")
+	FString Prefix;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "NamingConvention")
+	FString Suffix;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "NamingConvention")
+	FString ForbiddenCharacters = TEXT(" -.");
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "NamingConvention", meta = (ClampMin = "0"))
+	int32 MaxLength = 0;
+};
+
+/**
+ * Project wide naming rules, shown under Project Settings > Plugins.
+ * When no rule is configured the prefixes of UQuickAssetAction::PrefixMap are used.
+ */
+UCLASS(config = Editor, defaultconfig, meta = (DisplayName = "Super Manager Naming Conventions"))
+class SUPERMANAGER_API UNamingConventionSettings : public UDeveloperSettings
+{
+	GENERATED_BODY()
+
+public:
+	UPROPERTY(config, EditAnywhere, Category = "NamingConvention")
+	TArray<FNamingConventionRule> Rules;
+
+	TArray<FNamingConventionRule> GetEffectiveRules() const;
+
+	virtual FName GetCategoryName() const override { return FName("Plugins"); }
+};
+
+struct FNamingViolation
+{
+	FAssetData AssetData;
+	FString Message;
+	FString SuggestedName;
+	bool bCanAutoFix = false;
+};
+
+/** Checks asset names against naming rules using registry data only, no package is loaded */
+class SUPERMANAGER_API FNamingConventionLinter
+{
+public:
+	explicit FNamingConventionLinter(const TArray<FNamingConventionRule>& Rules);
+
+	void Run(const TArray<FString>& RootPaths, TArray<FNamingViolation>& OutViolations);
+
+	/** Feed every fixable violation into one batched rename, returns the number of renamed assets */
+	static int32 AutoFix(const TArray<FNamingViolation>& Violations);
+
+private:
+	static bool CheckName(const FString& AssetName, const FNamingConventionRule& Rule, FNamingViolation& OutViolation);
+
+	TMap<FTopLevelAssetPath, FNamingConventionRule> RulesByClassPath;
+	FAssetClassAncestry ClassAncestry;
+};
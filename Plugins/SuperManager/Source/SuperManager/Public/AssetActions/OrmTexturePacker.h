@@ -0,0 +1,32 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class UTexture2D;
+
+/**
+ * Packs ambient occlusion, roughness and metallic textures into the R, G and B channels of one linear mask texture.
+ * Inputs of different sizes are resampled to the largest one, missing inputs are filled with a neutral value.
+ */
+class SUPERMANAGER_API FOrmTexturePacker
+{
+public:
+	static UTexture2D* CreatePackedTexture(UTexture2D* AmbientOcclusionTexture, UTexture2D* RoughnessTexture,
+		UTexture2D* MetallicTexture, const FString& PackagePath, const FString& NameOfTheTexture);
+
+private:
+	/** One 8 bit channel plane read from the first mip of a texture source */
+	struct FChannelPlane
+	{
+		TArray64<uint8> Pixels;
+		int32 SizeX = 0;
+		int32 SizeY = 0;
+	};
+
+	static bool ReadChannelPlane(UTexture2D* SourceTexture, FChannelPlane& OutPlane);
+	static void ResamplePlane(const FChannelPlane& SourcePlane, int32 DestSizeX, int32 DestSizeY, FChannelPlane& OutPlane);
+	static void InterleavePlanes(const uint8* AmbientOcclusion, const uint8* Roughness, const uint8* Metallic,
+		int32 SizeX, int32 SizeY, uint8* OutBGRA);
+};
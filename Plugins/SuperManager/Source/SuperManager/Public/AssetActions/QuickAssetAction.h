@@ -12,6 +12,8 @@
 #include "Components/SkeletalMeshComponent.h"
 #include "NiagaraSystem.h"
 #include "NiagaraEmitter.h"	
+#include "AssetActions/AssetClassAncestry.h"
+#include "AssetActions/AssetRenamePattern.h"
 
 #include "QuickAssetAction.generated.h"
 
@@ -34,7 +36,9 @@ public:
 	void RemoveUnusedAssets();
 
 	UFUNCTION(CallInEditor)
-	void RenameAssets(const FString& NamePattern, const FString& ReplaceWith, bool bPreviewOnly);
+	void RenameAssets(const FString& NamePattern, const FString& ReplaceWith, ERenamePatternMode PatternMode, bool bPreviewOnly);
+
+	const TMap<UClass*, FString>& GetPrefixMap() const { return PrefixMap; }
 
 private:
 	TMap<UClass*, FString>PrefixMap =
@@ -55,7 +59,13 @@ private:
 		{UNiagaraEmitter::StaticClass(), TEXT("NE_")}
 	};
 
+	//PrefixMap keyed by class path, prefixes are resolved through the class ancestry so subclasses are covered
+	TMap<FTopLevelAssetPath, FString> PrefixMapByClassPath;
+	const TMap<FTopLevelAssetPath, FString>& GetPrefixMapByClassPath();
+	FAssetClassAncestry ClassAncestry;
+
 	void FixUpRedirectors();
+	uint32 SaveDuplicatedPackages(const TArray<UObject*>& DuplicatedObjects);
 	
 	
 };
\ No newline at end of file
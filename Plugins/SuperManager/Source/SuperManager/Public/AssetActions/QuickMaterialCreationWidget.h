@@ -3,6 +3,7 @@
 #include "Materials/MaterialExpressionTextureSample.h"
 #include "CoreMinimal.h"
 #include "EditorUtilityWidget.h"
+#include "AssetActions/TextureRoleClassifier.h"
 #include "QuickMaterialCreationWidget.generated.h"
 
 // Forward declarations
@@ -10,6 +11,43 @@ class UMaterialExpressionTextureSampleParameter2D;
 class UMaterial;
 class UMaterialInterface;
 
+UENUM(BlueprintType)
+enum class E_TextureRole : uint8
+{
+	ETR_BaseColor UMETA(DisplayName = "Base Color"),
+	ETR_Metallic UMETA(DisplayName = "Metallic"),
+	ETR_Roughness UMETA(DisplayName = "Roughness"),
+	ETR_Normal UMETA(DisplayName = "Normal"),
+	ETR_AmbientOcclusion UMETA(DisplayName = "Ambient Occlusion"),
+	ETR_MAX UMETA(DisplayName = "Default Max")
+};
+
+UENUM(BlueprintType)
+enum class E_BulkParameterOperation : uint8
+{
+	EBPO_Set UMETA(DisplayName = "Set"),
+	EBPO_Offset UMETA(DisplayName = "Offset"),
+	EBPO_Clear UMETA(DisplayName = "Clear Override"),
+	EBPO_MAX UMETA(Hidden)
+};
+
+UENUM(BlueprintType)
+enum class E_BulkParameterType : uint8
+{
+	EBPT_Scalar UMETA(DisplayName = "Scalar"),
+	EBPT_Vector UMETA(DisplayName = "Vector"),
+	EBPT_Texture UMETA(DisplayName = "Texture"),
+	EBPT_MAX UMETA(Hidden)
+};
+
+/** Textures sharing one name stem, one material or material instance is created per set */
+struct FTextureSet
+{
+	FString Stem;
+	FName PackagePath;
+	FAssetData TexturesByRole[(int32)E_TextureRole::ETR_MAX];
+};
+
 /**
  *
  */
@@ -46,6 +84,67 @@ public:
 	void CreateMaterialInstanceFromParent();
 #pragma endregion
 
+#pragma region BatchMaterialCreation
+
+	UFUNCTION(BlueprintCallable, Category = "BatchMaterialCreation")
+	void CreateMaterialsFromTextureFolder();
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "BatchMaterialCreation")
+	FString TextureSetFolder = TEXT("/Game/TestTextures");
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "BatchMaterialCreation")
+	bool bSearchSubFolders = true;
+
+	//Create material instances of ParentMaterial instead of new materials
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "BatchMaterialCreation")
+	bool bCreateInstancesForSets = false;
+
+	//Compile every created material at the end of the batch and wait for the shaders once
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "BatchMaterialCreation")
+	bool bDeferCompilationAcrossBatch = true;
+
+	//Pack ambient occlusion, roughness and metallic of each set into one T_<Stem>_ORM texture bound to VT_ORM
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "BatchMaterialCreation", meta = (EditCondition = "bCreateInstancesForSets"))
+	bool bPackOrmTextures = false;
+#pragma endregion
+
+#pragma region BulkParameterEditing
+
+	//Edit one parameter override on every target instance inside one transaction
+	UFUNCTION(BlueprintCallable, Category = "BulkParameterEditing")
+	void EditParametersOfMaterialInstances();
+
+	//Edit the selected material instances, otherwise every instance under BulkQueryFolder
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "BulkParameterEditing")
+	bool bBulkEditSelectedInstances = true;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "BulkParameterEditing", meta = (EditCondition = "!bBulkEditSelectedInstances"))
+	FString BulkQueryFolder = TEXT("/Game");
+
+	//Only query instances whose direct parent is this material, leave empty for every instance
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "BulkParameterEditing", meta = (EditCondition = "!bBulkEditSelectedInstances"))
+	UMaterialInterface* BulkQueryParent = nullptr;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "BulkParameterEditing")
+	FName BulkParameterName;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "BulkParameterEditing")
+	E_BulkParameterType BulkParameterType = E_BulkParameterType::EBPT_Scalar;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "BulkParameterEditing")
+	E_BulkParameterOperation BulkOperation = E_BulkParameterOperation::EBPO_Set;
+
+	//Value to set, or to add for offsets
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "BulkParameterEditing")
+	float BulkScalarValue = 0.f;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "BulkParameterEditing")
+	FLinearColor BulkVectorValue = FLinearColor::Black;
+
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "BulkParameterEditing")
+	class UTexture* BulkTextureValue = nullptr;
+#pragma endregion
+
 #pragma region SupportedTextureNames
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Supported Texture Names")
 	TArray<FString> BaseColorArray = {
@@ -81,6 +180,15 @@ public:
 	};
 #pragma endregion
 
+#if WITH_EDITOR
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+#pragma region ParentParameterSchema
+	/** Texture parameters of the parent and the role each expects, cached until the parent is saved */
+	const struct FMaterialParameterSchema& GetParameterSchema(UMaterialInterface* ParentMat);
+#pragma endregion
+
 private:
 #pragma region QuickMaterialCreation
 	bool ProcessSelectedData(const TArray<FAssetData>& SelectedDataToProccess, TArray<UTexture2D*>& OutSelectedTexturesArray, FString& OutSelectedTexturePackagePath);
@@ -95,11 +203,41 @@ private:
 	bool TryConnectRoughness(UMaterialExpressionTextureSample* TextureSampleNode, UTexture2D* SelectedTexture, UMaterial* CreatedMaterial);
 	bool TryConnectNormal(UMaterialExpressionTextureSample* TextureSampleNode, UTexture2D* SelectedTexture, UMaterial* CreatedMaterial);
 	bool TryConnectAO(UMaterialExpressionTextureSample* TextureSampleNode, UTexture2D* SelectedTexture, UMaterial* CreatedMaterial);
+	void EnsureLinearTextureSettings(UTexture2D* SelectedTexture);
 #pragma endregion
 
 	class UMaterialInstanceConstant* CreateMaterialInstanceAsset(UMaterial* CreatedMaterial, FString NameOfMaterialInstance, const FString& PathToPutMI);
 	UMaterialExpressionTextureSampleParameter2D* CreateTextureParameter(UMaterial* Material, FName ParameterName, UTexture2D* Texture);
 
-	bool CreateMaterialInstanceFromSelectedTextures(UMaterialInterface* ParentMat, const TArray<UTexture2D*>& SelectedTextures, const FString& TargetPath);
-	void TrySetTextureParameter(UMaterialInstanceConstant* MaterialInstance, const FName ParameterName, UTexture2D* Texture);
+	bool CreateMaterialInstanceFromSelectedTextures(UMaterialInterface* ParentMat, const TArray<UTexture2D*>& SelectedTextures, const FString& TargetPath, const FString& NameOfTheMaterial, UTexture2D* PackedOrmTexture = nullptr);
+	void BindTextureParameter(UMaterialInstanceConstant* MaterialInstance, const struct FTextureParameterSlot* ParameterSlot, UTexture2D* Texture);
+
+#pragma region BatchMaterialCreation
+	static E_TextureRole ClassifyTextureName(const FTextureRoleClassifier& Classifier, FStringView TextureName, FString& OutStem);
+	void GroupTexturesIntoSets(const TArray<FAssetData>& TexturesData, TArray<FTextureSet>& OutTextureSets);
+	bool CreateMaterialForTextureSet(const FTextureSet& TextureSet, const FString& NameOfTheMaterial);
+	UTexture2D* PackOrmTextureForSet(const FTextureSet& TextureSet);
+#pragma endregion
+
+#pragma region BulkParameterEditing
+	void GatherBulkEditTargets(TArray<FAssetData>& OutInstancesData) const;
+	bool ApplyBulkEdit(UMaterialInstanceConstant* MaterialInstance, FString& OutChangeDescription) const;
+#pragma endregion
+
+#pragma region TextureRoleClassification
+	FTextureRoleClassifier RoleClassifier;
+	bool bRoleClassifierDirty = true;
+	const FTextureRoleClassifier& GetRoleClassifier();
+	E_TextureRole ClassifyTexture(const FString& TextureName);
+#pragma endregion
+
+#pragma region DeferredMaterialCompile
+	void RequestMaterialCompile(UMaterial* MaterialToCompile);
+	void FlushDeferredMaterialCompiles();
+	bool bDeferringMaterialCompiles = false;
+	UPROPERTY()
+	TArray<UMaterial*> PendingCompileMaterials;
+	//Same materials as the array, so queueing stays constant time for large folders
+	TSet<UMaterial*> PendingCompileMaterialSet;
+#pragma endregion
 };
\ No newline at end of file
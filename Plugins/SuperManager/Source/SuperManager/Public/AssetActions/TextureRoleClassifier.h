@@ -0,0 +1,60 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** Result of classifying one texture name */
+struct FTextureRoleMatch
+{
+	/** Index of the role whose token matched, INDEX_NONE if nothing matched */
+	int32 RoleIndex = INDEX_NONE;
+	int32 MatchStart = INDEX_NONE;
+	int32 MatchLength = 0;
+	/** Tokens of more than one role matched the name, the winning one is the closest to the end */
+	bool bAmbiguous = false;
+	/** Bit per role that had a valid match */
+	uint32 MatchedRolesMask = 0;
+
+	bool IsValid() const { return RoleIndex != INDEX_NONE; }
+};
+
+/**
+ * Case insensitive Aho-Corasick automaton over the role suffix tokens, compiled once and matched in one pass per name.
+ * A token only counts when it is followed by the end of the name or a non-letter, so _AO does not match inside _AOMask.
+ * When several tokens match, the one ending closest to the end of the name wins, then the longest, then the lowest role index.
+ */
+class SUPERMANAGER_API FTextureRoleClassifier
+{
+public:
+	/** TokensPerRole[RoleIndex] holds the suffix tokens of that role */
+	void Compile(const TArray< TArray<FString> >& TokensPerRole);
+
+	bool IsCompiled() const { return Nodes.Num() > 0; }
+	uint32 GetSourceHash() const { return SourceHash; }
+	static uint32 HashTokens(const TArray< TArray<FString> >& TokensPerRole);
+
+	FTextureRoleMatch Classify(FStringView TextureName) const;
+
+	/** Texture name without the matched token and without the T_ prefix, used to group texture sets */
+	static FString MakeStem(FStringView TextureName, const FTextureRoleMatch& Match);
+
+private:
+	static constexpr int32 AlphabetSize = 128;
+
+	struct FToken
+	{
+		int32 RoleIndex = 0;
+		int32 Length = 0;
+	};
+	struct FNode
+	{
+		int32 Next[AlphabetSize];
+		int32 Fail = 0;
+		TArray<int32, TInlineAllocator<2>> OutputTokens;
+	};
+
+	TArray<FNode> Nodes;
+	TArray<FToken> Tokens;
+	uint32 SourceHash = 0;
+};
@@ -0,0 +1,43 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "AssetRegistry/AssetData.h"
+
+struct FTextureAuditFinding
+{
+	FAssetData AssetData;
+	int32 SizeX = 0;
+	int32 SizeY = 0;
+	int64 EstimatedGpuBytes = 0;
+	FString Message;
+
+	//Corrections the fixer applies, a finding without any of them is report only
+	bool bDisableSRGB = false;
+	bool bCompressTexture = false;
+	bool bPadToPowerOfTwo = false;
+
+	bool CanFix() const { return bDisableSRGB || bCompressTexture || bPadToPowerOfTwo; }
+	FString DescribeFix() const;
+};
+
+/**
+ * Audits texture settings from asset registry tags only, no texture is loaded.
+ * Checks relying on a tag the registry does not have for an asset are skipped for that asset.
+ */
+class SUPERMANAGER_API FTextureSettingsAuditor
+{
+public:
+	/** Uncompressed textures with a side at least this long are reported */
+	int32 LargeTextureSize = 4096;
+
+	void Run(const TArray<FString>& RootPaths, TArray<FTextureAuditFinding>& OutFindings, int64& OutTotalGpuBytes) const;
+
+	/** Apply every fixable finding, all touched packages are saved in one pass. Returns the number of fixed textures */
+	static int32 Fix(const TArray<FTextureAuditFinding>& Findings);
+
+private:
+	bool AuditTexture(const FAssetData& AssetData, FTextureAuditFinding& OutFinding) const;
+	static int32 GetBitsPerPixel(const FString& PixelFormat, const FString& CompressionSettings);
+};
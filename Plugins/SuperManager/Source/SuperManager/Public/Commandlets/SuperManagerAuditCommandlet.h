@@ -0,0 +1,37 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "SuperManagerAuditCommandlet.generated.h"
+
+/**
+ * Headless project audits, for example:
+ * UnrealEditor-Cmd.exe Project.uproject -run=SuperManagerAudit -Audit=Naming -Paths=/Game/A+/Game/B [-AutoFix]
+ * UnrealEditor-Cmd.exe Project.uproject -run=SuperManagerAudit -Audit=TextureSettings -Paths=/Game [-AutoFix]
+ * UnrealEditor-Cmd.exe Project.uproject -run=SuperManagerAudit -Audit=MaterialInstanceDuplicates -Paths=/Game
+ * UnrealEditor-Cmd.exe Project.uproject -run=SuperManagerAudit -Audit=MaterialGraphDuplicates -Paths=/Game [-BatchSize=64]
+ * UnrealEditor-Cmd.exe Project.uproject -run=SuperManagerAudit -Audit=MaterialUsage -Paths=/Game [-AutoFix]
+ * UnrealEditor-Cmd.exe Project.uproject -run=SuperManagerAudit -Audit=TextureRoleBenchmark [-Count=1000000]
+ * UnrealEditor-Cmd.exe Project.uproject -run=SuperManagerAudit -Audit=LevelCost -Map=/Game/Maps/Main [-GroupBy=Mesh] [-Output=Cost.csv]
+ * Returns 1 when the audit found problems.
+ */
+UCLASS()
+class SUPERMANAGER_API USuperManagerAuditCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	USuperManagerAuditCommandlet();
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	int32 RunNamingAudit(const TArray<FString>& RootPaths, bool bAutoFix);
+	int32 RunTextureSettingsAudit(const TArray<FString>& RootPaths, bool bAutoFix);
+	int32 RunMaterialInstanceDuplicatesAudit(const TArray<FString>& RootPaths);
+	int32 RunMaterialGraphDuplicatesAudit(const TArray<FString>& RootPaths, int32 BatchSize);
+	int32 RunMaterialUsageAudit(const TArray<FString>& RootPaths, bool bAutoFix);
+	int32 RunTextureRoleBenchmark(int32 NumNames);
+	int32 RunLevelCostExport(const FString& MapPath, const FString& GroupBy, const FString& OutputPath);
+};
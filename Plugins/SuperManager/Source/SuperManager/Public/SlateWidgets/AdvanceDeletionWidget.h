@@ -6,7 +6,7 @@ class SAdvanceDeletionTab : public SCompoundWidget
 {
 	SLATE_BEGIN_ARGS(SAdvanceDeletionTab) {}
 	SLATE_ARGUMENT(TArray< TSharedPtr <FAssetData> >, AssetsDataToStore)
-	SLATE_ARGUMENT(FString, CurrentSelectedFolder)
+	SLATE_ARGUMENT(TArray<FString>, SelectedRootFolders)
 	SLATE_END_ARGS()
 public:
 	void Construct(const FArguments& InArgs);
@@ -19,6 +19,10 @@ private:
 	TSharedPtr< SListView< TSharedPtr <FAssetData> > > ConstructedAssetListView;
 	void RefreshAssetListView();
 
+	TArray<FString> SelectedRootFolders;
+	TSharedPtr<STextBlock> RootBreakdownTextBlock;
+	FString ConstructRootBreakdownText() const;
+
 #pragma region ComboBoxForListingCondition
 	TSharedRef< SComboBox < TSharedPtr <FString> > > ConstructComboBox();
 	TArray< TSharedPtr <FString> > ComboBoxSourceItems;
@@ -0,0 +1,33 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+#include "Widgets/SCompoundWidget.h"
+#include "AssetRegistry/AssetData.h"
+
+/** One finding of a content audit, what is wrong with the asset and what the audit would do about it */
+struct FAssetAuditRow
+{
+	FAssetData AssetData;
+	FString Finding;
+	//Audit specific: the suggested name, the planned fix, the asset to merge into, permutation counts
+	FString Detail;
+	bool bCanFix = false;
+};
+
+class SAssetAuditReportTable : public SCompoundWidget
+{
+	SLATE_BEGIN_ARGS(SAssetAuditReportTable) : _DetailColumnTitle(TEXT("Detail")) {}
+	SLATE_ARGUMENT(TArray< TSharedPtr <FAssetAuditRow> >, AuditRows)
+	SLATE_ARGUMENT(FString, DetailColumnTitle)
+	SLATE_END_ARGS()
+public:
+	void Construct(const FArguments& InArgs);
+
+	static void OpenInWindow(const TArray< TSharedPtr <FAssetAuditRow> >& AuditRows, const FString& WindowTitle,
+		const FString& DetailColumnTitle = TEXT("Detail"));
+private:
+	TArray< TSharedPtr <FAssetAuditRow> > AuditRows;
+	TSharedRef<ITableRow> OnGenerateRowForList(TSharedPtr<FAssetAuditRow> RowToDisplay, const TSharedRef<STableViewBase>& OwnerTable);
+	TSharedRef<SHorizontalBox> ConstructColumns(const FString& AssetName, const FString& AssetPath, const FString& Finding,
+		const FString& Detail, const FString& FixStatus, const FSlateColor& FixStatusColor);
+};
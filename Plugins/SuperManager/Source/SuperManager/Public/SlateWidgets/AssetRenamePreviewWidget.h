@@ -0,0 +1,22 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+#include "Widgets/SCompoundWidget.h"
+#include "AssetActions/BatchAssetRenamer.h"
+
+class SAssetRenamePreviewTable : public SCompoundWidget
+{
+	SLATE_BEGIN_ARGS(SAssetRenamePreviewTable) : _SecondColumnTitle(TEXT("New Name")) {}
+	SLATE_ARGUMENT(TArray< TSharedPtr <FAssetRenamePreviewRow> >, PreviewRows)
+	SLATE_ARGUMENT(FString, SecondColumnTitle)
+	SLATE_END_ARGS()
+public:
+	void Construct(const FArguments& InArgs);
+
+	static void OpenInWindow(const TArray< TSharedPtr <FAssetRenamePreviewRow> >& PreviewRows, const FString& WindowTitle,
+		const FString& SecondColumnTitle = TEXT("New Name"));
+private:
+	TArray< TSharedPtr <FAssetRenamePreviewRow> > PreviewRows;
+	TSharedRef<ITableRow> OnGenerateRowForList(TSharedPtr<FAssetRenamePreviewRow> RowToDisplay, const TSharedRef<STableViewBase>& OwnerTable);
+	TSharedRef<SHorizontalBox> ConstructColumns(const FString& OldName, const FString& NewName, const FString& Status, const FSlateColor& StatusColor);
+};
@@ -0,0 +1,43 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+#include "Widgets/SCompoundWidget.h"
+#include "Widgets/Views/SHeaderRow.h"
+#include "ActorActions/LevelCostProfiler.h"
+
+class SLevelCostProfilerTab : public SCompoundWidget
+{
+	SLATE_BEGIN_ARGS(SLevelCostProfilerTab) {}
+	SLATE_END_ARGS()
+public:
+	void Construct(const FArguments& InArgs);
+
+	static int64 GetColumnValue(const FLevelCostRow& Row, const FName& ColumnId);
+private:
+	FLevelCostProfiler Profiler;
+	E_LevelCostGrouping Grouping = E_LevelCostGrouping::ELCG_Class;
+	TArray< TSharedPtr <FLevelCostRow> > DisplayedRows;
+	TSharedPtr< SListView< TSharedPtr <FLevelCostRow> > > ConstructedRowListView;
+	TSharedPtr<STextBlock> SummaryTextBlock;
+
+	void GatherLevelStats();
+	void RefreshRows();
+	void SortRows();
+
+#pragma region SortableColumns
+	FName SortColumnId = FName("Lod0Triangles");
+	EColumnSortMode::Type SortMode = EColumnSortMode::Descending;
+	TSharedRef<SHeaderRow> ConstructHeaderRow();
+	EColumnSortMode::Type GetColumnSortMode(FName ColumnId) const;
+	void OnColumnSortModeChanged(const EColumnSortPriority::Type SortPriority, const FName& ColumnId, const EColumnSortMode::Type NewSortMode);
+#pragma endregion
+
+	TSharedRef<ITableRow> OnGenerateRowForList(TSharedPtr<FLevelCostRow> RowToDisplay, const TSharedRef<STableViewBase>& OwnerTable);
+
+#pragma region TabButtons
+	TSharedRef<SButton> ConstructTabButton(const FString& TextContent, FOnClicked OnClicked);
+	FReply OnRefreshButtonClicked();
+	FReply OnGroupingButtonClicked(E_LevelCostGrouping NewGrouping);
+	FReply OnExportButtonClicked();
+#pragma endregion
+};
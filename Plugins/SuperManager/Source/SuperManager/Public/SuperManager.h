@@ -5,6 +5,13 @@
 #include "CoreMinimal.h"
 #include "Modules/ModuleManager.h"
 
+/** Assets gathered under one selected root folder, used to show a per-root breakdown */
+struct FSelectedRootAssets
+{
+	FString RootPath;
+	TArray< TSharedPtr <FAssetData> > AssetsData;
+};
+
 class FSuperManagerModule : public IModuleInterface
 {
 public:
@@ -23,6 +30,12 @@ private:
 	void OnDeleteUnusedAssetClicked();
 	void OnDeleteEmptyFoldersButtonClicked();
 	void OnAdvanceDeletionButtonClicked();
+	void OnAdvanceDeletionForProjectButtonClicked();
+	void OnLintNamingConventionsButtonClicked();
+	void OnAuditTextureSettingsButtonClicked();
+	void OnFindDuplicateMaterialInstancesButtonClicked();
+	void OnFindDuplicateMaterialGraphsButtonClicked();
+	void OnAuditMaterialUsageButtonClicked();
 
 	void FixUpRedirectors();
 #pragma endregion
@@ -33,9 +46,15 @@ private:
 	TSharedPtr<SDockTab> ConstructedDockTab;
 
 	TArray< TSharedPtr <FAssetData> > GetAllAssetDataUnderSelectedFolder();
+	TArray<FString> GetNormalizedSelectedRoots() const;
+	void ScanRootsInParallel(const TArray<FString>& RootPaths, bool bOnlyUnused, TArray<FSelectedRootAssets>& OutRootsAssets);
+	TArray<FSelectedRootAssets> SelectedRootsAssets;
 
 	void OnAdvanceDeletionTabClosed(TSharedRef<SDockTab> TabToClose);
 
+	void RegisterLevelCostProfilerTab();
+	TSharedRef<SDockTab> OnSpawnLevelCostProfilerTab(const FSpawnTabArgs& SpawnTabArgs);
+
 #pragma endregion
 
 #pragma region LevelEditorMenuExtension
@@ -46,6 +65,7 @@ private:
 
 	void OnLockActorSelectionButtonClicked();
 	void OnUnlockActorSelectionButtonClicked();
+	void OnProfileLevelCostButtonClicked();
 #pragma endregion
 
 #pragma region SelectionLock
@@ -77,6 +97,8 @@ public:
 	void ListSameNameAssetsForAssetList(const TArray< TSharedPtr <FAssetData> >& AssetsDataToFilter, TArray< TSharedPtr <FAssetData> >& OutSameNameAssetsData);
 	void SyncCBToClickedAssetForAssetList(const FString& AssetPathToSync);
 	void RefreshSceneOutliner();
+	static bool IsPathExcludedFromScan(const FString& PathToCheck);
+	static bool HasPackageReferencers(const class IAssetRegistry& AssetRegistry, FName PackageName);
 
 #pragma endregion
 
@@ -38,6 +38,8 @@ public class SuperManager : ModuleRules
 				"Engine",
 				"Slate",
 				"SlateCore",
+				"DeveloperSettings",
+				"ImageCore",
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);
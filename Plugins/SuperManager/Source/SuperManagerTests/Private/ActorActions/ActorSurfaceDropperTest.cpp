@@ -0,0 +1,187 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Misc/AutomationTest.h"
+#include "ActorActions/ActorSurfaceDropper.h"
+#include "ActorActions/ScopedActorBatch.h"
+#include "SuperManagerTestUtils.h"
+#include "Engine/StaticMeshActor.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	//Floor cubes sit with their top face at Z 0, a unit cube dropped on them rests with its pivot at 50
+	constexpr double FloorTopZ = 0.0;
+	constexpr double RestingCubeZ = FloorTopZ + 50.0;
+
+	AStaticMeshActor* SpawnFloor(UWorld* World, double Width)
+	{
+		return SuperManagerTests::SpawnCube(World, FVector(0.0, 0.0, FloorTopZ - 50.0), FVector(Width / 100.0, Width / 100.0, 1.0));
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FActorSurfaceDropperIgnoresDroppedActorsTest, "SuperManager.ActorActions.DropToSurface.IgnoresDroppedActors",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FActorSurfaceDropperIgnoresDroppedActorsTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = SuperManagerTests::CreateTestWorld();
+	if (!TestNotNull(TEXT("Test world"), World)) return false;
+	SpawnFloor(World, 1000.0);
+	//Stacked in one column, the upper cube must not land where the lower one started
+	const TArray<AActor*> DroppedActors = {
+		SuperManagerTests::SpawnCube(World, FVector(0.0, 0.0, 500.0)),
+		SuperManagerTests::SpawnCube(World, FVector(0.0, 0.0, 650.0)) };
+
+	TArray<FTransform> DropTransforms;
+	TArray<bool> ActorLanded;
+	FActorSurfaceDropper().FindDropTransforms(World, DroppedActors, DropTransforms, ActorLanded);
+
+	for (int32 ActorIndex = 0; ActorIndex < DroppedActors.Num(); ++ActorIndex)
+	{
+		TestTrue(FString::Printf(TEXT("Cube %d landed"), ActorIndex), ActorLanded[ActorIndex]);
+		TestEqual(FString::Printf(TEXT("Cube %d rests on the floor"), ActorIndex),
+			DropTransforms[ActorIndex].GetLocation().Z, RestingCubeZ, 0.1);
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FActorSurfaceDropperStaysUnderCeilingTest, "SuperManager.ActorActions.DropToSurface.StaysUnderCeiling",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FActorSurfaceDropperStaysUnderCeilingTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = SuperManagerTests::CreateTestWorld();
+	if (!TestNotNull(TEXT("Test world"), World)) return false;
+	SpawnFloor(World, 1000.0);
+	//A slab a little above the cube, like a bridge or a canopy
+	SuperManagerTests::SpawnCube(World, FVector(0.0, 0.0, 700.0), FVector(5.0, 5.0, 1.0));
+	const TArray<AActor*> DroppedActors = { SuperManagerTests::SpawnCube(World, FVector(0.0, 0.0, 500.0)) };
+
+	TArray<FTransform> DropTransforms;
+	TArray<bool> ActorLanded;
+	for (const bool bSweepFootprint : { false, true })
+	{
+		FActorSurfaceDropper SurfaceDropper;
+		SurfaceDropper.bSweepFootprint = bSweepFootprint;
+		SurfaceDropper.FindDropTransforms(World, DroppedActors, DropTransforms, ActorLanded);
+		const TCHAR* TraceName = bSweepFootprint ? TEXT("sweep") : TEXT("line");
+		TestTrue(FString::Printf(TEXT("Cube landed with a %s"), TraceName), ActorLanded[0]);
+		TestEqual(FString::Printf(TEXT("Cube rests on the floor with a %s"), TraceName),
+			DropTransforms[0].GetLocation().Z, RestingCubeZ, 0.1);
+	}
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FActorSurfaceDropperRejectsStartPenetrationTest, "SuperManager.ActorActions.DropToSurface.RejectsStartPenetration",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FActorSurfaceDropperRejectsStartPenetrationTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = SuperManagerTests::CreateTestWorld();
+	if (!TestNotNull(TEXT("Test world"), World)) return false;
+	SpawnFloor(World, 1000.0);
+	//A pillar from the floor up to Z 500, the cube's bottom starts buried in it
+	SuperManagerTests::SpawnCube(World, FVector(0.0, 0.0, 250.0), FVector(2.0, 2.0, 5.0));
+	AActor* BuriedCube = SuperManagerTests::SpawnCube(World, FVector(0.0, 0.0, 480.0));
+	const FVector StartLocation = BuriedCube->GetActorLocation();
+
+	FActorSurfaceDropper SurfaceDropper;
+	SurfaceDropper.bSweepFootprint = true;
+	TArray<FTransform> DropTransforms;
+	TArray<bool> ActorLanded;
+	SurfaceDropper.FindDropTransforms(World, { BuriedCube }, DropTransforms, ActorLanded);
+
+	TestFalse(TEXT("Buried cube is not dropped"), ActorLanded[0]);
+	TestEqual(TEXT("Buried cube keeps its transform"), DropTransforms[0].GetLocation(), StartLocation);
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FActorSurfaceDropperAlignsToSlopeTest, "SuperManager.ActorActions.DropToSurface.AlignsToSlope",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FActorSurfaceDropperAlignsToSlopeTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = SuperManagerTests::CreateTestWorld();
+	if (!TestNotNull(TEXT("Test world"), World)) return false;
+	//A slab rolled 30 degrees, its top face crosses the pivot line at 50 / cos(30) - 50
+	constexpr double SlopeDegrees = 30.0;
+	AActor* Ramp = SpawnFloor(World, 1000.0);
+	Ramp->SetActorRotation(FRotator(0.0, 0.0, SlopeDegrees));
+	AActor* DroppedCube = SuperManagerTests::SpawnCube(World, FVector(0.0, 0.0, 500.0));
+
+	FActorSurfaceDropper SurfaceDropper;
+	SurfaceDropper.bAlignToNormal = true;
+	TArray<FTransform> DropTransforms;
+	TArray<bool> ActorLanded;
+	SurfaceDropper.FindDropTransforms(World, { DroppedCube }, DropTransforms, ActorLanded);
+	if (!TestTrue(TEXT("Cube landed"), ActorLanded[0])) return false;
+
+	//Tilted the same way, the bottom of its bounds is now 50 * (cos + sin) below the pivot, not 50
+	const double SlopeRadians = FMath::DegreesToRadians(SlopeDegrees);
+	const double SurfaceZ = 50.0 / FMath::Cos(SlopeRadians) - 50.0;
+	const double PivotHeight = 50.0 * (FMath::Cos(SlopeRadians) + FMath::Sin(SlopeRadians));
+	TestEqual(TEXT("Cube is tilted to the slope"),
+		DropTransforms[0].GetRotation().GetUpVector().Z, FMath::Cos(SlopeRadians), 0.001);
+	TestEqual(TEXT("Tilted bounds rest on the slope"), DropTransforms[0].GetLocation().Z, SurfaceZ + PivotHeight, 0.5);
+	return true;
+}
+
+//The request's target: 50k actors dropped in a couple of seconds, traces and the undoable move together
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FActorSurfaceDropperFiftyThousandActorsTest, "SuperManager.ActorActions.DropToSurface.FiftyThousandActors",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FActorSurfaceDropperFiftyThousandActorsTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumActors = 50000;
+	constexpr double ActorSpacing = 200.0;
+	constexpr double DropBudgetSeconds = 2.0;
+
+	UWorld* World = SuperManagerTests::CreateTestWorld();
+	if (!TestNotNull(TEXT("Test world"), World)) return false;
+	const int32 GridWidth = FMath::CeilToInt32(FMath::Sqrt(static_cast<double>(NumActors)));
+	const double GridSize = GridWidth * ActorSpacing;
+	SpawnFloor(World, GridSize + ActorSpacing);
+
+	FRandomStream HeightStream(NumActors);
+	TArray<AActor*> DroppedActors;
+	DroppedActors.Reserve(NumActors);
+	for (int32 ActorIndex = 0; ActorIndex < NumActors; ++ActorIndex)
+	{
+		const FVector Location(
+			(ActorIndex % GridWidth) * ActorSpacing - GridSize * 0.5,
+			(ActorIndex / GridWidth) * ActorSpacing - GridSize * 0.5,
+			HeightStream.FRandRange(200.0, 2000.0));
+		DroppedActors.Add(SuperManagerTests::SpawnCube(World, Location));
+	}
+	if (!TestFalse(TEXT("Every cube spawned"), DroppedActors.Contains(nullptr))) return false;
+
+	const double StartTime = FPlatformTime::Seconds();
+	TArray<FTransform> DropTransforms;
+	TArray<bool> ActorLanded;
+	FActorSurfaceDropper().FindDropTransforms(World, DroppedActors, DropTransforms, ActorLanded);
+	const double TraceSeconds = FPlatformTime::Seconds() - StartTime;
+	{
+		FScopedActorBatch ActorBatch(NSLOCTEXT("SuperManagerTests", "DropToSurface", "Drop Actors To Surface"));
+		for (int32 ActorIndex = 0; ActorIndex < NumActors; ++ActorIndex)
+		{
+			if (ActorLanded[ActorIndex]) ActorBatch.SetActorTransform(DroppedActors[ActorIndex], DropTransforms[ActorIndex]);
+		}
+	}
+	const double TotalSeconds = FPlatformTime::Seconds() - StartTime;
+	AddInfo(FString::Printf(TEXT("Dropped %d actors in %.3f seconds, traces took %.3f seconds"), NumActors, TotalSeconds, TraceSeconds));
+
+	int32 NumMisplaced = 0;
+	for (int32 ActorIndex = 0; ActorIndex < NumActors; ++ActorIndex)
+	{
+		if (!ActorLanded[ActorIndex] || !FMath::IsNearlyEqual(DroppedActors[ActorIndex]->GetActorLocation().Z, RestingCubeZ, 0.1))
+		{
+			NumMisplaced++;
+		}
+	}
+	TestEqual(TEXT("Cubes not resting on the floor"), NumMisplaced, 0);
+	TestTrue(FString::Printf(TEXT("Drop finished within %.1f seconds"), DropBudgetSeconds), TotalSeconds <= DropBudgetSeconds);
+	return true;
+}
+
+#endif
@@ -0,0 +1,131 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Misc/AutomationTest.h"
+#include "ActorActions/QuickActorActionsWidget.h"
+#include "SuperManagerTestUtils.h"
+#include "Engine/StaticMeshActor.h"
+#include "Algo/Reverse.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	//Puts every actor back where it was, randomizes the selection and reads the result
+	TArray<FTransform> RandomizeFrom(UQuickActorActionsWidget* QuickActorActions, const TArray<AActor*>& Actors,
+		const TArray<FTransform>& StartTransforms)
+	{
+		for (int32 ActorIndex = 0; ActorIndex < Actors.Num(); ++ActorIndex)
+		{
+			Actors[ActorIndex]->SetActorTransform(StartTransforms[ActorIndex]);
+		}
+		QuickActorActions->RandomizeActorTransform();
+		TArray<FTransform> ResultTransforms;
+		for (const AActor* Actor : Actors)
+		{
+			ResultTransforms.Add(Actor->GetActorTransform());
+		}
+		return ResultTransforms;
+	}
+
+	//Bit for bit, the same seed has to give exactly the same doubles
+	bool AreTransformsEqual(const TArray<FTransform>& TransformsA, const TArray<FTransform>& TransformsB)
+	{
+		if (TransformsA.Num() != TransformsB.Num()) return false;
+		for (int32 TransformIndex = 0; TransformIndex < TransformsA.Num(); ++TransformIndex)
+		{
+			const FTransform& TransformA = TransformsA[TransformIndex];
+			const FTransform& TransformB = TransformsB[TransformIndex];
+			const FVector LocationA = TransformA.GetLocation(), LocationB = TransformB.GetLocation();
+			const FQuat RotationA = TransformA.GetRotation(), RotationB = TransformB.GetRotation();
+			const FVector ScaleA = TransformA.GetScale3D(), ScaleB = TransformB.GetScale3D();
+			if (FMemory::Memcmp(&LocationA, &LocationB, sizeof(FVector)) != 0 ||
+				FMemory::Memcmp(&RotationA, &RotationB, sizeof(FQuat)) != 0 ||
+				FMemory::Memcmp(&ScaleA, &ScaleB, sizeof(FVector)) != 0)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void EnableEveryVariation(UQuickActorActionsWidget* QuickActorActions, int32 RandomSeed)
+	{
+		QuickActorActions->RandomActorRotation.bRandomizeRotYaw = true;
+		QuickActorActions->RandomActorRotation.bRandomizeRotPitch = true;
+		QuickActorActions->RandomActorRotation.bRandomizeRotRoll = true;
+		QuickActorActions->bRandomizeScale = true;
+		QuickActorActions->bRandomizeOffset = true;
+		QuickActorActions->RandomSeed = RandomSeed;
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRandomizeActorTransformReproducibleTest, "SuperManager.ActorActions.RandomizeActorTransform.Reproducible",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRandomizeActorTransformReproducibleTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = SuperManagerTests::CreateTestWorld();
+	if (!TestNotNull(TEXT("Test world"), World)) return false;
+
+	TArray<AActor*> Actors;
+	TArray<FTransform> StartTransforms;
+	for (int32 ActorIndex = 0; ActorIndex < 64; ++ActorIndex)
+	{
+		AActor* Actor = SuperManagerTests::SpawnCube(World, FVector(ActorIndex * 200.0, 0.0, 0.0));
+		if (!TestNotNull(TEXT("Cube"), Actor)) return false;
+		Actors.Add(Actor);
+		StartTransforms.Add(Actor->GetActorTransform());
+	}
+
+	UQuickActorActionsWidget* QuickActorActions = NewObject<UQuickActorActionsWidget>(GetTransientPackage());
+	EnableEveryVariation(QuickActorActions, 7);
+
+	SuperManagerTests::SelectActors(Actors);
+	const TArray<FTransform> FirstRun = RandomizeFrom(QuickActorActions, Actors, StartTransforms);
+	TestFalse(TEXT("Randomizing moved the actors"), AreTransformsEqual(FirstRun, StartTransforms));
+
+	//Neither the selection order nor the widget instance may change the result
+	TArray<AActor*> ReversedActors = Actors;
+	Algo::Reverse(ReversedActors);
+	SuperManagerTests::SelectActors(ReversedActors);
+	UQuickActorActionsWidget* FreshQuickActorActions = NewObject<UQuickActorActionsWidget>(GetTransientPackage());
+	EnableEveryVariation(FreshQuickActorActions, 7);
+	const TArray<FTransform> SecondRun = RandomizeFrom(FreshQuickActorActions, Actors, StartTransforms);
+	TestTrue(TEXT("Same seed gives the same transforms"), AreTransformsEqual(FirstRun, SecondRun));
+
+	FreshQuickActorActions->RandomSeed = 8;
+	const TArray<FTransform> OtherSeedRun = RandomizeFrom(FreshQuickActorActions, Actors, StartTransforms);
+	TestFalse(TEXT("Another seed gives other transforms"), AreTransformsEqual(FirstRun, OtherSeedRun));
+	return true;
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FRandomizeActorTransformThreadingTest, "SuperManager.ActorActions.RandomizeActorTransform.SerialMatchesParallel",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FRandomizeActorTransformThreadingTest::RunTest(const FString& Parameters)
+{
+	//Far more actors than one ParallelFor batch, so the work is split over several workers
+	constexpr int32 NumActors = 4096;
+	UWorld* World = SuperManagerTests::CreateTestWorld();
+	if (!TestNotNull(TEXT("Test world"), World)) return false;
+
+	TArray<AActor*> Actors;
+	Actors.Reserve(NumActors);
+	for (int32 ActorIndex = 0; ActorIndex < NumActors; ++ActorIndex)
+	{
+		Actors.Add(SuperManagerTests::SpawnCube(World, FVector((ActorIndex % 64) * 200.0, (ActorIndex / 64) * 200.0, 0.0)));
+	}
+	if (!TestFalse(TEXT("Every cube spawned"), Actors.Contains(nullptr))) return false;
+
+	UQuickActorActionsWidget* QuickActorActions = NewObject<UQuickActorActionsWidget>(GetTransientPackage());
+	EnableEveryVariation(QuickActorActions, 7);
+	TArray<FTransform> SerialTransforms;
+	QuickActorActions->MakeRandomTransforms(Actors, SerialTransforms, EParallelForFlags::ForceSingleThread);
+	TArray<FTransform> ParallelTransforms;
+	QuickActorActions->MakeRandomTransforms(Actors, ParallelTransforms);
+
+	TestTrue(TEXT("Serial and parallel runs give identical transforms"), AreTransformsEqual(SerialTransforms, ParallelTransforms));
+	return true;
+}
+
+#endif
@@ -0,0 +1,164 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Misc/AutomationTest.h"
+#include "ActorActions/ScopedActorBatch.h"
+#include "SuperManagerTestUtils.h"
+#include "Subsystems/EditorActorSubsystem.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/Selection.h"
+#include "Components/StaticMeshComponent.h"
+#include "Editor.h"
+#include "Editor/TransBuffer.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	constexpr int32 NumBenchmarkActors = 10000;
+
+	double MicrosecondsPerActor(double StartTime, int32 NumActors)
+	{
+		return (FPlatformTime::Seconds() - StartTime) * 1e6 / FMath::Max(NumActors, 1);
+	}
+}
+
+//What the scope promises: one undo step, one selection notification, and every moved actor drawn again afterwards
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FScopedActorBatchSingleUpdateTest, "SuperManager.ActorActions.ScopedActorBatch.SingleUpdate",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FScopedActorBatchSingleUpdateTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumActors = 100;
+	UWorld* World = SuperManagerTests::CreateTestWorld();
+	if (!TestNotNull(TEXT("Test world"), World) || !TestNotNull(TEXT("Transaction buffer"), GEditor ? GEditor->Trans : nullptr)) return false;
+
+	TArray<AStaticMeshActor*> Actors;
+	for (int32 ActorIndex = 0; ActorIndex < NumActors; ++ActorIndex)
+	{
+		Actors.Add(SuperManagerTests::SpawnCube(World, FVector(ActorIndex * 200.0, 0.0, 0.0)));
+	}
+	if (!TestFalse(TEXT("Every cube spawned"), Actors.Contains(nullptr))) return false;
+	SuperManagerTests::SelectActors({});
+
+	//Nested transactions do not start another one, so this counts undo steps the scope opens
+	int32 NumTransactionsStarted = 0;
+	const FDelegateHandle TransactionHandle = GEditor->Trans->OnTransactionStateChanged().AddLambda(
+		[&NumTransactionsStarted](const FTransactionContext&, ETransactionStateEventType EventType)
+		{
+			if (EventType == ETransactionStateEventType::TransactionStarted) NumTransactionsStarted++;
+		});
+	USelection* ActorSelection = GEditor->GetSelectedActors();
+	int32 NumSelectionChanges = 0;
+	const FDelegateHandle SelectionHandle = USelection::SelectionChangedEvent.AddLambda(
+		[&NumSelectionChanges, ActorSelection](UObject* ChangedSelection)
+		{
+			if (ChangedSelection == ActorSelection) NumSelectionChanges++;
+		});
+
+	bool bRenderStateSuspended = true;
+	{
+		FScopedActorBatch ActorBatch(NSLOCTEXT("SuperManagerTests", "MoveActors", "Move Actors"));
+		for (AStaticMeshActor* Actor : Actors)
+		{
+			ActorBatch.SetActorTransform(Actor, FTransform(Actor->GetActorLocation() + FVector(0.0, 0.0, 100.0)));
+			ActorBatch.SelectActor(Actor);
+			bRenderStateSuspended &= !Actor->GetStaticMeshComponent()->IsRenderStateCreated();
+		}
+	}
+
+	GEditor->Trans->OnTransactionStateChanged().Remove(TransactionHandle);
+	USelection::SelectionChangedEvent.Remove(SelectionHandle);
+
+	TestEqual(TEXT("One transaction for the whole batch"), NumTransactionsStarted, 1);
+	TestEqual(TEXT("One selection change notification"), NumSelectionChanges, 1);
+	TestEqual(TEXT("Every actor selected"), ActorSelection->CountSelections<AActor>(), NumActors);
+	TestTrue(TEXT("Render state is held back inside the scope"), bRenderStateSuspended);
+	TestFalse(TEXT("Render state is recreated when the scope closes"), Actors.ContainsByPredicate([](const AStaticMeshActor* Actor)
+		{
+			return !Actor->GetStaticMeshComponent()->IsRenderStateCreated();
+		}));
+	TestTrue(TEXT("Actors moved"), Actors[0]->GetActorLocation().Equals(FVector(0.0, 0.0, 100.0)));
+	return true;
+}
+
+//Before and after of the batched scope on 10k actors, each action done the old per-actor way and through FScopedActorBatch.
+//Timings are only reported, wall clock depends on the machine, what the scope guarantees is checked by SingleUpdate
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FScopedActorBatchTenThousandActorsTest, "SuperManager.ActorActions.ScopedActorBatch.TenThousandActors",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::PerfFilter)
+
+bool FScopedActorBatchTenThousandActorsTest::RunTest(const FString& Parameters)
+{
+	UWorld* World = SuperManagerTests::CreateTestWorld();
+	UEditorActorSubsystem* EditorActorSubsystem = GEditor ? GEditor->GetEditorSubsystem<UEditorActorSubsystem>() : nullptr;
+	if (!TestNotNull(TEXT("Test world"), World) || !TestNotNull(TEXT("Editor actor subsystem"), EditorActorSubsystem)) return false;
+
+	const int32 GridWidth = FMath::CeilToInt32(FMath::Sqrt(static_cast<double>(NumBenchmarkActors)));
+	TArray<AActor*> Actors;
+	Actors.Reserve(NumBenchmarkActors);
+	for (int32 ActorIndex = 0; ActorIndex < NumBenchmarkActors; ++ActorIndex)
+	{
+		Actors.Add(SuperManagerTests::SpawnCube(World, FVector((ActorIndex % GridWidth) * 200.0, (ActorIndex / GridWidth) * 200.0, 0.0)));
+	}
+	if (!TestFalse(TEXT("Every cube spawned"), Actors.Contains(nullptr))) return false;
+	const FVector MoveOffset(0.0, 0.0, 100.0);
+
+	//Move and select, one offset and one selection change per actor as the actions did before
+	SuperManagerTests::SelectActors({});
+	double StartTime = FPlatformTime::Seconds();
+	for (AActor* Actor : Actors)
+	{
+		Actor->AddActorWorldOffset(MoveOffset);
+		EditorActorSubsystem->SetActorSelectionState(Actor, true);
+	}
+	const double MoveBeforeUs = MicrosecondsPerActor(StartTime, Actors.Num());
+
+	SuperManagerTests::SelectActors({});
+	StartTime = FPlatformTime::Seconds();
+	{
+		FScopedActorBatch ActorBatch(NSLOCTEXT("SuperManagerTests", "MoveActors", "Move Actors"));
+		for (AActor* Actor : Actors)
+		{
+			ActorBatch.SetActorTransform(Actor, FTransform(Actor->GetActorLocation() - MoveOffset));
+			ActorBatch.SelectActor(Actor);
+		}
+	}
+	const double MoveAfterUs = MicrosecondsPerActor(StartTime, Actors.Num());
+
+	//Duplicate, one subsystem call per actor before, one call for the whole selection after
+	StartTime = FPlatformTime::Seconds();
+	int32 NumDuplicatedBefore = 0;
+	for (AActor* Actor : Actors)
+	{
+		if (AActor* DuplicatedActor = EditorActorSubsystem->DuplicateActor(Actor, World))
+		{
+			DuplicatedActor->AddActorWorldOffset(MoveOffset);
+			EditorActorSubsystem->SetActorSelectionState(DuplicatedActor, true);
+			NumDuplicatedBefore++;
+		}
+	}
+	const double DuplicateBeforeUs = MicrosecondsPerActor(StartTime, Actors.Num());
+
+	StartTime = FPlatformTime::Seconds();
+	int32 NumDuplicatedAfter = 0;
+	{
+		FScopedActorBatch ActorBatch(NSLOCTEXT("SuperManagerTests", "DuplicateActors", "Duplicate Actors"));
+		for (AActor* DuplicatedActor : EditorActorSubsystem->DuplicateActors(Actors, World, MoveOffset * 2.0))
+		{
+			ActorBatch.AddSpawnedActor(DuplicatedActor);
+			NumDuplicatedAfter++;
+		}
+	}
+	const double DuplicateAfterUs = MicrosecondsPerActor(StartTime, Actors.Num());
+
+	AddInfo(FString::Printf(TEXT("Move and select: %.2f us per actor before, %.2f us after"), MoveBeforeUs, MoveAfterUs));
+	AddInfo(FString::Printf(TEXT("Duplicate: %.2f us per actor before, %.2f us after"), DuplicateBeforeUs, DuplicateAfterUs));
+
+	TestEqual(TEXT("Every actor duplicated per actor"), NumDuplicatedBefore, NumBenchmarkActors);
+	TestEqual(TEXT("Every actor duplicated in one call"), NumDuplicatedAfter, NumBenchmarkActors);
+	TestTrue(TEXT("Batched moves are back where they started"),
+		Actors[NumBenchmarkActors - 1]->GetActorLocation().Equals(FVector(((NumBenchmarkActors - 1) % GridWidth) * 200.0,
+			((NumBenchmarkActors - 1) / GridWidth) * 200.0, 0.0)));
+	return true;
+}
+
+#endif
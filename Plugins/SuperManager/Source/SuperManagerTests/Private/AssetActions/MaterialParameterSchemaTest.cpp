@@ -0,0 +1,52 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "Misc/AutomationTest.h"
+#include "AssetActions/QuickMaterialCreationWidget.h"
+#include "AssetActions/MaterialParameterSchema.h"
+#include "Materials/Material.h"
+#include "Materials/MaterialExpressionTextureSampleParameter2D.h"
+#include "Engine/Texture2D.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+namespace
+{
+	void AddTextureParameter(UMaterial* Material, FName ParameterName, EMaterialSamplerType SamplerType, UTexture* DefaultTexture)
+	{
+		UMaterialExpressionTextureSampleParameter2D* ParameterNode =
+			NewObject<UMaterialExpressionTextureSampleParameter2D>(Material);
+		ParameterNode->ParameterName = ParameterName;
+		ParameterNode->SamplerType = SamplerType;
+		ParameterNode->Texture = DefaultTexture;
+		Material->GetExpressionCollection().AddExpression(ParameterNode);
+	}
+}
+
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FMaterialParameterSchemaNormalAndOrmTest, "SuperManager.AssetActions.MaterialParameterSchema.NormalAndOrm",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ProductFilter)
+
+bool FMaterialParameterSchemaNormalAndOrmTest::RunTest(const FString& Parameters)
+{
+	UTexture2D* DefaultTexture = LoadObject<UTexture2D>(nullptr, TEXT("/Engine/EngineResources/DefaultTexture.DefaultTexture"));
+	if (!TestNotNull(TEXT("Default texture"), DefaultTexture)) return false;
+
+	//Normal sorts before VT_ORM and holds "orm" when case is ignored
+	UMaterial* ParentMaterial = NewObject<UMaterial>(GetTransientPackage(), NAME_None, RF_Transient);
+	AddTextureParameter(ParentMaterial, TEXT("Normal"), SAMPLERTYPE_Color, DefaultTexture);
+	AddTextureParameter(ParentMaterial, TEXT("VT_ORM"), SAMPLERTYPE_LinearColor, DefaultTexture);
+	ParentMaterial->UpdateCachedExpressionData();
+
+	UQuickMaterialCreationWidget* QuickMaterialCreation = NewObject<UQuickMaterialCreationWidget>(GetTransientPackage());
+	const FMaterialParameterSchema& ParameterSchema = QuickMaterialCreation->GetParameterSchema(ParentMaterial);
+
+	TestEqual(TEXT("Packed ORM parameter"), ParameterSchema.PackedOrmParameterName, FName(TEXT("VT_ORM")));
+	const FTextureParameterSlot* NormalSlot = ParameterSchema.FindSlotForRole(E_TextureRole::ETR_Normal);
+	if (TestNotNull(TEXT("Normal slot"), NormalSlot))
+	{
+		TestEqual(TEXT("Normal parameter"), NormalSlot->ParameterName, FName(TEXT("Normal")));
+		TestFalse(TEXT("Normal does not expect a packed ORM texture"), NormalSlot->bExpectsPackedOrm);
+	}
+	return true;
+}
+
+#endif
@@ -0,0 +1,43 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "SuperManagerTestUtils.h"
+#include "Tests/AutomationEditorCommon.h"
+#include "Engine/StaticMeshActor.h"
+#include "Engine/StaticMesh.h"
+#include "Engine/World.h"
+#include "Components/StaticMeshComponent.h"
+#include "Engine/Selection.h"
+#include "Editor.h"
+
+UWorld* SuperManagerTests::CreateTestWorld()
+{
+	return FAutomationEditorCommonUtils::CreateNewMap();
+}
+
+AStaticMeshActor* SuperManagerTests::SpawnCube(UWorld* World, const FVector& Location, const FVector& Scale)
+{
+	static UStaticMesh* CubeMesh = LoadObject<UStaticMesh>(nullptr, TEXT("/Engine/BasicShapes/Cube.Cube"));
+	if (!World || !CubeMesh) return nullptr;
+
+	AStaticMeshActor* CubeActor = World->SpawnActor<AStaticMeshActor>(Location, FRotator::ZeroRotator);
+	if (!CubeActor) return nullptr;
+	//Static components refuse a new mesh once registered
+	UStaticMeshComponent* MeshComponent = CubeActor->GetStaticMeshComponent();
+	MeshComponent->SetMobility(EComponentMobility::Movable);
+	MeshComponent->SetStaticMesh(CubeMesh);
+	CubeActor->SetActorScale3D(Scale);
+	return CubeActor;
+}
+
+void SuperManagerTests::SelectActors(const TArray<AActor*>& Actors)
+{
+	USelection* ActorSelection = GEditor->GetSelectedActors();
+	ActorSelection->BeginBatchSelectOperation();
+	GEditor->SelectNone(false, true, false);
+	for (AActor* Actor : Actors)
+	{
+		GEditor->SelectActor(Actor, true, false, true);
+	}
+	ActorSelection->EndBatchSelectOperation(false);
+	GEditor->NoteSelectionChange();
+}
@@ -0,0 +1,19 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class AStaticMeshActor;
+
+namespace SuperManagerTests
+{
+	/** Opens a fresh empty map in the editor, so tests never touch the level the user has open */
+	UWorld* CreateTestWorld();
+
+	/** Movable engine cube, 100 units wide at scale 1 with its pivot in the middle */
+	AStaticMeshActor* SpawnCube(UWorld* World, const FVector& Location, const FVector& Scale = FVector::OneVector);
+
+	/** Replaces the editor selection with the actors, selected in the given order */
+	void SelectActors(const TArray<AActor*>& Actors);
+}